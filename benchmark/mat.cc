@@ -0,0 +1,136 @@
+#include "lalib/mat/dyn_mat.hpp"
+#include "lalib/ops/mat_mat_ops.hpp"
+#include "lalib/ops/mat_vec_ops.hpp"
+#include "lalib/ops/isa.hpp"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+#include <complex>
+#include <string>
+#include <utility>
+
+template<typename T>
+auto generate_rand_dyn_mat(size_t n, size_t m, std::mt19937& rand) -> lalib::DynMat<T> {
+    auto dist = std::uniform_real_distribution<double>(-1.0, 1.0);
+    auto mat = lalib::DynMat<T>::uninit(n, m);
+    for (auto i = 0u; i < n * m; ++i) {
+        if constexpr (std::is_floating_point_v<T>) {
+            mat.data()[i] = static_cast<T>(dist(rand));
+        } else {
+            mat.data()[i] = T(dist(rand), dist(rand));
+        }
+    }
+    return mat;
+}
+
+template<typename F>
+auto measure_consumption_time(int64_t min_time, F func) -> double {
+    auto start = std::chrono::system_clock::now();
+    auto iter = 0;
+    int64_t elapsed = 0;
+    for (iter = 0; elapsed < min_time; ++iter) {
+        func();
+        
+        auto end = std::chrono::system_clock::now();
+        elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    }
+    return elapsed / static_cast<double>(iter);
+}
+
+/// Measures `C <- A * B` of `n` x `n` matrices, and prints the GFLOP/s of the internal blocked kernel for each instruction set, 
+/// the row-wise kernel used for small matrices and the backend. The instruction sets the CPU lacks are printed as 0.
+template<typename T>
+void gemm_bench(const std::string& name) {
+    // A complex multiply-add is 8 flops
+    constexpr auto flops_per_madd = std::is_floating_point_v<T> ? 2.0 : 8.0;
+    const auto isas = { lalib::Isa::Baseline, lalib::Isa::Avx2, lalib::Isa::Avx512 };
+    auto active = lalib::active_isa();
+
+    std::cout << std::endl;
+    std::cout << " # " << name << std::endl;
+    std::cout << "     n | SSE2 [GFLOP/s] | AVX2 [GFLOP/s] | AVX-512 [GFLOP/s] | Row-wise [GFLOP/s] | Backend [GFLOP/s]" << std::endl;
+    std::cout << " ------|----------------|----------------|-------------------|--------------------|------------------" << std::endl;
+
+    auto rand = std::mt19937(42);
+    for (auto n: { 64u, 128u, 256u, 512u, 1024u }) {
+        auto a = generate_rand_dyn_mat<T>(n, n, rand);
+        auto b = generate_rand_dyn_mat<T>(n, n, rand);
+        auto c = lalib::DynMat<T>::filled(T{}, n, n);
+        auto gflops = [&](double ms) { return ms > 0.0 ? flops_per_madd * n * n * n / (ms * 1e6) : 0.0; };
+
+        std::cout << "  " << std::setw(5) << n;
+        for (auto isa: isas) {
+            auto blocked = 0.0;
+            if (isa <= lalib::detected_isa()) {
+                lalib::set_isa(isa);
+                blocked = measure_consumption_time(200, [&]() {
+                    lalib::__mul_core_dispatch(n, n, n, T(1), a.data(), b.data(), T(0), c.data());
+                });
+            }
+            std::cout << "| " << std::setw(isa == lalib::Isa::Avx512 ? 18 : 15) << gflops(blocked);
+        }
+        lalib::set_isa(active);
+
+        auto rowwise = n > 512 ? 0.0 : measure_consumption_time(200, [&]() {
+            lalib::__mul_core_simd(n, n, n, T(1), a.data(), b.data(), T(0), c.data());
+        });
+        auto backend = measure_consumption_time(200, [&]() {
+            lalib::mul(T(1), a, b, T(0), c);
+        });
+
+        std::cout << "| " << std::setw(19) << gflops(rowwise) << "| " << gflops(backend) << std::endl;
+    }
+}
+
+/// Measures `y <- A * x` and `y <- A^T * x` of `n` x `m` matrices, and prints the bandwidth of reading the matrix.
+template<typename T>
+void gemv_bench(const std::string& name) {
+    std::cout << std::endl;
+    std::cout << " # " << name << std::endl;
+    std::cout << "           n x m | A * x [GB/s] | A^T * x [GB/s]" << std::endl;
+    std::cout << " ----------------|--------------|---------------" << std::endl;
+
+    auto rand = std::mt19937(42);
+    for (auto [n, m]: { std::pair<size_t, size_t>{ 512, 512 }, { 4096, 4096 }, { 200000, 32 }, { 32, 200000 } }) {
+        auto a = generate_rand_dyn_mat<T>(n, m, rand);
+        auto x = lalib::DynVec<T>::filled(m, T(1));
+        auto xt = lalib::DynVec<T>::filled(n, T(1));
+        auto y = lalib::DynVec<T>::filled(n, T{});
+        auto yt = lalib::DynVec<T>::filled(m, T{});
+        auto gbps = [&](double ms) { return sizeof(T) * n * m / (ms * 1e6); };
+
+        auto forward = measure_consumption_time(200, [&]() {
+            lalib::mul(T(1), a, x, T(0), y);
+        });
+        auto trans = measure_consumption_time(200, [&]() {
+            lalib::mul_trans(T(1), a, xt, T(0), yt);
+        });
+
+        std::cout << "  " << std::setw(6) << n << " x " << std::setw(6) << m << "| "
+            << std::setw(13) << gbps(forward) << "| " << gbps(trans) << std::endl;
+    }
+}
+
+int main() {
+    auto backend = 
+    #ifdef LALIB_BLAS_BACKEND
+        "BLAS";
+    #else
+        "Internal";
+    #endif
+
+    std::cout << "Benchmarks for dense matrix-matrix multiplication." << std::endl;
+    std::cout << std::setw(20) << std::left << " Backend" << ": " << backend << std::endl;
+    std::cout << std::setw(20) << std::left << " Detected ISA" << ": " << static_cast<int>(lalib::detected_isa()) << " (0: SSE2, 1: AVX2, 2: AVX-512)" << std::endl;
+    std::cout << std::right << std::fixed << std::setprecision(2);
+
+    gemm_bench<float>("float");
+    gemm_bench<double>("double");
+    gemm_bench<std::complex<float>>("complex<float>");
+    gemm_bench<std::complex<double>>("complex<double>");
+
+    std::cout << std::endl << "Benchmarks for dense matrix-vector multiplication." << std::endl;
+    gemv_bench<float>("float");
+    gemv_bench<double>("double");
+}
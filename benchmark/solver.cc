@@ -0,0 +1,102 @@
+#include "lalib/mat/sp_mat.hpp"
+#include "lalib/vec/dyn_vec.hpp"
+#include "lalib/ops/mat_vec_ops.hpp"
+#include "lalib/solver/gmres.hpp"
+#include "lalib/solver/bicgstab.hpp"
+#include "lalib/solver/idrs.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <string>
+
+template<typename F>
+auto measure_consumption_time(int64_t min_time, F func) -> double {
+    auto start = std::chrono::system_clock::now();
+    auto iter = 0;
+    int64_t elapsed = 0;
+    for (iter = 0; elapsed < min_time; ++iter) {
+        func();
+        
+        auto end = std::chrono::system_clock::now();
+        elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    }
+    return elapsed / static_cast<double>(iter);
+}
+
+/// Generates an upwind discretization of a 2D convection-diffusion operator on an `m` x `m` grid (non-symmetric)
+auto generate_convection_diffusion(size_t m, double c) -> lalib::SpMat<double> {
+    auto n = m * m;
+    auto val = std::vector<double>();
+    auto row_ptr = std::vector<size_t>{ 0 };
+    auto col_ids = std::vector<size_t>();
+    for (auto i = 0u; i < n; ++i) {
+        auto [r, col] = std::make_pair(i / m, i % m);
+        if (r > 0) { val.emplace_back(-1.0); col_ids.emplace_back(i - m); }
+        if (col > 0) { val.emplace_back(-1.0 - c); col_ids.emplace_back(i - 1); }
+        val.emplace_back(4.0 + c); col_ids.emplace_back(i);
+        if (col + 1 < m) { val.emplace_back(-1.0); col_ids.emplace_back(i + 1); }
+        if (r + 1 < m) { val.emplace_back(-1.0); col_ids.emplace_back(i + m); }
+        row_ptr.emplace_back(col_ids.size());
+    }
+    return lalib::SpMat<double>(std::move(val), std::move(row_ptr), std::move(col_ids));
+}
+
+template<typename S>
+void report(const std::string& name, const S& solver, const lalib::DynVec<double>& b) {
+    auto x = lalib::DynVec<double>::uninit(b.size());
+    auto status = lalib::solver::SolverStatus<double>{};
+    double elapsed = measure_consumption_time(200, [&](){
+        std::fill(x.begin(), x.end(), 0.0);
+        status = solver.solve(b, x);
+    });
+    std::cout << "  " << std::setw(14) << name << "| " << std::setw(6) << status.iterations 
+        << "| " << std::scientific << std::setprecision(2) << std::setw(9) << status.residual 
+        << (status.converged ? "  " : "* ") << std::defaultfloat << std::setprecision(6)
+        << "| " << elapsed << " ms" << std::endl;
+}
+
+template<typename P>
+void solver_bench(const std::string& title, size_t max_iter) {
+    using Mat = lalib::SpMat<double>;
+
+    std::cout << std::endl;
+    std::cout << " # " << title << " (2D convection-diffusion, tol = 1e-8)" << std::endl;
+    std::cout << std::endl;
+
+    for (auto m: { 64u, 128u, 256u }) {
+        auto mat = generate_convection_diffusion(m, 0.5);
+        auto n = mat.shape().first;
+        auto b = mat * lalib::DynVec<double>::filled(n, 1.0);
+        auto precond = lalib::solver::internal::_make_preconditioner<P>(mat);
+
+        std::cout << " n = " << n << std::endl;
+        std::cout << "  Solver        | Iter  | Residual   | Elapsed " << std::endl;
+        std::cout << "  --------------|-------|------------|--------------" << std::endl;
+        report("GMRES(30)", lalib::solver::Gmres<double, Mat, P>(mat, precond, 1e-8, 30, max_iter), b);
+        report("GMRES(30) CGS2", lalib::solver::Gmres<double, Mat, P>(mat, precond, 1e-8, 30, max_iter, 
+            lalib::solver::PrecondSide::Left, lalib::solver::Orthogonalization::Cgs2), b);
+        report("BiCGSTAB", lalib::solver::Bicgstab<double, Mat, P>(mat, precond, 1e-8, max_iter), b);
+        report("IDR(4)", lalib::solver::Idrs<double, Mat, P>(mat, precond, 1e-8, 4, max_iter), b);
+        report("IDR(8)", lalib::solver::Idrs<double, Mat, P>(mat, precond, 1e-8, 8, max_iter), b);
+        std::cout << std::endl;
+    }
+}
+
+int main() {
+    auto backend = 
+    #ifdef LALIB_BLAS_BACKEND
+        "BLAS";
+    #else
+        "Internal";
+    #endif
+
+    std::cout << "Benchmarks for iterative solvers." << std::endl;
+    std::cout << std::setw(20) << std::left << " Backend" << ": " << backend << std::endl;
+    std::cout << " (Iterations count the applications of the operator, except BiCGSTAB which applies it twice per iteration."
+        << " * marks a solve not converged.)" << std::endl;
+
+    std::cout << std::right;
+    solver_bench<lalib::solver::IdentityPreconditioner<double>>("No preconditioning", 5000);
+    solver_bench<lalib::solver::Ilu<double, lalib::SpMat<double>>>("ILU(0) preconditioning", 5000);
+}
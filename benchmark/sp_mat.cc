@@ -0,0 +1,102 @@
+#include "lalib/mat/sp_mat.hpp"
+#include "lalib/vec/dyn_vec.hpp"
+#include "lalib/ops/mat_vec_ops.hpp"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+template<typename F>
+auto measure_consumption_time(int64_t min_time, F func) -> double {
+    auto start = std::chrono::system_clock::now();
+    auto iter = 0;
+    int64_t elapsed = 0;
+    for (iter = 0; elapsed < min_time; ++iter) {
+        func();
+        
+        auto end = std::chrono::system_clock::now();
+        elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    }
+    return elapsed / static_cast<double>(iter);
+}
+
+/// Generates a tri-diagonal matrix of size `n` in COO format
+auto generate_tridiag_coo(size_t n) -> lalib::SpCooMat<double> {
+    auto val = std::vector<double>();
+    auto row_ids = std::vector<size_t>();
+    auto col_ids = std::vector<size_t>();
+    for (auto i = 0u; i < n; ++i) {
+        for (auto j = (i == 0 ? 0 : i - 1); j < std::min(n, static_cast<size_t>(i + 2)); ++j) {
+            val.emplace_back(i == j ? 2.0 : -1.0);
+            row_ids.emplace_back(i);
+            col_ids.emplace_back(j);
+        }
+    }
+    return lalib::SpCooMat<double>(std::move(val), std::move(row_ids), std::move(col_ids));
+}
+
+
+void sp_mat_assembly_bench();
+void sp_mat_mul_bench();
+
+int main() {
+    auto backend = 
+    #ifdef LALIB_BLAS_BACKEND
+        "BLAS";
+    #else
+        "Internal";
+    #endif
+
+    std::cout << "Benchmarks for sparse matrix implementations." << std::endl;
+    std::cout << std::setw(20) << std::left << " Backend" << ": " << backend << std::endl;
+
+    sp_mat_assembly_bench();
+    sp_mat_mul_bench();
+}
+
+void sp_mat_assembly_bench() {
+    std::cout << std::endl;
+    std::cout << "=== SpCooMat ===" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << " # Assembly (A += B, tri-diagonal)" << std::endl;
+    std::cout << " # of rows  | Elapsed " << std::endl;
+    std::cout << " -----------|--------------" << std::endl;
+
+    constexpr auto order = 5;
+    for (auto i = 2; i <= order; ++i) {
+        auto n = static_cast<size_t>(std::pow(10, i));
+        auto m1 = generate_tridiag_coo(n);
+        auto m2 = generate_tridiag_coo(n);
+
+        double elapsed = measure_consumption_time(100, [&](){
+            auto mr = m1;
+            mr += m2;
+        });
+        std::cout << "  " << std::setw(10) << n << "| " << elapsed << " ms" << std::endl;
+    }
+}
+
+void sp_mat_mul_bench() {
+    std::cout << std::endl;
+    std::cout << "=== SpMat ===" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << " # Multiplication (y = A x, tri-diagonal)" << std::endl;
+    std::cout << " # of rows  | Elapsed " << std::endl;
+    std::cout << " -----------|--------------" << std::endl;
+
+    constexpr auto order = 7;
+    for (auto i = 2; i <= order; ++i) {
+        auto n = static_cast<size_t>(std::pow(10, i));
+        auto mat = lalib::SpMat<double>(generate_tridiag_coo(n));
+        auto x = lalib::DynVec<double>::filled(n, 1.0);
+        auto y = lalib::DynVec<double>::uninit(n);
+
+        double elapsed = measure_consumption_time(100, [&](){
+            lalib::mul(1.0, mat, x, 0.0, y);
+        });
+        std::cout << "  " << std::setw(10) << n << "| " << elapsed << " ms" << std::endl;
+    }
+}
@@ -0,0 +1,20 @@
+#include "lalib/ops/autotune.hpp"
+#include <iostream>
+#include <string>
+
+// Measures the serial/parallel thresholds of the vector kernels, and writes them in the format of `LALIB_THRESHOLDS_FILE`.
+// usage: tune [output file] [max size]
+int main(int argc, char* argv[]) {
+    auto max_size = argc > 2 ? static_cast<size_t>(std::stoull(argv[2])) : size_t(1) << 22;
+
+    std::cerr << "Measuring the thresholds up to " << max_size << " elements..." << std::endl;
+    lalib::autotune_thresholds(max_size);
+
+    if (argc > 1) {
+        lalib::save_thresholds(std::string(argv[1]));
+        std::cerr << "Saved. Use them with: export LALIB_THRESHOLDS_FILE=" << argv[1] << std::endl;
+    } else {
+        lalib::save_thresholds(std::cout);
+    }
+    return 0;
+}
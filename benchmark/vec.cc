@@ -163,4 +163,72 @@ void dyn_vec_bench() {
         });
         std::cout << "  " << std::setw(10) << n << "| " << elapsed << " ms" << std::endl;
     }
+
+    std::cout << std::endl;
+    std::cout << " # Dot product (fast / reproducible summation)" << std::endl;
+    std::cout << " # of elems | Fast         | Reproducible | Ratio " << std::endl;
+    std::cout << " -----------|--------------|--------------|--------" << std::endl;
+    for (auto i = 3; i <= order; ++i) {
+        auto n = static_cast<size_t>(std::pow(10, i));
+        auto v1 = generate_rand_dyn_vec(n, rand);
+        auto v2 = generate_rand_dyn_vec(n, rand);
+
+        volatile double sink = 0.0;
+        double elapsed_fast = measure_consumption_time(100, [&](){
+            sink = lalib::dot(v1, v2, lalib::Summation::Fast);
+        });
+        double elapsed_repro = measure_consumption_time(100, [&](){
+            sink = lalib::dot(v1, v2, lalib::Summation::Reproducible);
+        });
+        std::cout << "  " << std::setw(10) << n 
+            << "| " << std::setw(9) << elapsed_fast << " ms"
+            << " | " << std::setw(9) << elapsed_repro << " ms"
+            << " | " << elapsed_repro / elapsed_fast << std::endl;
+    }
+
+    std::cout << std::endl;
+    std::cout << " # Euclidean norm (fast / reproducible summation)" << std::endl;
+    std::cout << " # of elems | Fast         | Reproducible | Ratio " << std::endl;
+    std::cout << " -----------|--------------|--------------|--------" << std::endl;
+    for (auto i = 3; i <= order; ++i) {
+        auto n = static_cast<size_t>(std::pow(10, i));
+        auto v = generate_rand_dyn_vec(n, rand);
+
+        volatile double sink = 0.0;
+        double elapsed_fast = measure_consumption_time(100, [&](){
+            sink = lalib::norm2(v, lalib::Summation::Fast);
+        });
+        double elapsed_repro = measure_consumption_time(100, [&](){
+            sink = lalib::norm2(v, lalib::Summation::Reproducible);
+        });
+        std::cout << "  " << std::setw(10) << n 
+            << "| " << std::setw(9) << elapsed_fast << " ms"
+            << " | " << std::setw(9) << elapsed_repro << " ms"
+            << " | " << elapsed_repro / elapsed_fast << std::endl;
+    }
+
+    std::cout << std::endl;
+    std::cout << " # Dot product of float vectors (fast / compensated / pairwise summation)" << std::endl;
+    std::cout << " # of elems | Fast         | Compensated  | Pairwise     " << std::endl;
+    std::cout << " -----------|--------------|--------------|--------------" << std::endl;
+    for (auto i = 3; i <= order; ++i) {
+        auto n = static_cast<size_t>(std::pow(10, i));
+        auto v1 = lalib::DynVec<float>::uninit(n);
+        auto v2 = lalib::DynVec<float>::uninit(n);
+        auto dist = std::uniform_real_distribution<float>(-1.0f, 1.0f);
+        for (auto k = 0u; k < n; ++k) {
+            v1[k] = dist(rand);
+            v2[k] = dist(rand);
+        }
+
+        volatile float sink = 0.0f;
+        std::cout << "  " << std::setw(10) << n;
+        for (auto summation: { lalib::Summation::Fast, lalib::Summation::Compensated, lalib::Summation::Pairwise }) {
+            double elapsed = measure_consumption_time(100, [&](){
+                sink = lalib::dot(v1, v2, summation);
+            });
+            std::cout << "| " << std::setw(9) << elapsed << " ms ";
+        }
+        std::cout << std::endl;
+    }
 }
\ No newline at end of file
@@ -15,4 +15,9 @@ if (LALIB_USE_ACCELERATOR)
 		message(FATAL_ERROR "OpenMP version 4.5 is required to enable hardware acceleration.")
 	endif()
 	add_compile_definitions(LALIB_USE_ACCELERATOR)
+endif()
+
+option(LALIB_REPRODUCIBLE_REDUCTIONS "Reproducible reductions independent of the number of threads" "FALSE")
+if (LALIB_REPRODUCIBLE_REDUCTIONS)
+	add_compile_definitions(LALIB_REPRODUCIBLE_REDUCTIONS)
 endif()
\ No newline at end of file
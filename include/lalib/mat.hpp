@@ -9,6 +9,8 @@
 #include "lalib/ops/mat_mat_ops.hpp"
 
 #include "lalib/mat/sp_mat.hpp"
+#include "lalib/mat/sp_sell_mat.hpp"
+#include "lalib/mat/sp_bsr_mat.hpp"
 #include "lalib/ops/sp_mat_ops.hpp"
 
 namespace lalib {
@@ -59,6 +61,61 @@ inline auto inverted(const SizedMat<T, 2, 2>& mat) -> SizedMat<T, 2, 2> {
     return inv;
 }
 
+/// @brief      Inverts a square sized matrix by Gauss-Jordan elimination with partial pivoting.
+/// @throw      `std::runtime_error` if the matrix is singular
+template<typename T, size_t N>
+inline auto invert(const SizedMat<T, N, N>& mat, SizedMat<T, N, N>& rmat) -> SizedMat<T, N, N> {
+    auto a = mat;
+    rmat = SizedMat<T, N, N>::filled(Zero<T>::value());
+    for (auto i = 0u; i < N; ++i) {
+        rmat(i, i) = One<T>::value();
+    }
+
+    for (auto k = 0u; k < N; ++k) {
+        auto p = k;
+        for (auto i = k + 1; i < N; ++i) {
+            if (std::abs(a(i, k)) > std::abs(a(p, k))) { p = i; }
+        }
+        if (a(p, k) == Zero<T>::value()) {
+            throw std::runtime_error("Matrix is singular.");
+        }
+        if (p != k) {
+            for (auto j = 0u; j < N; ++j) {
+                std::swap(a(k, j), a(p, j));
+                std::swap(rmat(k, j), rmat(p, j));
+            }
+        }
+
+        auto inv_pivot = One<T>::value() / a(k, k);
+        for (auto j = 0u; j < N; ++j) {
+            a(k, j) *= inv_pivot;
+            rmat(k, j) *= inv_pivot;
+        }
+        for (auto i = 0u; i < N; ++i) {
+            if (i == k) { continue; }
+            auto f = a(i, k);
+            for (auto j = 0u; j < N; ++j) {
+                a(i, j) -= f * a(k, j);
+                rmat(i, j) -= f * rmat(k, j);
+            }
+        }
+    }
+    return rmat;
+}
+
+template<typename T, size_t N>
+inline auto invert(SizedMat<T, N, N>& mat) -> SizedMat<T, N, N>& {
+    invert(SizedMat<T, N, N>(mat), mat);
+    return mat;
+}
+
+template<typename T, size_t N>
+inline auto inverted(const SizedMat<T, N, N>& mat) -> SizedMat<T, N, N> {
+    auto rmat = lalib::SizedMat<T, N, N>::uninit();
+    invert(mat, rmat);
+    return rmat;
+}
+
 }
 
 #endif
\ No newline at end of file
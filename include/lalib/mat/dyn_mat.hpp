@@ -376,6 +376,17 @@ struct HessenbergMat {
     /// @exception std::invalid_argument if the size of the new elements is not equal to the size of the matrix.
     void extend_with(std::vector<T>&& new_elems);
 
+    /// @brief Removes all the elements while keeping the allocated memory.
+    void clear() noexcept {
+        this->_h.clear();
+        this->_n = 0;
+    }
+
+    /// @brief Allocates memory for `cap` elements.
+    void reserve(size_t cap) {
+        this->_h.reserve(cap);
+    }
+
 
     /// @brief Returns a slice of the compoenents in the specified column.
     auto get_col(size_t j) const noexcept -> std::span<const T>;
@@ -455,10 +466,9 @@ constexpr auto HessenbergMat<T>::mut_at(size_t i, size_t j) -> T& {
 
 template<typename T>
 void HessenbergMat<T>::extend_with_zero() noexcept {
-    auto new_elems = this->_n == 0 ? 
-        std::vector<T>(1, Zero<T>::value()) : 
-        std::vector<T>(this->_n + 2, Zero<T>::value());
-    this->_h.insert(this->_h.end(), new_elems.begin(), new_elems.end());
+    // Resizing within the capacity does not allocate
+    auto nnew = this->_n == 0 ? 1 : this->_n + 2;
+    this->_h.resize(this->_h.size() + nnew, Zero<T>::value());
     this->_n += 1;
 }
 
@@ -517,6 +527,21 @@ struct DynUpperTriMat {
     /// @exception std::invalid_argument if the size of the new elements is not equal to the size of the matrix.
     void extend_with(std::vector<T>&& new_elems);
 
+    /// @brief Extends the upper triangular matrix with new components for one dimension, without allocation if the capacity suffices.
+    /// @exception std::invalid_argument if the size of the new elements is not equal to the size of the matrix.
+    void extend_with(std::span<const T> new_elems);
+
+    /// @brief Removes all the elements while keeping the allocated memory.
+    void clear() noexcept {
+        this->_upper_elems.clear();
+        this->_n = 0;
+    }
+
+    /// @brief Allocates memory for `cap` elements.
+    void reserve(size_t cap) {
+        this->_upper_elems.reserve(cap);
+    }
+
 
     /// @brief Perfoms backward substitution to solve the linear system.
     /// @tparam V    a vector type
@@ -597,8 +622,7 @@ constexpr auto DynUpperTriMat<T>::mut_at(size_t i, size_t j) -> T& {
 
 template<typename T>
 void DynUpperTriMat<T>::extend_with_zero() noexcept {
-    auto new_elems = std::vector<T>(this->_n + 1, Zero<T>::value());
-    this->_upper_elems.insert(this->_upper_elems.end(), new_elems.begin(), new_elems.end());
+    this->_upper_elems.resize(this->_upper_elems.size() + this->_n + 1, Zero<T>::value());
     this->_n += 1;
 }
 
@@ -611,6 +635,15 @@ void DynUpperTriMat<T>::extend_with(std::vector<T>&& new_elems) {
     this->_n += 1;
 }
 
+template<typename T>
+void DynUpperTriMat<T>::extend_with(std::span<const T> new_elems) {
+    if (new_elems.size() != this->_n + 1) {
+        throw std::invalid_argument("New components must have length n + 1 = " + std::to_string(this->_n + 1));
+    }
+    this->_upper_elems.insert(this->_upper_elems.end(), new_elems.begin(), new_elems.end());
+    this->_n += 1;
+}
+
 template<typename T>
 template<std::ranges::random_access_range V>
 void DynUpperTriMat<T>::back_sub(V&& y) const {
@@ -0,0 +1,268 @@
+#ifndef LALIB_MAT_SPARSE_BSR_MAT_HPP
+#define LALIB_MAT_SPARSE_BSR_MAT_HPP
+
+#include "lalib/ops/ops_traits.hpp"
+#include "lalib/mat/sp_mat.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace lalib {
+
+/// @brief  Sparse matrix in block compressed sparse row (BSR) format
+/// @details    The matrix is partitioned into dense `B` x `B` blocks, and only the non-zero blocks are stored
+///             together with one column index per block. Each block is stored row-major as `SizedMat<T, B, B>` does.
+/// @tparam T   an element type
+/// @tparam B   the size of the blocks
+/// @tparam I   an unsigned integer type of the block indices
+template<typename T, size_t B, std::unsigned_integral I = size_t>
+struct SpBsrMat {
+    using ElemType = T;
+    using IndexType = I;
+    static constexpr size_t BlockSize = B;
+
+    // ==== Initializations ==== //
+
+    /// @brief Create an empty sparse matrix object.
+    SpBsrMat() noexcept = default;
+
+    /// @brief Create a sparse matrix with given block data.
+    /// @param val      values of the blocks. the length must be `col_ids.size() * B * B`.
+    /// @param row_ptr  block row pointers
+    /// @param col_ids  block column indices
+    /// @param nbcol    the number of block columns. `0` infers it from the block column indices.
+    /// @throw  `std::invalid_argument` if `row_ptr` is empty or does not end at the number of blocks, 
+    ///         or if a block column index exceeds `nbcol`
+    SpBsrMat(std::vector<T>&& val, std::vector<I>&& row_ptr, std::vector<I>&& col_ids, size_t nbcol = 0);
+
+    /// @brief Create a sparse matrix from a CSR matrix.
+    /// @throw  `std::invalid_argument` if the shape of the matrix is not a multiple of the block size.
+    SpBsrMat(const SpMat<T, I>& mat);
+
+    /// @brief Copy constructor
+    SpBsrMat(const SpBsrMat<T, B, I>& mat) = default;
+
+    /// @brief Move constructor
+    SpBsrMat(SpBsrMat<T, B, I>&& mat) noexcept = default;
+
+
+    // === Inspecting === //
+
+    /// @brief Returns the shape of the matrix (row, column).
+    auto shape() const noexcept -> std::pair<size_t, size_t>
+        { return std::make_pair(this->_nbrow * B, this->_nbcol * B); }
+
+    /// @brief Returns the shape of the matrix in blocks (row, column).
+    auto block_shape() const noexcept -> std::pair<size_t, size_t>
+        { return std::make_pair(this->_nbrow, this->_nbcol); }
+
+    /// @brief Returns the number of the stored blocks.
+    auto nblocks() const noexcept -> size_t
+        { return this->_col_ids.size(); }
+
+    /// @brief Returns the number of the stored elements (`nblocks() * B * B`).
+    auto nnz() const noexcept -> size_t
+        { return this->_val.size(); }
+
+    /// @brief Returns the value of the element at the given position.
+    /// @param i    row index
+    /// @param j    column index
+    auto operator()(size_t i, size_t j) const noexcept -> const T&;
+
+    /// @brief Returns the value of the element at the given position.
+    /// @param i    row index
+    /// @param j    column index
+    auto at(size_t i, size_t j) const noexcept -> const T&;
+
+    /// @brief Gets a mutable reference to the element at the given position.
+    /// @param i    row index
+    /// @param j    column index
+    /// @throw      `std::out_of_range` if the index is out of range or does not point to a stored block
+    auto mut_at(size_t i, size_t j) -> T&;
+
+    /// @brief Returns the position of the block `(bi, bj)` in the block arrays.
+    /// @return     the position of the block, or `nblocks()` if the block is not stored.
+    auto find_block(size_t bi, size_t bj) const noexcept -> size_t;
+
+
+    // === Assignment === //
+
+    /// @brief Replaces the elements of the matrix.
+    auto operator=(const SpBsrMat<T, B, I>& mat) -> SpBsrMat<T, B, I>&;
+
+    /// @brief Replaces the elements of the matrix.
+    auto operator=(SpBsrMat<T, B, I>&& mat) noexcept -> SpBsrMat<T, B, I>&;
+
+
+    // === Accessing === //
+
+    /// @brief Returns a pointer to the array of the values.
+    auto data() noexcept -> T*
+        { return this->_val.data(); }
+
+    /// @brief Returns a reference to the array of the values.
+    auto values() const noexcept -> const std::vector<T>&
+        { return this->_val; }
+
+    /// @brief Returns a reference to the array of the block row pointers.
+    auto row_ptr() const noexcept -> const std::vector<I>&
+        { return this->_row_ptr; }
+
+    /// @brief Returns a reference to the array of the block column indices.
+    auto col_indices() const noexcept -> const std::vector<I>&
+        { return this->_col_ids; }
+
+    /// @brief Returns a pointer to the head of the `k`-th stored block.
+    auto block(size_t k) const noexcept -> const T*
+        { return this->_val.data() + k * B * B; }
+
+    /// @brief Returns a pointer to the head of the `k`-th stored block.
+    auto block(size_t k) noexcept -> T*
+        { return this->_val.data() + k * B * B; }
+
+private:
+    size_t _nbrow = 0;
+    size_t _nbcol = 0;
+
+    std::vector<T> _val;
+    std::vector<I> _row_ptr;
+    std::vector<I> _col_ids;
+
+    const T _zero = Zero<T>::value();
+};
+
+
+// === Implementations === //
+
+template<typename T, size_t B, std::unsigned_integral I>
+SpBsrMat<T, B, I>::SpBsrMat(std::vector<T>&& val, std::vector<I>&& row_ptr, std::vector<I>&& col_ids, size_t nbcol):
+    _nbcol(_index_extent(col_ids, nbcol)),
+    _val(std::move(val)), _row_ptr(std::move(row_ptr)), _col_ids(std::move(col_ids))
+{
+    if (this->_row_ptr.empty() || this->_row_ptr.back() != this->_col_ids.size()) {
+        throw std::invalid_argument("The block row pointers must end at the number of blocks " + std::to_string(this->_col_ids.size()) + ".");
+    }
+    if (this->_val.size() != this->_col_ids.size() * B * B) {
+        throw std::runtime_error("The size of the values must be the number of blocks times " + std::to_string(B * B) + ".");
+    }
+    this->_nbrow = this->_row_ptr.size() - 1;
+}
+
+template<typename T, size_t B, std::unsigned_integral I>
+SpBsrMat<T, B, I>::SpBsrMat(const SpMat<T, I>& mat) {
+    auto [n, m] = mat.shape();
+    if (n % B != 0 || m % B != 0) {
+        throw std::invalid_argument("The shape of the matrix must be a multiple of the block size " + std::to_string(B) + ".");
+    }
+    this->_nbrow = n / B;
+    this->_nbcol = m / B;
+
+    const auto& row_ptr = mat.row_ptr();
+    const auto& col_ids = mat.col_indices();
+    const auto& val = mat.values();
+
+    // Block position of each block column in the current block row (`SIZE_MAX` if absent)
+    auto marker = std::vector<size_t>(this->_nbcol, SIZE_MAX);
+    auto bcols = std::vector<size_t>();
+
+    this->_row_ptr.reserve(this->_nbrow + 1);
+    this->_row_ptr.emplace_back(0);
+    for (auto bi = 0u; bi < this->_nbrow; ++bi) {
+        // Collect the block pattern of the block row
+        bcols.clear();
+        for (auto i = bi * B; i < (bi + 1) * B; ++i) {
+            for (auto k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+                auto bj = col_ids[k] / B;
+                if (marker[bj] == SIZE_MAX) {
+                    marker[bj] = 0;
+                    bcols.emplace_back(bj);
+                }
+            }
+        }
+        std::ranges::sort(bcols);
+
+        auto head = this->_col_ids.size();
+        for (auto p = 0u; p < bcols.size(); ++p) {
+            marker[bcols[p]] = head + p;
+            this->_col_ids.emplace_back(bcols[p]);
+        }
+        this->_val.resize(this->_col_ids.size() * B * B, Zero<T>::value());
+
+        // Scatter the elements into the blocks
+        for (auto i = bi * B; i < (bi + 1) * B; ++i) {
+            for (auto k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+                auto j = col_ids[k];
+                this->_val[marker[j / B] * B * B + (i % B) * B + j % B] = val[k];
+            }
+        }
+
+        for (auto bj: bcols) { marker[bj] = SIZE_MAX; }
+        this->_row_ptr.emplace_back(this->_col_ids.size());
+    }
+}
+
+template<typename T, size_t B, std::unsigned_integral I>
+auto SpBsrMat<T, B, I>::find_block(size_t bi, size_t bj) const noexcept -> size_t {
+    auto begin = this->_col_ids.begin() + this->_row_ptr[bi];
+    auto end = this->_col_ids.begin() + this->_row_ptr[bi + 1];
+    auto it = std::lower_bound(begin, end, bj);
+    if (it != end && *it == bj) {
+        return static_cast<size_t>(std::distance(this->_col_ids.begin(), it));
+    }
+    return this->nblocks();
+}
+
+template<typename T, size_t B, std::unsigned_integral I>
+auto SpBsrMat<T, B, I>::operator()(size_t i, size_t j) const noexcept -> const T& {
+    auto k = this->find_block(i / B, j / B);
+    if (k == this->nblocks()) {
+        return this->_zero;
+    }
+    return this->_val[k * B * B + (i % B) * B + j % B];
+}
+
+template<typename T, size_t B, std::unsigned_integral I>
+auto SpBsrMat<T, B, I>::at(size_t i, size_t j) const noexcept -> const T& {
+    return (*this)(i, j);
+}
+
+template<typename T, size_t B, std::unsigned_integral I>
+auto SpBsrMat<T, B, I>::mut_at(size_t i, size_t j) -> T& {
+    if (i >= this->_nbrow * B) {
+        throw std::out_of_range("Index out of range or does not point to a stored block.");
+    }
+    auto k = this->find_block(i / B, j / B);
+    if (k == this->nblocks()) {
+        throw std::out_of_range("Index out of range or does not point to a stored block.");
+    }
+    return this->_val[k * B * B + (i % B) * B + j % B];
+}
+
+template<typename T, size_t B, std::unsigned_integral I>
+auto SpBsrMat<T, B, I>::operator=(const SpBsrMat<T, B, I>& mat) -> SpBsrMat<T, B, I>& {
+    this->_nbrow = mat._nbrow;
+    this->_nbcol = mat._nbcol;
+    this->_val = mat._val;
+    this->_row_ptr = mat._row_ptr;
+    this->_col_ids = mat._col_ids;
+
+    return *this;
+}
+
+template<typename T, size_t B, std::unsigned_integral I>
+auto SpBsrMat<T, B, I>::operator=(SpBsrMat<T, B, I>&& mat) noexcept -> SpBsrMat<T, B, I>& {
+    this->_nbrow = mat._nbrow;
+    this->_nbcol = mat._nbcol;
+    this->_val = std::move(mat._val);
+    this->_row_ptr = std::move(mat._row_ptr);
+    this->_col_ids = std::move(mat._col_ids);
+
+    return *this;
+}
+
+}
+#endif
@@ -4,19 +4,30 @@
 #include "lalib/ops/ops_traits.hpp"
 #include <algorithm>
 #include <bits/ranges_algo.h>
+#include <concepts>
 #include <cstddef>
 #include <vector>
 #include <cassert>
+#include <limits>
 #include <ranges>
 #include <numeric>
 #include <span>
+#include <stdexcept>
+#include <string>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace lalib {
 
 /// @brief  Sparse matrix in coordinate format
-template<typename T>
+/// @tparam T   an element type
+/// @tparam I   an unsigned integer type of the indices. a narrower type such as `uint32_t` reduces the memory traffic of the indices.
+template<typename T, std::unsigned_integral I = size_t>
 struct SpCooMat {
     using ElemType = T; 
+    using IndexType = I;
 
     // ==== Initializations ==== //
 
@@ -24,22 +35,33 @@ struct SpCooMat {
     SpCooMat() noexcept = default;
 
     /// @brief Create a sparse matrix with given data.
-    SpCooMat(const std::vector<T>& val, const std::vector<size_t>& row_ids, const std::vector<size_t>& col_ids);
+    /// @param nrow the number of rows. `0` infers it from the row indices.
+    /// @param ncol the number of columns. `0` infers it from the column indices.
+    /// @throw  `std::invalid_argument` if an index exceeds the given shape
+    SpCooMat(const std::vector<T>& val, const std::vector<I>& row_ids, const std::vector<I>& col_ids, size_t nrow = 0, size_t ncol = 0);
 
     /// @brief Create a sparse matrix with given data.
-    SpCooMat(std::vector<T>&& val, std::vector<size_t>&& row_ids, std::vector<size_t>&& col_ids);
+    /// @param nrow the number of rows. `0` infers it from the row indices.
+    /// @param ncol the number of columns. `0` infers it from the column indices.
+    /// @throw  `std::invalid_argument` if an index exceeds the given shape
+    SpCooMat(std::vector<T>&& val, std::vector<I>&& row_ids, std::vector<I>&& col_ids, size_t nrow = 0, size_t ncol = 0);
 
     /// @brief Copy constructor
-    SpCooMat(const SpCooMat<T>& mat) noexcept = default;
+    SpCooMat(const SpCooMat<T, I>& mat) noexcept = default;
 
     /// @brief Move constructor
-    SpCooMat(SpCooMat<T>&& mat) noexcept = default;
+    SpCooMat(SpCooMat<T, I>&& mat) noexcept = default;
+
+    /// @brief Create a sparse matrix from one with another index type.
+    /// @throw  `std::overflow_error` if an index does not fit in `I`
+    template<std::unsigned_integral J>
+    explicit SpCooMat(const SpCooMat<T, J>& mat);
 
 
     /// @brief Create an unit matrix with given size.
     /// @param n    the size of the matrix
     /// @return     a unit matrix with given size.
-    static auto unit(size_t n) -> SpCooMat<T>; 
+    static auto unit(size_t n) -> SpCooMat<T, I>; 
 
 
     // === Inspecting === //
@@ -88,12 +110,12 @@ struct SpCooMat {
     /// @brief Replaces the elements of the vector.
     /// @param mat the matrix to use as data source
     /// @return a reference of the matrix after modified by the operation.
-    constexpr auto operator=(const SpCooMat<T>& mat) noexcept -> SpCooMat<T>&;
+    constexpr auto operator=(const SpCooMat<T, I>& mat) noexcept -> SpCooMat<T, I>&;
 
     /// @brief Replaces the elements of the vector.
     /// @param mat the matrix to use as data source
     /// @return a reference of the matrix after modified by the operation.
-    constexpr auto operator=(SpCooMat<T>&& mat) noexcept -> SpCooMat<T>&;
+    constexpr auto operator=(SpCooMat<T, I>&& mat) noexcept -> SpCooMat<T, I>&;
 
 
     // === Accessing === //
@@ -110,12 +132,12 @@ struct SpCooMat {
 
     /// @brief Returns a reference to the array of the row indices.
     /// @return     a pointer to the array of the row indices.
-    auto row_indices() const noexcept -> const std::vector<size_t>&
+    auto row_indices() const noexcept -> const std::vector<I>&
         { return this->_row_ids; }
 
     /// @brief Returns a reference to the array of the column indices.
     /// @return     a pointer to the array of the column indices.
-    auto col_indices() const noexcept -> const std::vector<size_t>&
+    auto col_indices() const noexcept -> const std::vector<I>&
         { return this->_col_ids; }
 
 
@@ -124,12 +146,15 @@ struct SpCooMat {
     /// @brief Add and assign the matrix with another matrix.
     /// @param mat the matrix to add
     /// @return a reference of the matrix after modified by the operation.
-    auto operator+=(const SpCooMat<T>& mat) -> SpCooMat<T>&;
+    auto operator+=(const SpCooMat<T, I>& mat) -> SpCooMat<T, I>&;
 
 private:
+    size_t _nrow = 0;
+    size_t _ncol = 0;
+
     std::vector<T> _val;
-    std::vector<size_t> _row_ids;
-    std::vector<size_t> _col_ids;
+    std::vector<I> _row_ids;
+    std::vector<I> _col_ids;
 
     const T _zero = Zero<T>::value();
 
@@ -138,9 +163,12 @@ private:
 
 
 /// @brief Sparse matrix in compressed sparse row format
-template<typename T>
+/// @tparam T   an element type
+/// @tparam I   an unsigned integer type of the indices. a narrower type such as `uint32_t` reduces the memory traffic of the indices.
+template<typename T, std::unsigned_integral I = size_t>
 struct SpMat {
     using ElemType = T;
+    using IndexType = I;
 
     // ==== Initializations ==== //
 
@@ -148,27 +176,38 @@ struct SpMat {
     SpMat() noexcept = default;
 
     /// @brief Create a sparse matrix from a COO matrix.
-    SpMat(const SpCooMat<T>& mat) noexcept;
+    /// @throw  `std::overflow_error` if the number of non-zero elements does not fit in `I`
+    SpMat(const SpCooMat<T, I>& mat);
 
     /// @brief Create a sparse matrix from a COO matrix.
-    SpMat(SpCooMat<T>&& mat) noexcept;
+    /// @throw  `std::overflow_error` if the number of non-zero elements does not fit in `I`
+    SpMat(SpCooMat<T, I>&& mat);
 
     /// @brief Create a sparse matrix with given data.
-    SpMat(const std::vector<T>& val, const std::vector<size_t>& row_ptr, const std::vector<size_t>& col_ids);
+    /// @param ncol the number of columns. `0` infers it from the column indices.
+    /// @throw  `std::invalid_argument` if a column index exceeds `ncol`
+    SpMat(const std::vector<T>& val, const std::vector<I>& row_ptr, const std::vector<I>& col_ids, size_t ncol = 0);
 
     /// @brief Create a sparse matrix with given data.
-    SpMat(std::vector<T>&& val, std::vector<size_t>&& row_ptr, std::vector<size_t>&& col_ids);
+    /// @param ncol the number of columns. `0` infers it from the column indices.
+    /// @throw  `std::invalid_argument` if a column index exceeds `ncol`
+    SpMat(std::vector<T>&& val, std::vector<I>&& row_ptr, std::vector<I>&& col_ids, size_t ncol = 0);
 
     /// @brief Copy constructor
-    SpMat(const SpMat<T>& mat) noexcept = default;
+    SpMat(const SpMat<T, I>& mat) noexcept = default;
 
     /// @brief Move constructor
-    SpMat(SpMat<T>&& mat) noexcept = default;
+    SpMat(SpMat<T, I>&& mat) noexcept = default;
+
+    /// @brief Create a sparse matrix from one with another index type.
+    /// @throw  `std::overflow_error` if an index does not fit in `I`
+    template<std::unsigned_integral J>
+    explicit SpMat(const SpMat<T, J>& mat);
 
     /// @brief Create an unit matrix with given size.
     /// @param n    the size of the matrix
     /// @return     a unit matrix with given size.
-    static auto unit(size_t n) -> SpMat<T>;
+    static auto unit(size_t n) -> SpMat<T, I>;
 
 
     // === Inspecting === //
@@ -218,12 +257,12 @@ struct SpMat {
     /// @brief Replaces the elements of the vector.
     /// @param mat the matrix to use as data source
     /// @return a reference of the matrix after modified by the operation.
-    constexpr auto operator=(const SpMat<T>& mat) noexcept -> SpMat<T>&;
+    constexpr auto operator=(const SpMat<T, I>& mat) noexcept -> SpMat<T, I>&;
 
     /// @brief Replaces the elements of the vector.
     /// @param mat the matrix to use as data source
     /// @return a reference of the matrix after modified by the operation.
-    constexpr auto operator=(SpMat<T>&& mat) noexcept -> SpMat<T>&;
+    constexpr auto operator=(SpMat<T, I>&& mat) noexcept -> SpMat<T, I>&;
 
 
     // === Accessing === //
@@ -240,27 +279,43 @@ struct SpMat {
     
     /// @brief Returns a pointer to the array of the row pointers.
     /// @return     a pointer to the array of the row pointers.
-    auto row_ptr() const noexcept -> const std::vector<size_t>&
+    auto row_ptr() const noexcept -> const std::vector<I>&
         { return this->_row_ptr; }
 
     /// @brief Returns a pointer to the array of the column indices.
     /// @return     a pointer to the array of the column indices.
-    auto col_indices() const noexcept -> const std::vector<size_t>&
+    auto col_indices() const noexcept -> const std::vector<I>&
         { return this->_col_ids; }
 
+    /// @brief Returns the row boundaries splitting the matrix into `nparts` chunks with nearly equal number of non-zero elements.
+    /// @details    The `p`-th chunk covers the rows in `[part[p], part[p + 1])`.
+    /// @param nparts   the number of chunks
+    /// @return     the array of `nparts + 1` row boundaries.
+    auto row_partition(size_t nparts) const -> std::vector<size_t>;
+
+    /// @brief Returns the partition of `row_partition(omp_get_max_threads())`, computed when the matrix is built.
+    /// @details    It is never modified afterwards, so the products may read it from several threads at once.
+    ///             The products compute a partition themselves if the number of threads has changed since.
+    auto thread_row_partition() const noexcept -> const std::vector<size_t>&
+        { return this->_row_part; }
+
 
     // === Arithmetic Assignment Operators === //
 
     /// @brief Add and assign the matrix with another matrix.
     /// @param mat the matrix to add
     /// @return a reference of the matrix after modified by the operation.
-    auto operator+=(const SpMat<T>& mat) -> SpMat<T>&;
+    auto operator+=(const SpMat<T, I>& mat) -> SpMat<T, I>&;
 
 
 private:
+    size_t _ncol = 0;
+
     std::vector<T> _val;
-    std::vector<size_t> _row_ptr;
-    std::vector<size_t> _col_ids;
+    std::vector<I> _row_ptr;
+    std::vector<I> _col_ids;
+
+    std::vector<size_t> _row_part;
 
     const T _zero = Zero<T>::value();
 
@@ -268,12 +323,47 @@ private:
 };
 
 
+/// @brief Checks that `n` can be represented by the index type `I`.
+/// @throw  `std::overflow_error` if `n` exceeds the maximum value of `I`
+template<std::unsigned_integral I>
+inline void _check_index_range(size_t n) {
+    if (n > std::numeric_limits<I>::max()) {
+        throw std::overflow_error("The index " + std::to_string(n) + " exceeds the range of the index type.");
+    }
+}
+
+/// @brief Returns the extent of a dimension holding the given indices.
+/// @param n    the requested extent. `0` infers it from the indices.
+/// @throw  `std::invalid_argument` if an index exceeds `n`
+template<std::unsigned_integral I>
+inline auto _index_extent(const std::vector<I>& ids, size_t n) -> size_t {
+    auto extent = ids.empty() ? size_t(0) : static_cast<size_t>(*std::ranges::max_element(ids)) + 1;
+    if (n == 0) {
+        return extent;
+    }
+    if (extent > n) {
+        throw std::invalid_argument("The index " + std::to_string(extent - 1) + " exceeds the dimension " + std::to_string(n) + ".");
+    }
+    return n;
+}
+
+/// @brief Converts an array of indices into another index type.
+/// @throw  `std::overflow_error` if an index does not fit in `I`
+template<std::unsigned_integral I, std::unsigned_integral J>
+inline auto _convert_indices(const std::vector<J>& ids) -> std::vector<I> {
+    if (!ids.empty()) {
+        _check_index_range<I>(*std::ranges::max_element(ids));
+    }
+    return std::vector<I>(ids.begin(), ids.end());
+}
+
+
 // === COO Matrix === //
 // === Implementations === //
 
-template<typename T>
-SpCooMat<T>::SpCooMat(const std::vector<T>& val, const std::vector<size_t>& row_ids, const std::vector<size_t>& col_ids)
-    : _val(val), _row_ids(row_ids), _col_ids(col_ids) 
+template<typename T, std::unsigned_integral I>
+SpCooMat<T, I>::SpCooMat(const std::vector<T>& val, const std::vector<I>& row_ids, const std::vector<I>& col_ids, size_t nrow, size_t ncol)
+    : _nrow(_index_extent(row_ids, nrow)), _ncol(_index_extent(col_ids, ncol)), _val(val), _row_ids(row_ids), _col_ids(col_ids) 
 {
     if (this->_val.size() != this->_row_ids.size() || this->_val.size() != this->_col_ids.size()) {
         throw std::runtime_error("The size of the vectors must be the same.");
@@ -281,9 +371,10 @@ SpCooMat<T>::SpCooMat(const std::vector<T>& val, const std::vector<size_t>& row_
     this->_sort();
 }
 
-template<typename T>
-SpCooMat<T>::SpCooMat(std::vector<T>&& val, std::vector<size_t>&& row_ids, std::vector<size_t>&& col_ids)
-    : _val(std::move(val)), _row_ids(std::move(row_ids)), _col_ids(std::move(col_ids))
+template<typename T, std::unsigned_integral I>
+SpCooMat<T, I>::SpCooMat(std::vector<T>&& val, std::vector<I>&& row_ids, std::vector<I>&& col_ids, size_t nrow, size_t ncol)
+    : _nrow(_index_extent(row_ids, nrow)), _ncol(_index_extent(col_ids, ncol)), 
+      _val(std::move(val)), _row_ids(std::move(row_ids)), _col_ids(std::move(col_ids))
 {
     if (this->_val.size() != this->_row_ids.size() || this->_val.size() != this->_col_ids.size()) {
         throw std::runtime_error("The size of the vectors must be the same.");
@@ -291,36 +382,40 @@ SpCooMat<T>::SpCooMat(std::vector<T>&& val, std::vector<size_t>&& row_ids, std::
     this->_sort();
 }
 
-template<typename T>
-auto SpCooMat<T>::unit(size_t n) -> SpCooMat<T> {
+template<typename T, std::unsigned_integral I>
+template<std::unsigned_integral J>
+SpCooMat<T, I>::SpCooMat(const SpCooMat<T, J>& mat)
+    : _nrow(mat.shape().first), _ncol(mat.shape().second), _val(mat.values()), _row_ids(_convert_indices<I>(mat.row_indices())), _col_ids(_convert_indices<I>(mat.col_indices()))
+{}
+
+template<typename T, std::unsigned_integral I>
+auto SpCooMat<T, I>::unit(size_t n) -> SpCooMat<T, I> {
+    _check_index_range<I>(n);
     std::vector<T> val(n, One<T>::value());
-    std::vector<size_t> row_ids(n);
-    std::vector<size_t> col_ids(n);
+    std::vector<I> row_ids(n);
+    std::vector<I> col_ids(n);
 
     for (auto i: std::views::iota(0u, n)) {
         row_ids[i] = i;
         col_ids[i] = i;
     }
 
-    return SpCooMat<T>(val, row_ids, col_ids);
+    return SpCooMat<T, I>(val, row_ids, col_ids, n, n);
 }
 
 
-template<typename T>
-constexpr auto SpCooMat<T>::shape() const noexcept -> std::pair<size_t, size_t> {
-    size_t nrow = *std::ranges::max_element(this->_row_ids) + 1;
-    size_t ncol = *std::ranges::max_element(this->_col_ids) + 1;
-
-    return std::make_pair(nrow, ncol);
+template<typename T, std::unsigned_integral I>
+constexpr auto SpCooMat<T, I>::shape() const noexcept -> std::pair<size_t, size_t> {
+    return std::make_pair(this->_nrow, this->_ncol);
 }
 
-template<typename T>
-constexpr auto SpCooMat<T>::nnz() const noexcept -> size_t {
+template<typename T, std::unsigned_integral I>
+constexpr auto SpCooMat<T, I>::nnz() const noexcept -> size_t {
     return this->_val.size();
 }
 
-template<typename T>
-auto SpCooMat<T>::operator()(size_t i, size_t j) const noexcept -> const T& {
+template<typename T, std::unsigned_integral I>
+auto SpCooMat<T, I>::operator()(size_t i, size_t j) const noexcept -> const T& {
     for (auto cnt: std::views::iota(0u, this->_val.size())) {
         if (this->_row_ids[cnt] == i && this->_col_ids[cnt] == j) {
             return this->_val[cnt];
@@ -329,13 +424,13 @@ auto SpCooMat<T>::operator()(size_t i, size_t j) const noexcept -> const T& {
     return this->_zero;
 }
 
-template<typename T>
-auto SpCooMat<T>::at(size_t i, size_t j) const noexcept -> const T& {
+template<typename T, std::unsigned_integral I>
+auto SpCooMat<T, I>::at(size_t i, size_t j) const noexcept -> const T& {
     return (*this)(i, j);
 }
 
-template<typename T>
-auto SpCooMat<T>::mut_at(size_t i, size_t j) -> T& {
+template<typename T, std::unsigned_integral I>
+auto SpCooMat<T, I>::mut_at(size_t i, size_t j) -> T& {
     for (auto cnt: std::views::iota(0u, this->_val.size())) {
         if (this->_row_ids[cnt] == i && this->_col_ids[cnt] == j) {
             return this->_val[cnt];
@@ -344,8 +439,10 @@ auto SpCooMat<T>::mut_at(size_t i, size_t j) -> T& {
     throw std::out_of_range("Index out of range or does not point to a non-zero element.");
 }
 
-template<typename T>
-constexpr auto SpCooMat<T>::operator=(const SpCooMat<T>& mat) noexcept -> SpCooMat<T>& {
+template<typename T, std::unsigned_integral I>
+constexpr auto SpCooMat<T, I>::operator=(const SpCooMat<T, I>& mat) noexcept -> SpCooMat<T, I>& {
+    this->_nrow = mat._nrow;
+    this->_ncol = mat._ncol;
     this->_val = mat._val;
     this->_row_ids = mat._row_ids;
     this->_col_ids = mat._col_ids;
@@ -353,8 +450,10 @@ constexpr auto SpCooMat<T>::operator=(const SpCooMat<T>& mat) noexcept -> SpCooM
     return *this;
 }
 
-template<typename T>
-constexpr auto SpCooMat<T>::operator=(SpCooMat<T>&& mat) noexcept -> SpCooMat<T>& {
+template<typename T, std::unsigned_integral I>
+constexpr auto SpCooMat<T, I>::operator=(SpCooMat<T, I>&& mat) noexcept -> SpCooMat<T, I>& {
+    this->_nrow = mat._nrow;
+    this->_ncol = mat._ncol;
     this->_val = std::move(mat._val);
     this->_row_ids = std::move(mat._row_ids);
     this->_col_ids = std::move(mat._col_ids);
@@ -362,69 +461,52 @@ constexpr auto SpCooMat<T>::operator=(SpCooMat<T>&& mat) noexcept -> SpCooMat<T>
     return *this;
 }
 
-template<typename T>
-auto SpCooMat<T>::operator+=(const SpCooMat<T>& mat) -> SpCooMat<T>& {
+template<typename T, std::unsigned_integral I>
+auto SpCooMat<T, I>::operator+=(const SpCooMat<T, I>& mat) -> SpCooMat<T, I>& {
     this->_val.reserve(this->_val.size() + mat.nnz());
     this->_row_ids.reserve(this->_row_ids.size() + mat.nnz());
     this->_col_ids.reserve(this->_col_ids.size() + mat.nnz());
 
+    // Merge each row of `mat` into the original entries of `this`. New entries are appended and sorted afterwards.
     auto nrow_ids = this->_row_ids.size();
     auto nrrow_ids = mat._row_ids.size();
-    auto row_iter = this->_row_ids.begin();
-    auto rrow_iter = mat._row_ids.begin();
-    for (auto i = 0u; i < mat.shape().first; ++i) {
-        auto row_iter_end = std::upper_bound(row_iter, this->_row_ids.begin() + nrow_ids, i, std::less<size_t>{});
-        auto rrow_iter_end = std::upper_bound(rrow_iter, mat._row_ids.begin() + nrrow_ids, i, std::less<size_t>{});
-
-        auto cursor = std::distance(this->_row_ids.begin(), row_iter);
-        auto rcursor = std::distance(mat._row_ids.begin(), rrow_iter);
-        auto cursor_end = std::distance(this->_row_ids.begin(), row_iter_end) - 1;
-        auto rcursor_end = std::distance(mat._row_ids.begin(), rrow_iter_end) - 1;
-
-        while (rcursor <= rcursor_end) {
-            if (this->_col_ids[cursor] == mat._col_ids[rcursor]) {
-                this->_val[cursor] += mat._val[rcursor];
-
-                if (rcursor == rcursor_end) { break; }
-                else {
-                    if (cursor < cursor_end) { ++cursor; }
-                    if (rcursor < rcursor_end) { ++rcursor; }
-                }
+    auto cursor = size_t(0);
+    auto rcursor = size_t(0);
+    auto nrow = mat._nrow;
+    for (auto i = 0u; i < nrow; ++i) {
+        auto cursor_end = cursor;
+        while (cursor_end < nrow_ids && this->_row_ids[cursor_end] <= i) { ++cursor_end; }
+        auto rcursor_end = rcursor;
+        while (rcursor_end < nrrow_ids && mat._row_ids[rcursor_end] <= i) { ++rcursor_end; }
+
+        while (rcursor < rcursor_end) {
+            if (cursor < cursor_end && this->_col_ids[cursor] < mat._col_ids[rcursor]) {
+                ++cursor;
             }
-            else if (this->_col_ids[cursor] < mat._col_ids[rcursor]) {
-                if (cursor < cursor_end) { ++cursor; }
-                else {
-                    this->_val.emplace_back(mat._val[rcursor]);
-                    this->_row_ids.emplace_back(i);
-                    this->_col_ids.emplace_back(mat._col_ids[rcursor]);
-
-                    if (rcursor == rcursor_end) { break; }
-                    else { ++rcursor; }
-                }
+            else if (cursor < cursor_end && this->_col_ids[cursor] == mat._col_ids[rcursor]) {
+                this->_val[cursor] += mat._val[rcursor];
+                ++cursor;
+                ++rcursor;
             }
             else {
                 this->_val.emplace_back(mat._val[rcursor]);
                 this->_row_ids.emplace_back(i);
                 this->_col_ids.emplace_back(mat._col_ids[rcursor]);
-
-                if (rcursor == rcursor_end) { break; }
-                else { 
-                    if (rcursor < rcursor_end) { ++rcursor; }
-                }
+                ++rcursor;
             }
-        } 
-
-        row_iter = row_iter_end;
-        rrow_iter = rrow_iter_end;
+        }
+        cursor = cursor_end;
     }
 
+    this->_nrow = std::max(this->_nrow, mat._nrow);
+    this->_ncol = std::max(this->_ncol, mat._ncol);
     this->_sort();
     return *this;
 }
 
 
-template<typename T>
-void SpCooMat<T>::_sort() noexcept {
+template<typename T, std::unsigned_integral I>
+void SpCooMat<T, I>::_sort() noexcept {
     std::vector<size_t> ids(this->_val.size());
     std::iota(ids.begin(), ids.end(), 0u);
 
@@ -436,8 +518,8 @@ void SpCooMat<T>::_sort() noexcept {
     });
 
     auto new_val = std::vector<T>(this->_val.size());
-    auto new_row_ids = std::vector<size_t>(this->_val.size());
-    auto new_col_ids = std::vector<size_t>(this->_val.size());
+    auto new_row_ids = std::vector<I>(this->_val.size());
+    auto new_col_ids = std::vector<I>(this->_val.size());
     for (auto i = 0u; i < this->_val.size(); ++i) {
         new_val[i] = this->_val[ids[i]];
         new_row_ids[i] = this->_row_ids[ids[i]];
@@ -453,60 +535,104 @@ void SpCooMat<T>::_sort() noexcept {
 // === CSR Matrix === //
 // === Implementations === //
 
-inline void _convert_coo_crs(std::vector<size_t>& row_ptr, const std::vector<size_t>& row_ids) {
+template<std::unsigned_integral I>
+inline void _convert_coo_crs(std::vector<I>& row_ptr, const std::vector<I>& row_ids, size_t nrow) {
     size_t nnz = row_ids.size();
+    _check_index_range<I>(nnz);
 
-    row_ptr.reserve(nnz);
-    if (!row_ptr.empty()) {
-        row_ptr.clear();
-    }
-
+    row_ptr.clear();
+    row_ptr.reserve(nrow + 1);
     row_ptr.emplace_back(0);
 
+    // Trailing empty rows are padded with `nnz`
     auto it = row_ids.begin();
-    for (size_t i = 0; it < row_ids.end(); ++i) {
-        it = std::upper_bound(it, row_ids.end(), i, std::less<size_t>{});
+    for (size_t i = 0; i < nrow; ++i) {
+        it = std::upper_bound(it, row_ids.end(), i, std::less<>{});
         row_ptr.emplace_back(std::distance(row_ids.begin(), it));
     }
 }
 
-template<typename T>
-SpMat<T>::SpMat(const SpCooMat<T>& mat) noexcept
-    : _val(mat.values()), _row_ptr(), _col_ids(mat.col_indices())
+/// @brief Splits rows into `nparts` contiguous chunks with nearly equal number of non-zero elements.
+template<std::unsigned_integral I>
+inline void _partition_rows_by_nnz(std::vector<size_t>& part, const std::vector<I>& row_ptr, size_t nparts) {
+    auto n = row_ptr.size() - 1;
+    size_t nnz = row_ptr.back();
+
+    part.resize(nparts + 1);
+    part[0] = 0;
+    for (auto p = 1u; p < nparts; ++p) {
+        // First row whose starting offset reaches the p-th share of the non-zero elements
+        auto target = (nnz * p) / nparts;
+        auto it = std::lower_bound(row_ptr.begin() + part[p - 1], row_ptr.end() - 1, target);
+        part[p] = static_cast<size_t>(std::distance(row_ptr.begin(), it));
+    }
+    part[nparts] = n;
+}
+
+/// @brief Returns the partition of the rows for the threads of a parallel region.
+template<std::unsigned_integral I>
+inline auto _thread_row_partition(const std::vector<I>& row_ptr) -> std::vector<size_t> {
+    auto part = std::vector<size_t>();
+    if (row_ptr.empty()) {
+        return part;
+    }
+    #ifdef _OPENMP
+    _partition_rows_by_nnz(part, row_ptr, static_cast<size_t>(omp_get_max_threads()));
+    #else
+    _partition_rows_by_nnz(part, row_ptr, 1);
+    #endif
+    return part;
+}
+
+template<typename T, std::unsigned_integral I>
+SpMat<T, I>::SpMat(const SpCooMat<T, I>& mat)
+    : _ncol(mat.shape().second), _val(mat.values()), _row_ptr(), _col_ids(mat.col_indices())
 {
-    _convert_coo_crs(this->_row_ptr, mat.row_indices());
+    _convert_coo_crs(this->_row_ptr, mat.row_indices(), mat.shape().first);
+    this->_row_part = _thread_row_partition(this->_row_ptr);
 }
 
-template<typename T>
-SpMat<T>::SpMat(SpCooMat<T>&& mat) noexcept
-    : _val(std::move(mat.values())), _row_ptr(), _col_ids(std::move(mat.col_indices()))
+template<typename T, std::unsigned_integral I>
+SpMat<T, I>::SpMat(SpCooMat<T, I>&& mat)
+    : _ncol(mat.shape().second), _val(std::move(mat.values())), _row_ptr(), _col_ids(std::move(mat.col_indices()))
 {
-    _convert_coo_crs(this->_row_ptr, mat.row_indices());
+    _convert_coo_crs(this->_row_ptr, mat.row_indices(), mat.shape().first);
+    this->_row_part = _thread_row_partition(this->_row_ptr);
 }
 
-template<typename T>
-SpMat<T>::SpMat(const std::vector<T>& val, const std::vector<size_t>& row_ptr, const std::vector<size_t>& col_ids)
-    : _val(val), _row_ptr(row_ptr), _col_ids(col_ids) 
+template<typename T, std::unsigned_integral I>
+SpMat<T, I>::SpMat(const std::vector<T>& val, const std::vector<I>& row_ptr, const std::vector<I>& col_ids, size_t ncol)
+    : _ncol(_index_extent(col_ids, ncol)), _val(val), _row_ptr(row_ptr), _col_ids(col_ids) 
 {
     if (this->_val.size() != this->_col_ids.size()) {
         throw std::runtime_error("The size of the vectors must be the same.");
     }
+    this->_row_part = _thread_row_partition(this->_row_ptr);
 }
 
-template<typename T>
-SpMat<T>::SpMat(std::vector<T>&& val, std::vector<size_t>&& row_ptr, std::vector<size_t>&& col_ids)
-    : _val(std::move(val)), _row_ptr(std::move(row_ptr)), _col_ids(std::move(col_ids))
+template<typename T, std::unsigned_integral I>
+SpMat<T, I>::SpMat(std::vector<T>&& val, std::vector<I>&& row_ptr, std::vector<I>&& col_ids, size_t ncol)
+    : _ncol(_index_extent(col_ids, ncol)), _val(std::move(val)), _row_ptr(std::move(row_ptr)), _col_ids(std::move(col_ids))
 {
     if (this->_val.size() != this->_col_ids.size()) {
         throw std::runtime_error("The size of the vectors must be the same.");
     }
+    this->_row_part = _thread_row_partition(this->_row_ptr);
 }
 
-template<typename T>
-auto SpMat<T>::unit(size_t n) -> SpMat<T> {
+template<typename T, std::unsigned_integral I>
+template<std::unsigned_integral J>
+SpMat<T, I>::SpMat(const SpMat<T, J>& mat)
+    : _ncol(mat.shape().second), _val(mat.values()), _row_ptr(_convert_indices<I>(mat.row_ptr())), _col_ids(_convert_indices<I>(mat.col_indices())), 
+      _row_part(mat.thread_row_partition())
+{}
+
+template<typename T, std::unsigned_integral I>
+auto SpMat<T, I>::unit(size_t n) -> SpMat<T, I> {
+    _check_index_range<I>(n);
     std::vector<T> val(n, One<T>::value());
-    std::vector<size_t> row_ptr(n + 1);
-    std::vector<size_t> col_ids(n);
+    std::vector<I> row_ptr(n + 1);
+    std::vector<I> col_ids(n);
 
     for (auto i: std::views::iota(0u, n)) {
         row_ptr[i] = i;
@@ -514,25 +640,23 @@ auto SpMat<T>::unit(size_t n) -> SpMat<T> {
     }
     row_ptr[n] = n;
 
-    return SpMat<T>(val, row_ptr, col_ids);
+    return SpMat<T, I>(val, row_ptr, col_ids, n);
 }
 
 
-template<typename T>
-constexpr auto SpMat<T>::shape() const noexcept -> std::pair<size_t, size_t> {
-    size_t nrow = this->_row_ptr.size() - 1;
-    size_t ncol = *std::ranges::max_element(this->_col_ids) + 1;
-
-    return std::make_pair(nrow, ncol);
+template<typename T, std::unsigned_integral I>
+constexpr auto SpMat<T, I>::shape() const noexcept -> std::pair<size_t, size_t> {
+    size_t nrow = this->_row_ptr.empty() ? 0 : this->_row_ptr.size() - 1;
+    return std::make_pair(nrow, this->_ncol);
 }
 
-template<typename T>
-constexpr auto SpMat<T>::nnz() const noexcept -> size_t {
+template<typename T, std::unsigned_integral I>
+constexpr auto SpMat<T, I>::nnz() const noexcept -> size_t {
     return this->_val.size();
 }
 
-template<typename T>
-auto SpMat<T>::operator()(size_t i, size_t j) const noexcept -> const T& {
+template<typename T, std::unsigned_integral I>
+auto SpMat<T, I>::operator()(size_t i, size_t j) const noexcept -> const T& {
     for (auto cnt: std::views::iota(this->_row_ptr[i], this->_row_ptr[i + 1])) {
         if (this->_col_ids[cnt] == j) {
             return this->_val[cnt];
@@ -541,13 +665,13 @@ auto SpMat<T>::operator()(size_t i, size_t j) const noexcept -> const T& {
     return this->_zero;
 }
 
-template<typename T>
-auto SpMat<T>::at(size_t i, size_t j) const noexcept -> const T& {
+template<typename T, std::unsigned_integral I>
+auto SpMat<T, I>::at(size_t i, size_t j) const noexcept -> const T& {
     return (*this)(i, j);
 }
 
-template<typename T>
-auto SpMat<T>::mut_at(size_t i, size_t j) -> T& {
+template<typename T, std::unsigned_integral I>
+auto SpMat<T, I>::mut_at(size_t i, size_t j) -> T& {
     for (auto cnt: std::views::iota(this->_row_ptr[i], this->_row_ptr[i + 1])) {
         if (this->_col_ids[cnt] == j) {
             return this->_val[cnt];
@@ -556,20 +680,35 @@ auto SpMat<T>::mut_at(size_t i, size_t j) -> T& {
     throw std::out_of_range("Index out of range or does not point to a non-zero element.");
 }
 
-template<typename T>
-constexpr auto SpMat<T>::operator=(const SpMat<T>& mat) noexcept -> SpMat<T>& {
+template<typename T, std::unsigned_integral I>
+auto SpMat<T, I>::row_partition(size_t nparts) const -> std::vector<size_t> {
+    nparts = std::max<size_t>(nparts, 1u);
+    if (this->_row_ptr.empty()) {
+        return std::vector<size_t>(nparts + 1, 0);
+    }
+    auto part = std::vector<size_t>();
+    _partition_rows_by_nnz(part, this->_row_ptr, nparts);
+    return part;
+}
+
+template<typename T, std::unsigned_integral I>
+constexpr auto SpMat<T, I>::operator=(const SpMat<T, I>& mat) noexcept -> SpMat<T, I>& {
+    this->_ncol = mat._ncol;
     this->_val = mat._val;
     this->_row_ptr = mat._row_ptr;
     this->_col_ids = mat._col_ids;
+    this->_row_part = mat._row_part;
 
     return *this;
 }
 
-template<typename T>
-constexpr auto SpMat<T>::operator=(SpMat<T>&& mat) noexcept -> SpMat<T>& {
+template<typename T, std::unsigned_integral I>
+constexpr auto SpMat<T, I>::operator=(SpMat<T, I>&& mat) noexcept -> SpMat<T, I>& {
+    this->_ncol = mat._ncol;
     this->_val = std::move(mat._val);
     this->_row_ptr = std::move(mat._row_ptr);
     this->_col_ids = std::move(mat._col_ids);
+    this->_row_part = std::move(mat._row_part);
 
     return *this;
 }
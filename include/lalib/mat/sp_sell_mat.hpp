@@ -0,0 +1,285 @@
+#ifndef LALIB_MAT_SPARSE_SELL_MAT_HPP
+#define LALIB_MAT_SPARSE_SELL_MAT_HPP
+
+#include "lalib/ops/ops_traits.hpp"
+#include "lalib/mat/sp_mat.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace lalib {
+
+/// @brief  Sparse matrix in sliced ELLPACK (SELL-C-sigma) format
+/// @details    Rows are sorted by their number of non-zero elements within windows of `sigma` rows, and then
+///             grouped into slices of `C` consecutive rows. Each slice is padded to its longest row and stored
+///             column-major, so that the matrix-vector product can process `C` rows at once with SIMD lanes.
+/// @tparam T   an element type
+/// @tparam C   the number of rows in a slice (the chunk height). should match the SIMD width of `T`.
+/// @tparam I   an unsigned integer type of the column indices
+template<typename T, size_t C = 8, std::unsigned_integral I = size_t>
+struct SpSellMat {
+    using ElemType = T;
+    using IndexType = I;
+    static constexpr size_t ChunkSize = C;
+
+    // ==== Initializations ==== //
+
+    /// @brief Create an empty sparse matrix object.
+    SpSellMat() noexcept = default;
+
+    /// @brief Create a sparse matrix from a CSR matrix.
+    /// @param mat      a CSR matrix
+    /// @param sigma    the size of the window in which rows are sorted by their length. `sigma <= 1` disables sorting.
+    SpSellMat(const SpMat<T, I>& mat, size_t sigma = 8 * C);
+
+    /// @brief Create a sparse matrix from a COO matrix.
+    /// @param mat      a COO matrix
+    /// @param sigma    the size of the window in which rows are sorted by their length. `sigma <= 1` disables sorting.
+    SpSellMat(const SpCooMat<T, I>& mat, size_t sigma = 8 * C);
+
+    /// @brief Copy constructor
+    SpSellMat(const SpSellMat<T, C, I>& mat) = default;
+
+    /// @brief Move constructor
+    SpSellMat(SpSellMat<T, C, I>&& mat) noexcept = default;
+
+
+    // === Inspecting === //
+
+    /// @brief Returns the shape of the matrix (row, column).
+    /// @return     a pair of size_t representing the shape of the matrix.
+    auto shape() const noexcept -> std::pair<size_t, size_t>
+        { return std::make_pair(this->_nrow, this->_ncol); }
+
+    /// @brief Returns the number of non-zero elements in the matrix (excluding padding).
+    /// @return     the number of non-zero elements.
+    auto nnz() const noexcept -> size_t
+        { return this->_nnz; }
+
+    /// @brief Returns the number of the stored elements including padding.
+    /// @return     the number of the stored elements.
+    auto padded_size() const noexcept -> size_t
+        { return this->_val.size(); }
+
+    /// @brief Returns the number of slices.
+    auto nslices() const noexcept -> size_t
+        { return this->_slice_len.size(); }
+
+    /// @brief Returns the value of the element at the given position.
+    /// @param i    row index
+    /// @param j    column index
+    /// @return     the value of the element at the given position.
+    auto operator()(size_t i, size_t j) const noexcept -> const T&;
+
+    /// @brief Returns the value of the element at the given position.
+    /// @param i    row index
+    /// @param j    column index
+    /// @return     the value of the element at the given position.
+    auto at(size_t i, size_t j) const noexcept -> const T&;
+
+    /// @brief Gets a mutable reference to the element at the given position.
+    /// @param i    row index
+    /// @param j    column index
+    /// @return     a mutable reference to the element at the given position.
+    /// @throw      `std::out_of_range` if the index is out of range or does not point to a non-zero element
+    auto mut_at(size_t i, size_t j) -> T&;
+
+
+    // === Assignment === //
+
+    /// @brief Replaces the elements of the matrix.
+    auto operator=(const SpSellMat<T, C, I>& mat) -> SpSellMat<T, C, I>&;
+
+    /// @brief Replaces the elements of the matrix.
+    auto operator=(SpSellMat<T, C, I>&& mat) noexcept -> SpSellMat<T, C, I>&;
+
+
+    // === Accessing === //
+
+    /// @brief Returns a reference to the array of the values (slice-wise column-major, with padding).
+    auto values() const noexcept -> const std::vector<T>&
+        { return this->_val; }
+
+    /// @brief Returns a reference to the array of the column indices (slice-wise column-major, with padding).
+    auto col_indices() const noexcept -> const std::vector<I>&
+        { return this->_col_ids; }
+
+    /// @brief Returns a reference to the array of the offsets of each slice.
+    auto slice_ptr() const noexcept -> const std::vector<size_t>&
+        { return this->_slice_ptr; }
+
+    /// @brief Returns a reference to the array of the width of each slice.
+    auto slice_len() const noexcept -> const std::vector<size_t>&
+        { return this->_slice_len; }
+
+    /// @brief Returns a reference to the array of the number of non-zero elements of each stored row.
+    auto row_len() const noexcept -> const std::vector<size_t>&
+        { return this->_row_len; }
+
+    /// @brief Returns a reference to the row permutation. the `k`-th stored row is the `perm[k]`-th row of the matrix.
+    auto permutation() const noexcept -> const std::vector<size_t>&
+        { return this->_perm; }
+
+private:
+    size_t _nrow = 0;
+    size_t _ncol = 0;
+    size_t _nnz = 0;
+
+    std::vector<T> _val;
+    std::vector<I> _col_ids;
+    std::vector<size_t> _slice_ptr;
+    std::vector<size_t> _slice_len;
+
+    std::vector<size_t> _perm;
+    std::vector<size_t> _inv_perm;
+    std::vector<size_t> _row_len;
+
+    const T _zero = Zero<T>::value();
+
+    auto _find(size_t i, size_t j) const noexcept -> size_t;
+};
+
+
+// === Implementations === //
+
+template<typename T, size_t C, std::unsigned_integral I>
+SpSellMat<T, C, I>::SpSellMat(const SpMat<T, I>& mat, size_t sigma):
+    _nrow(mat.shape().first), _ncol(mat.shape().second), _nnz(mat.nnz())
+{
+    const auto& row_ptr = mat.row_ptr();
+    const auto& col_ids = mat.col_indices();
+    const auto& val = mat.values();
+    auto n = this->_nrow;
+
+    // Sort rows by their length in descending order within each sigma-window
+    this->_perm.resize(n);
+    std::iota(this->_perm.begin(), this->_perm.end(), 0u);
+    auto row_len = [&](size_t i) { return row_ptr[i + 1] - row_ptr[i]; };
+    if (sigma > 1) {
+        for (auto begin = 0u; begin < n; begin += sigma) {
+            auto end = std::min(begin + sigma, n);
+            std::stable_sort(this->_perm.begin() + begin, this->_perm.begin() + end, [&](size_t a, size_t b) {
+                return row_len(a) > row_len(b);
+            });
+        }
+    }
+    this->_inv_perm.resize(n);
+    this->_row_len.resize(n);
+    for (auto k = 0u; k < n; ++k) {
+        this->_inv_perm[this->_perm[k]] = k;
+        this->_row_len[k] = row_len(this->_perm[k]);
+    }
+
+    // Compute the width and the offset of each slice
+    auto nslices = (n + C - 1) / C;
+    this->_slice_len.resize(nslices);
+    this->_slice_ptr.resize(nslices + 1);
+    this->_slice_ptr[0] = 0;
+    for (auto s = 0u; s < nslices; ++s) {
+        auto end = std::min((s + 1) * C, n);
+        auto width = size_t(0);
+        for (auto k = s * C; k < end; ++k) {
+            width = std::max(width, this->_row_len[k]);
+        }
+        this->_slice_len[s] = width;
+        this->_slice_ptr[s + 1] = this->_slice_ptr[s] + width * C;
+    }
+
+    // Fill the slices. Padding refers to a valid column (the last one of the row, or 0 for an empty row), so that the
+    // product can load `x` unconditionally. The product masks the padding out by the length of each row.
+    this->_val.assign(this->_slice_ptr.back(), Zero<T>::value());
+    this->_col_ids.assign(this->_slice_ptr.back(), 0u);
+    for (auto k = 0u; k < n; ++k) {
+        auto s = k / C;
+        auto r = k % C;
+        auto i = this->_perm[k];
+        auto offset = this->_slice_ptr[s] + r;
+        auto pad_col = row_ptr[i] < row_ptr[i + 1] ? col_ids[row_ptr[i + 1] - 1] : 0u;
+        for (auto j = 0u; j < this->_slice_len[s]; ++j) {
+            if (j < this->_row_len[k]) {
+                this->_val[offset + j * C] = val[row_ptr[i] + j];
+                this->_col_ids[offset + j * C] = col_ids[row_ptr[i] + j];
+            } else {
+                this->_col_ids[offset + j * C] = pad_col;
+            }
+        }
+    }
+}
+
+template<typename T, size_t C, std::unsigned_integral I>
+SpSellMat<T, C, I>::SpSellMat(const SpCooMat<T, I>& mat, size_t sigma):
+    SpSellMat(SpMat<T, I>(mat), sigma)
+{}
+
+template<typename T, size_t C, std::unsigned_integral I>
+auto SpSellMat<T, C, I>::_find(size_t i, size_t j) const noexcept -> size_t {
+    auto k = this->_inv_perm[i];
+    auto offset = this->_slice_ptr[k / C] + k % C;
+    for (auto l = 0u; l < this->_row_len[k]; ++l) {
+        if (this->_col_ids[offset + l * C] == j) {
+            return offset + l * C;
+        }
+    }
+    return this->_val.size();
+}
+
+template<typename T, size_t C, std::unsigned_integral I>
+auto SpSellMat<T, C, I>::operator()(size_t i, size_t j) const noexcept -> const T& {
+    auto id = this->_find(i, j);
+    return id < this->_val.size() ? this->_val[id] : this->_zero;
+}
+
+template<typename T, size_t C, std::unsigned_integral I>
+auto SpSellMat<T, C, I>::at(size_t i, size_t j) const noexcept -> const T& {
+    return (*this)(i, j);
+}
+
+template<typename T, size_t C, std::unsigned_integral I>
+auto SpSellMat<T, C, I>::mut_at(size_t i, size_t j) -> T& {
+    if (i >= this->_nrow) {
+        throw std::out_of_range("Index out of range or does not point to a non-zero element.");
+    }
+    auto id = this->_find(i, j);
+    if (id >= this->_val.size()) {
+        throw std::out_of_range("Index out of range or does not point to a non-zero element.");
+    }
+    return this->_val[id];
+}
+
+template<typename T, size_t C, std::unsigned_integral I>
+auto SpSellMat<T, C, I>::operator=(const SpSellMat<T, C, I>& mat) -> SpSellMat<T, C, I>& {
+    this->_nrow = mat._nrow;
+    this->_ncol = mat._ncol;
+    this->_nnz = mat._nnz;
+    this->_val = mat._val;
+    this->_col_ids = mat._col_ids;
+    this->_slice_ptr = mat._slice_ptr;
+    this->_slice_len = mat._slice_len;
+    this->_perm = mat._perm;
+    this->_inv_perm = mat._inv_perm;
+    this->_row_len = mat._row_len;
+
+    return *this;
+}
+
+template<typename T, size_t C, std::unsigned_integral I>
+auto SpSellMat<T, C, I>::operator=(SpSellMat<T, C, I>&& mat) noexcept -> SpSellMat<T, C, I>& {
+    this->_nrow = mat._nrow;
+    this->_ncol = mat._ncol;
+    this->_nnz = mat._nnz;
+    this->_val = std::move(mat._val);
+    this->_col_ids = std::move(mat._col_ids);
+    this->_slice_ptr = std::move(mat._slice_ptr);
+    this->_slice_len = std::move(mat._slice_len);
+    this->_perm = std::move(mat._perm);
+    this->_inv_perm = std::move(mat._inv_perm);
+    this->_row_len = std::move(mat._row_len);
+
+    return *this;
+}
+
+}
+#endif
@@ -0,0 +1,112 @@
+#pragma once
+#ifndef LALIB_OPS_AUTOTUNE_HPP
+#define LALIB_OPS_AUTOTUNE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "dispatch.hpp"
+#include "vec_ops_core.hpp"
+
+namespace lalib {
+
+/// @brief  Returns the best time of `f()` in seconds, repeating it so that each trial touches about 2^20 elements.
+template<typename F>
+inline auto _time_kernel(size_t size, F f) -> double {
+    auto reps = std::max<size_t>(1, (size_t(1) << 20) / std::max<size_t>(size, 1));
+    auto best = std::numeric_limits<double>::infinity();
+    for (auto trial = 0; trial < 3; ++trial) {
+        auto start = std::chrono::steady_clock::now();
+        for (auto r = size_t(0); r < reps; ++r) { f(); }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, elapsed / static_cast<double>(reps));
+    }
+    return best;
+}
+
+/// @brief  Measures the serial and the parallel kernels for the sizes `2^8, 2^9, ..., max_size`.
+/// @return the smallest measured size from which the parallel kernel is always faster, or `NeverParallel`
+template<typename S, typename P>
+inline auto _tune_threshold(size_t max_size, S serial, P parallel) -> size_t {
+    auto threshold = NeverParallel;
+    auto sizes = std::vector<size_t>();
+    for (auto n = size_t(1) << 8; n <= max_size; n *= 2) { sizes.emplace_back(n); }
+    for (auto it = sizes.rbegin(); it != sizes.rend(); ++it) {
+        auto n = *it;
+        if (_time_kernel(n, [&] { parallel(n); }) >= _time_kernel(n, [&] { serial(n); })) { break; }
+        threshold = n;
+    }
+    return threshold;
+}
+
+template<typename T>
+inline void _autotune_thresholds_of(size_t max_size) {
+    // Small values keep the repeated updates and the sums of the squares finite
+    auto x = std::vector<T>(max_size, T(0.5));
+    auto y = std::vector<T>(max_size, T(0.25));
+    auto z = std::vector<T>(max_size);
+    auto extra = std::vector<std::vector<T>>(4, std::vector<T>(max_size, T(0.125)));
+    const T* ptrs[4] = { extra[0].data(), extra[1].data(), extra[2].data(), extra[3].data() };
+    const T coefs[4] = { T(0), T(0), T(0), T(0) };
+    T r[4];
+    volatile double sink = 0.0;
+    auto consume = [&](T v) { sink = static_cast<double>(std::real(v)); };
+
+    auto tune = [&](Kernel kernel, auto serial, auto parallel) {
+        set_parallel_threshold<T>(kernel, _tune_threshold(max_size, serial, parallel));
+    };
+
+    tune(Kernel::Neg,
+        [&](size_t n) { __neg_core_simd(x.data(), z.data(), n); },
+        [&](size_t n) { __neg_core_parallel(x.data(), z.data(), n); });
+    tune(Kernel::Add,
+        [&](size_t n) { __add_core_simd(x.data(), y.data(), z.data(), n); },
+        [&](size_t n) { __add_core_parallel(x.data(), y.data(), z.data(), n); });
+    tune(Kernel::Sub,
+        [&](size_t n) { __sub_core_simd(x.data(), y.data(), z.data(), n); },
+        [&](size_t n) { __sub_core_parallel(x.data(), y.data(), z.data(), n); });
+    tune(Kernel::Axpy,
+        [&](size_t n) { __axpy_core_simd(T(0), x.data(), z.data(), n); },
+        [&](size_t n) { __axpy_core_parallel(T(0), x.data(), z.data(), n); });
+    tune(Kernel::Scal,
+        [&](size_t n) { __scal_core_simd(T(1), z.data(), n); },
+        [&](size_t n) { __scal_core_parallel(T(1), z.data(), n); });
+    tune(Kernel::Dot,
+        [&](size_t n) { consume(__dot_core_simd(x.data(), y.data(), n)); },
+        [&](size_t n) { consume(__dot_core_parallel(x.data(), y.data(), n)); });
+    tune(Kernel::Norm2,
+        [&](size_t n) { consume(__norm2_core_simd(x.data(), n)); },
+        [&](size_t n) { consume(__norm2_core_parallel(x.data(), n)); });
+    // The parallel fused dot products support real numbers only
+    if constexpr (std::is_arithmetic_v<T>) {
+        tune(Kernel::MultiDot,
+            [&](size_t n) { __mdot_core_simd(x.data(), ptrs, 4, n, r); consume(r[0]); },
+            [&](size_t n) { __mdot_core_parallel(x.data(), ptrs, 4, n, r); consume(r[0]); });
+    }
+    tune(Kernel::MultiAxpy,
+        [&](size_t n) { __maxpy_core_simd(coefs, ptrs, 4, z.data(), n); },
+        [&](size_t n) { __maxpy_core_parallel(coefs, ptrs, 4, z.data(), n); });
+}
+
+/// @brief  Measures the thresholds of the vector kernels on this machine and sets them.
+/// @details    For each kernel and each of `float`, `double`, `std::complex<float>` and `std::complex<double>`,
+///             the serial and the parallel implementations are timed on vectors of `2^8` to `max_size` elements, and
+///             the threshold is set to the smallest size from which the parallel one is always faster (`NeverParallel`
+///             if it never is). The matrix kernels keep their thresholds. It takes a few seconds with the default
+///             `max_size`, so call it once at startup, or run the tuning tool and keep the result with `save_thresholds`.
+///             Nothing is measured if the calling thread cannot start a parallel region.
+/// @param max_size the largest number of elements to measure
+inline void autotune_thresholds(size_t max_size = size_t(1) << 22) {
+    if (!_parallel_allowed()) { return; }
+    _autotune_thresholds_of<float>(max_size);
+    _autotune_thresholds_of<double>(max_size);
+    _autotune_thresholds_of<std::complex<float>>(max_size);
+    _autotune_thresholds_of<std::complex<double>>(max_size);
+}
+
+}
+#endif
@@ -0,0 +1,314 @@
+#pragma once
+#ifndef LALIB_OPS_DISPATCH_HPP
+#define LALIB_OPS_DISPATCH_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <complex>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace lalib {
+
+// === Kernels === //
+
+/// @brief  Kernels which choose between their serial and parallel implementations by the size of the operands
+enum class Kernel {
+    /// `vr <- -v`
+    Neg,
+    /// `vr <- v1 + v2`
+    Add,
+    /// `vr <- v1 - v2`
+    Sub,
+    /// `vy <- alpha * vx + vy`
+    Axpy,
+    /// `v <- alpha * v`
+    Scal,
+    /// the dot product
+    Dot,
+    /// the Euclidean norm
+    Norm2,
+    /// the fused dot products of a vector with several vectors
+    MultiDot,
+    /// the fused axpy operations on a vector
+    MultiAxpy,
+    /// the dense matrix-vector product. the size is the number of the elements of the matrix.
+    MatVec,
+    /// the sparse matrix-vector product. the size is the number of the stored elements of the matrix.
+    SpMatVec,
+    /// the dense matrix-matrix product. the size is the number of the multiply-adds, `n * m * l`.
+    MatMul,
+};
+
+/// @brief  The number of the kernels in `Kernel`
+constexpr size_t KernelCount = static_cast<size_t>(Kernel::MatMul) + 1;
+
+/// @brief  The element types whose thresholds are kept separately. The other types share the last entry.
+constexpr size_t _DISPATCH_TYPE_COUNT = 5;
+
+/// @brief  The default minimum number of elements for which the kernels run in parallel
+constexpr size_t _DEFAULT_PARALLEL_THRESHOLD = 1u << 15;
+
+/// @brief  Returns the built-in threshold of a kernel. The matrix-matrix product counts multiply-adds, not elements.
+constexpr auto _default_parallel_threshold(Kernel kernel) noexcept -> size_t {
+    return kernel == Kernel::MatMul ? size_t(1) << 18 : _DEFAULT_PARALLEL_THRESHOLD;
+}
+
+/// @brief  The threshold meaning that a kernel never runs in parallel
+constexpr size_t NeverParallel = SIZE_MAX;
+
+template<typename T>
+constexpr auto _dispatch_type_id() noexcept -> size_t {
+    if constexpr (std::is_same_v<T, float>) { return 0; }
+    else if constexpr (std::is_same_v<T, double>) { return 1; }
+    else if constexpr (std::is_same_v<T, std::complex<float>>) { return 2; }
+    else if constexpr (std::is_same_v<T, std::complex<double>>) { return 3; }
+    else { return 4; }
+}
+
+constexpr const char* _KERNEL_NAMES[KernelCount] = {
+    "neg", "add", "sub", "axpy", "scal", "dot", "norm2", "mdot", "maxpy", "gemv", "spmv", "gemm"
+};
+
+constexpr const char* _DISPATCH_TYPE_NAMES[_DISPATCH_TYPE_COUNT] = {
+    "float", "double", "cfloat", "cdouble", "other"
+};
+
+
+// === Threshold table === //
+
+/// @brief  The thresholds of all the kernels and the element types. They may be changed while kernels are running.
+struct _ThresholdTable {
+    std::array<std::atomic<size_t>, KernelCount * _DISPATCH_TYPE_COUNT> values;
+
+    _ThresholdTable() noexcept {
+        this->reset();
+    }
+
+    void reset() noexcept {
+        for (auto k = size_t(0); k < KernelCount; ++k) {
+            for (auto t = size_t(0); t < _DISPATCH_TYPE_COUNT; ++t) {
+                this->at(static_cast<Kernel>(k), t).store(_default_parallel_threshold(static_cast<Kernel>(k)), std::memory_order_relaxed);
+            }
+        }
+    }
+
+    auto at(Kernel kernel, size_t type) noexcept -> std::atomic<size_t>& {
+        return this->values[static_cast<size_t>(kernel) * _DISPATCH_TYPE_COUNT + type];
+    }
+};
+
+/// @brief  Applies one `key=value` entry to the table.
+/// @details    `key` is `<kernel>` or `<kernel>.<type>` (e.g. `add.double`); the former sets all the types.
+///             `value` is a number of elements or `never`.
+/// @return     whether the entry is valid
+inline auto _apply_threshold_entry(_ThresholdTable& table, std::string entry) -> bool {
+    auto trim = [](std::string& s) {
+        auto begin = s.find_first_not_of(" \t\r\n");
+        auto end = s.find_last_not_of(" \t\r\n");
+        s = begin == std::string::npos ? std::string() : s.substr(begin, end - begin + 1);
+    };
+    trim(entry);
+    auto eq = entry.find('=');
+    if (eq == std::string::npos) { return false; }
+    auto key = entry.substr(0, eq);
+    auto val = entry.substr(eq + 1);
+    trim(key);
+    trim(val);
+
+    auto dot = key.find('.');
+    auto kernel_name = key.substr(0, dot);
+    auto type_name = dot == std::string::npos ? std::string() : key.substr(dot + 1);
+
+    auto kernel = KernelCount;
+    for (auto k = size_t(0); k < KernelCount; ++k) {
+        if (kernel_name == _KERNEL_NAMES[k]) { kernel = k; }
+    }
+    auto type = type_name.empty() ? _DISPATCH_TYPE_COUNT : _DISPATCH_TYPE_COUNT + 1;
+    for (auto t = size_t(0); t < _DISPATCH_TYPE_COUNT; ++t) {
+        if (type_name == _DISPATCH_TYPE_NAMES[t]) { type = t; }
+    }
+    if (kernel == KernelCount || type > _DISPATCH_TYPE_COUNT) { return false; }
+
+    auto threshold = NeverParallel;
+    if (val != "never") {
+        if (val.empty() || val.find_first_not_of("0123456789") != std::string::npos) { return false; }
+        try {
+            threshold = static_cast<size_t>(std::stoull(val));
+        } catch (const std::out_of_range&) {
+            return false;
+        }
+    }
+
+    for (auto t = size_t(0); t < _DISPATCH_TYPE_COUNT; ++t) {
+        if (type == _DISPATCH_TYPE_COUNT || type == t) {
+            table.at(static_cast<Kernel>(kernel), t).store(threshold, std::memory_order_relaxed);
+        }
+    }
+    return true;
+}
+
+/// @brief  Applies the entries separated by newlines or commas. Empty entries and `#` comments are skipped.
+/// @return the number of the invalid entries, which are ignored
+inline auto _apply_threshold_entries(_ThresholdTable& table, std::istream& is) -> size_t {
+    auto invalid = size_t(0);
+    auto line = std::string();
+    while (std::getline(is, line)) {
+        line = line.substr(0, line.find('#'));
+        auto entries = std::istringstream(line);
+        auto entry = std::string();
+        while (std::getline(entries, entry, ',')) {
+            if (entry.find_first_not_of(" \t\r") == std::string::npos) { continue; }
+            if (!_apply_threshold_entry(table, entry)) { ++invalid; }
+        }
+    }
+    return invalid;
+}
+
+/// @brief  Returns the table of the thresholds.
+/// @details    On the first call, the defaults are overridden by the file named by the environment variable
+///             `LALIB_THRESHOLDS_FILE`, and then by the entries in `LALIB_THRESHOLDS` (e.g. `add=65536,dot.float=never`).
+///             Invalid entries in them are ignored.
+inline auto _threshold_table() -> _ThresholdTable& {
+    static auto table = _ThresholdTable();
+    // Nothing is allocated unless the environment variables are set, so that the kernels stay allocation-free
+    static const auto loaded = [] {
+        if (const auto* path = std::getenv("LALIB_THRESHOLDS_FILE"); path && *path) {
+            auto ifs = std::ifstream(path);
+            if (ifs) { _apply_threshold_entries(table, ifs); }
+        }
+        if (const auto* entries = std::getenv("LALIB_THRESHOLDS"); entries && *entries) {
+            auto iss = std::istringstream(entries);
+            _apply_threshold_entries(table, iss);
+        }
+        return true;
+    }();
+    (void)loaded;
+    return table;
+}
+
+
+// === Public API === //
+
+/// @brief  Returns the minimum number of elements for which a kernel runs in parallel.
+/// @tparam T   an element type
+/// @param kernel   a kernel
+/// @return     the threshold, or `NeverParallel`
+template<typename T>
+inline auto parallel_threshold(Kernel kernel) -> size_t {
+    return _threshold_table().at(kernel, _dispatch_type_id<T>()).load(std::memory_order_relaxed);
+}
+
+/// @brief  Sets the minimum number of elements for which a kernel runs in parallel.
+/// @tparam T   an element type
+/// @param kernel   a kernel
+/// @param threshold    the number of elements. `NeverParallel` keeps the kernel serial.
+template<typename T>
+inline void set_parallel_threshold(Kernel kernel, size_t threshold) {
+    _threshold_table().at(kernel, _dispatch_type_id<T>()).store(threshold, std::memory_order_relaxed);
+}
+
+/// @brief  Sets the minimum number of elements for which a kernel runs in parallel, for all the element types.
+inline void set_parallel_threshold(Kernel kernel, size_t threshold) {
+    for (auto t = size_t(0); t < _DISPATCH_TYPE_COUNT; ++t) {
+        _threshold_table().at(kernel, t).store(threshold, std::memory_order_relaxed);
+    }
+}
+
+/// @brief  Resets all the thresholds to the built-in defaults, ignoring the environment variables.
+inline void reset_parallel_thresholds() {
+    _threshold_table().reset();
+}
+
+/// @brief  Loads thresholds from a stream of `<kernel>[.<type>]=<size|never>` entries.
+/// @details    The entries are separated by newlines or commas, and `#` starts a comment.
+///             The kernels are `neg`, `add`, `sub`, `axpy`, `scal`, `dot`, `norm2`, `mdot`, `maxpy`, `gemv`, `spmv` and `gemm`,
+///             and the types are `float`, `double`, `cfloat`, `cdouble` and `other`. Entries without a type set all the types.
+/// @throw  `std::runtime_error` if an entry is invalid. The valid entries are applied anyway.
+inline void load_thresholds(std::istream& is) {
+    if (auto invalid = _apply_threshold_entries(_threshold_table(), is); invalid > 0) {
+        throw std::runtime_error(std::to_string(invalid) + " invalid threshold entries.");
+    }
+}
+
+/// @brief  Loads thresholds from a file. See `load_thresholds(std::istream&)` for the format.
+/// @throw  `std::runtime_error` if the file cannot be opened or an entry is invalid
+inline void load_thresholds(const std::string& path) {
+    auto ifs = std::ifstream(path);
+    if (!ifs) {
+        throw std::runtime_error("Cannot open the threshold file: " + path);
+    }
+    load_thresholds(ifs);
+}
+
+/// @brief  Writes all the thresholds in the format `load_thresholds` reads, one entry per line.
+inline void save_thresholds(std::ostream& os) {
+    for (auto k = size_t(0); k < KernelCount; ++k) {
+        for (auto t = size_t(0); t < _DISPATCH_TYPE_COUNT; ++t) {
+            auto v = _threshold_table().at(static_cast<Kernel>(k), t).load(std::memory_order_relaxed);
+            os << _KERNEL_NAMES[k] << '.' << _DISPATCH_TYPE_NAMES[t] << '=';
+            if (v == NeverParallel) { os << "never"; } else { os << v; }
+            os << '\n';
+        }
+    }
+}
+
+/// @brief  Writes all the thresholds to a file.
+/// @throw  `std::runtime_error` if the file cannot be written
+inline void save_thresholds(const std::string& path) {
+    auto ofs = std::ofstream(path);
+    if (!ofs) {
+        throw std::runtime_error("Cannot write the threshold file: " + path);
+    }
+    save_thresholds(ofs);
+}
+
+
+// === Serial regions === //
+
+inline auto _serial_depth() noexcept -> int& {
+    thread_local int depth = 0;
+    return depth;
+}
+
+/// @brief  Forces the kernels called on the current thread to run serially while the object is alive.
+/// @details    Kernels called inside an OpenMP parallel region are always serial, so this is meant for callers
+///             which run their own threads, or which want to keep a large operation on one core.
+///             The regions may be nested.
+struct SerialRegion {
+    SerialRegion() noexcept { ++_serial_depth(); }
+    ~SerialRegion() noexcept { --_serial_depth(); }
+
+    SerialRegion(const SerialRegion&) = delete;
+    auto operator=(const SerialRegion&) -> SerialRegion& = delete;
+};
+
+/// @brief  Returns whether the kernels called on the current thread may start a parallel region.
+inline auto _parallel_allowed() noexcept -> bool {
+    #ifdef _OPENMP
+    return _serial_depth() == 0 && !omp_in_parallel() && omp_get_max_threads() > 1;
+    #else
+    return false;
+    #endif
+}
+
+/// @brief  Returns whether a kernel on `size` elements of `T` should run in parallel.
+template<typename T>
+inline auto _use_parallel(Kernel kernel, size_t size) noexcept -> bool {
+    return size >= parallel_threshold<T>(kernel) && _parallel_allowed();
+}
+
+}
+#endif
@@ -0,0 +1,110 @@
+#pragma once
+#ifndef LALIB_OPS_ISA_HPP
+#define LALIB_OPS_ISA_HPP
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+// Kernels are compiled for several instruction sets in one binary and chosen at runtime on x86-64 with GCC or Clang.
+// Defining `LALIB_NO_ISA_DISPATCH` keeps the baseline kernels only.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && !defined(LALIB_NO_ISA_DISPATCH)
+#define LALIB_ISA_DISPATCH
+#define LALIB_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define LALIB_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512vl,avx2,fma")))
+#include <immintrin.h>
+#endif
+
+namespace lalib {
+
+/// @brief  Instruction sets the kernels are compiled for
+enum class Isa {
+    /// the baseline of the build (SSE2 on x86-64)
+    Baseline = 0,
+    /// AVX2 and FMA
+    Avx2 = 1,
+    /// AVX-512 F, DQ and VL
+    Avx512 = 2,
+};
+
+/// @brief  Returns the most capable instruction set supported by the CPU and the OS.
+inline auto detected_isa() noexcept -> Isa {
+    #if defined(LALIB_ISA_DISPATCH)
+    static const auto isa = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl")) {
+            return Isa::Avx512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return Isa::Avx2;
+        }
+        return Isa::Baseline;
+    }();
+    return isa;
+    #else
+    return Isa::Baseline;
+    #endif
+}
+
+/// @brief  Parses the name of an instruction set (`baseline`, `sse2`, `avx2` or `avx512`).
+/// @return the instruction set, or `fallback` if the name is unknown
+inline auto _parse_isa(const char* name, Isa fallback) noexcept -> Isa {
+    if (name == nullptr) { return fallback; }
+    if (std::strcmp(name, "baseline") == 0 || std::strcmp(name, "sse2") == 0) { return Isa::Baseline; }
+    if (std::strcmp(name, "avx2") == 0) { return Isa::Avx2; }
+    if (std::strcmp(name, "avx512") == 0) { return Isa::Avx512; }
+    return fallback;
+}
+
+/// @brief  The instruction set in use. It is initialized with the detected one, limited by the environment variable `LALIB_ISA`.
+inline auto _active_isa() noexcept -> std::atomic<Isa>& {
+    static auto isa = std::atomic<Isa>([] {
+        auto detected = detected_isa();
+        auto requested = _parse_isa(std::getenv("LALIB_ISA"), detected);
+        return requested < detected ? requested : detected;
+    }());
+    return isa;
+}
+
+/// @brief  Returns the instruction set the kernels currently use.
+inline auto active_isa() noexcept -> Isa {
+    return _active_isa().load(std::memory_order_relaxed);
+}
+
+/// @brief  Selects the instruction set of the kernels, e.g. to compare them or to work around a slow unit.
+/// @param isa  the instruction set. it is limited to `detected_isa()`.
+/// @return     the instruction set actually selected
+inline auto set_isa(Isa isa) noexcept -> Isa {
+    auto detected = detected_isa();
+    auto selected = isa < detected ? isa : detected;
+    _active_isa().store(selected, std::memory_order_relaxed);
+    return selected;
+}
+
+}
+
+/// @brief  Defines `variant(args...)`, which calls `kernel(args...)` compiled for the active instruction set.
+/// @details    `variant##_avx2` and `variant##_avx512` inline the whole call tree of `kernel` under the target attributes,
+///             so that its `omp simd` loops are vectorized for them. Parallel regions inside `kernel` are outlined before
+///             inlining and keep the baseline instruction set.
+#if defined(LALIB_ISA_DISPATCH)
+#define LALIB_ISA_VARIANTS(variant, kernel) \
+    template<typename... Args> \
+    __attribute__((flatten)) LALIB_TARGET_AVX2 inline auto variant##_avx2(Args... args) { return kernel(args...); } \
+    template<typename... Args> \
+    __attribute__((flatten)) LALIB_TARGET_AVX512 inline auto variant##_avx512(Args... args) { return kernel(args...); } \
+    template<typename... Args> \
+    inline auto variant(Args... args) { \
+        switch (::lalib::active_isa()) { \
+            case ::lalib::Isa::Avx512: return variant##_avx512(args...); \
+            case ::lalib::Isa::Avx2: return variant##_avx2(args...); \
+            default: return kernel(args...); \
+        } \
+    }
+#else
+#define LALIB_ISA_VARIANTS(variant, kernel) \
+    template<typename... Args> \
+    inline auto variant(Args... args) { return kernel(args...); }
+#endif
+
+#endif
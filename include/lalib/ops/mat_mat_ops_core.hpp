@@ -1,7 +1,7 @@
 /**
  * @file mat_mat_ops_core.hpp
  * @author Kohei KONISHI 
- * @brief  This file defines the BLAS level 2 - equivalent APIs.
+ * @brief  This file defines the BLAS level 3 - equivalent APIs.
  * @version 0.1
  * @date 2024-01-15
  * 
@@ -13,9 +13,14 @@
 #ifndef LALIB_MAT_MAT_OPS_CORE_HPP
 #define LALIB_MAT_MAT_OPS_CORE_HPP
 
+#include <algorithm>
+#include <complex>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <type_traits>
+#include "dispatch.hpp"
+#include "isa.hpp"
 
 #ifdef LALIB_BLAS_BACKEND
 #include <cblas.h>
@@ -23,51 +28,572 @@
 
 namespace lalib {
 
+// ==== Small products ==== //
+
+/// @brief  Performs `matc <- alpha * mata * matb + beta * matc` row by row. Used for small matrices.
+/// @details    `matc` is overwritten if `beta` is zero, as BLAS does.
 template<typename T>
-inline auto __mul_core_simd(size_t n, size_t m, size_t o, T alpha, const T* mata, const T* matb, T beta, T* matc) {
-    if (mata == matc || matb == matc) {
-        auto tmpc = std::make_unique<T[]>(n * m);
-        for (auto i = 0u; i < n; ++i) {
+inline auto __mul_core_simd(size_t n, size_t m, size_t o, T alpha, const T* mata, const T* matb, T beta, T* matc) -> T* {
+    for (auto i = 0u; i < n; ++i) {
+        auto* c = matc + i * m;
+        if (beta == T{}) {
+            std::fill(c, c + m, T{});
+        } else {
+            #pragma omp simd
             for (auto j = 0u; j < m; ++j) {
-                tmpc[i * m + j] = beta * matc[i * m + j];
-                for (auto k = 0u; k < o; ++k) {
-                    tmpc[i * m + j] += alpha * mata[i * o + k] * matb[k * m + j];
-                }
+                c[j] *= beta;
             }
         }
-        std::copy(tmpc.get(), tmpc.get() + n * m, matc);
-    } else {
-        for (auto i = 0u; i < n; ++i) {
+        for (auto k = 0u; k < o; ++k) {
+            auto a = alpha * mata[i * o + k];
+            const auto* b = matb + k * m;
+            #pragma omp simd
             for (auto j = 0u; j < m; ++j) {
-                matc[i * m + j] *= beta;
-                for (auto k = 0u; k < o; ++k) {
-                    matc[i * m + j] += alpha * mata[i * o + k] * matb[k * m + j];
+                c[j] += a * b[j];
+            }
+        }
+    }
+    return matc;
+}
+
+LALIB_ISA_VARIANTS(__gemm_core_small_isa, __mul_core_simd)
+
+
+// ==== Blocked products ==== //
+// The product is computed as GotoBLAS does. For each `KC` x `NC` panel of B, the panel is packed into micro-panels of `NR`
+// columns and the corresponding `n` x `KC` panel of A into micro-panels of `MR` rows. Then, each `MR` x `NR` tile of C is
+// updated by a micro-kernel with `MR * NR` accumulators, reading both micro-panels contiguously.
+
+/// @brief  The block sizes of the blocked matrix-matrix product with an `MR` x `NR` micro-kernel
+/// @details    An `MC` x `KC` block of A (about 256 KiB) stays in L2, and a `KC` x `NR` micro-panel of B stays in L1.
+template<typename T, size_t MR_, size_t NR_>
+struct __GemmBlocking {
+    static constexpr size_t MR = MR_;
+    static constexpr size_t NR = NR_;
+    static constexpr size_t KC = 256;
+    static constexpr size_t MC = 1024 / sizeof(T) / MR * MR;
+    static constexpr size_t NC = 4096 / NR * NR;
+};
+
+/// @brief  The default number of columns of the micro-kernels, a cache line of `T`
+template<typename T>
+constexpr size_t __GEMM_NR = sizeof(T) >= 16 ? 4 : 64 / sizeof(T);
+
+/// @brief  The minimum number of multiply-adds for which the blocked product is used
+constexpr size_t __GEMM_BLOCKED_THRESHOLD = 1u << 13;
+
+/// @brief  Packs `mr` (<= `MR`) rows of a `kc` columns panel of a row-major matrix, padding the rest with zeros.
+template<size_t MR, typename T>
+inline void __gemm_pack_a(size_t kc, size_t mr, const T* a, size_t lda, T* ap) noexcept {
+    for (auto p = 0u; p < kc; ++p) {
+        for (auto i = 0u; i < MR; ++i) {
+            ap[p * MR + i] = i < mr ? a[i * lda + p] : T{};
+        }
+    }
+}
+
+/// @brief  Packs `nr` (<= `NR`) columns of a `kc` rows panel of a row-major matrix, padding the rest with zeros.
+template<size_t NR, typename T>
+inline void __gemm_pack_b(size_t kc, size_t nr, const T* b, size_t ldb, T* bp) noexcept {
+    for (auto p = 0u; p < kc; ++p) {
+        #pragma omp simd
+        for (auto j = 0u; j < NR; ++j) {
+            bp[p * NR + j] = j < nr ? b[p * ldb + j] : T{};
+        }
+    }
+}
+
+// The complex micro-panels of B hold the `NR` real parts and then the `NR` imaginary parts of each row,
+// so that the micro-kernel works on real vectors.
+template<size_t NR, typename T>
+inline void __gemm_pack_b(size_t kc, size_t nr, const std::complex<T>* b, size_t ldb, std::complex<T>* bp) noexcept {
+    auto* out = reinterpret_cast<T*>(bp);
+    for (auto p = 0u; p < kc; ++p) {
+        for (auto j = 0u; j < NR; ++j) {
+            auto v = j < nr ? b[p * ldb + j] : std::complex<T>{};
+            out[2 * p * NR + j] = v.real();
+            out[2 * p * NR + NR + j] = v.imag();
+        }
+    }
+}
+
+/// @brief  Packs `nr` (<= `NR`) rows of a `kc` columns panel of a row-major matrix as the columns of its transpose.
+template<size_t NR, typename T>
+inline void __gemm_pack_bt(size_t kc, size_t nr, const T* b, size_t ldb, T* bp) noexcept {
+    for (auto j = 0u; j < NR; ++j) {
+        for (auto p = 0u; p < kc; ++p) {
+            bp[p * NR + j] = j < nr ? b[j * ldb + p] : T{};
+        }
+    }
+}
+
+template<size_t NR, typename T>
+inline void __gemm_pack_bt(size_t kc, size_t nr, const std::complex<T>* b, size_t ldb, std::complex<T>* bp) noexcept {
+    auto* out = reinterpret_cast<T*>(bp);
+    for (auto j = 0u; j < NR; ++j) {
+        for (auto p = 0u; p < kc; ++p) {
+            auto v = j < nr ? b[j * ldb + p] : std::complex<T>{};
+            out[2 * p * NR + j] = v.real();
+            out[2 * p * NR + NR + j] = v.imag();
+        }
+    }
+}
+
+/// @brief  Updates an `mr` x `nr` tile of C by `alpha` times the product of packed micro-panels of `kc` rank-1 updates.
+template<size_t MR, size_t NR, typename T>
+inline void __gemm_micro_kernel(size_t kc, T alpha, const T* ap, const T* bp, T* c, size_t ldc, size_t mr, size_t nr) noexcept {
+    T acc[MR * NR] = {};
+    for (auto p = 0u; p < kc; ++p) {
+        for (auto i = 0u; i < MR; ++i) {
+            auto a = ap[p * MR + i];
+            #pragma omp simd
+            for (auto j = 0u; j < NR; ++j) {
+                acc[i * NR + j] += a * bp[p * NR + j];
+            }
+        }
+    }
+    for (auto i = 0u; i < mr; ++i) {
+        for (auto j = 0u; j < nr; ++j) {
+            c[i * ldc + j] += alpha * acc[i * NR + j];
+        }
+    }
+}
+
+template<size_t MR, size_t NR, typename T>
+inline void __gemm_micro_kernel(size_t kc, std::complex<T> alpha, const std::complex<T>* ap, const std::complex<T>* bp, std::complex<T>* c, size_t ldc, size_t mr, size_t nr) noexcept {
+    const auto* a = reinterpret_cast<const T*>(ap);
+    const auto* b = reinterpret_cast<const T*>(bp);
+    T re[MR * NR] = {};
+    T im[MR * NR] = {};
+    for (auto p = 0u; p < kc; ++p) {
+        const auto* bre = b + 2 * p * NR;
+        const auto* bim = bre + NR;
+        for (auto i = 0u; i < MR; ++i) {
+            auto are = a[2 * (p * MR + i)];
+            auto aim = a[2 * (p * MR + i) + 1];
+            #pragma omp simd
+            for (auto j = 0u; j < NR; ++j) {
+                re[i * NR + j] += are * bre[j] - aim * bim[j];
+                im[i * NR + j] += are * bim[j] + aim * bre[j];
+            }
+        }
+    }
+    for (auto i = 0u; i < mr; ++i) {
+        for (auto j = 0u; j < nr; ++j) {
+            auto k = i * NR + j;
+            c[i * ldc + j] += std::complex<T>(
+                alpha.real() * re[k] - alpha.imag() * im[k],
+                alpha.real() * im[k] + alpha.imag() * re[k]
+            );
+        }
+    }
+}
+
+/// @brief  The micro-kernel of the baseline instruction set, vectorized by the compiler
+template<typename T>
+struct __GemmKernel: __GemmBlocking<T, 4, __GEMM_NR<T>> {
+    static void run(size_t kc, T alpha, const T* ap, const T* bp, T* c, size_t ldc, size_t mr, size_t nr) noexcept {
+        __gemm_micro_kernel<4, __GEMM_NR<T>>(kc, alpha, ap, bp, c, ldc, mr, nr);
+    }
+};
+
+#if defined(LALIB_ISA_DISPATCH)
+// ==== Micro-kernels for AVX2 and AVX-512 ==== //
+// The kernels for `float` and `double` keep the whole tile in vector registers (12 of 16 for AVX2, 24 of 32 for AVX-512)
+// and update it by a broadcast of A and FMAs with the rows of B. The other types compile the generic micro-kernel
+// for the instruction set.
+
+/// @brief  Adds `alpha` times a tile of `MR` x `NR` accumulators in `acc` to an `mr` x `nr` tile of C.
+template<size_t MR, size_t NR, typename T>
+inline void __gemm_store_tile(const T* acc, T alpha, T* c, size_t ldc, size_t mr, size_t nr) noexcept {
+    for (auto i = 0u; i < mr; ++i) {
+        for (auto j = 0u; j < nr; ++j) {
+            c[i * ldc + j] += alpha * acc[i * NR + j];
+        }
+    }
+}
+
+LALIB_TARGET_AVX2 inline void __gemm_micro_kernel_avx2(size_t kc, double alpha, const double* ap, const double* bp, double* c, size_t ldc, size_t mr, size_t nr) noexcept {
+    constexpr size_t MR = 6, NR = 8;
+    __m256d acc[MR][2];
+    #pragma GCC unroll 6
+    for (auto i = 0u; i < MR; ++i) { acc[i][0] = _mm256_setzero_pd(); acc[i][1] = _mm256_setzero_pd(); }
+    for (auto p = size_t(0); p < kc; ++p) {
+        auto b0 = _mm256_loadu_pd(bp + p * NR);
+        auto b1 = _mm256_loadu_pd(bp + p * NR + 4);
+        #pragma GCC unroll 6
+        for (auto i = 0u; i < MR; ++i) {
+            auto a = _mm256_broadcast_sd(ap + p * MR + i);
+            acc[i][0] = _mm256_fmadd_pd(a, b0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_pd(a, b1, acc[i][1]);
+        }
+    }
+    auto va = _mm256_set1_pd(alpha);
+    if (mr == MR && nr == NR) {
+        #pragma GCC unroll 6
+        for (auto i = 0u; i < MR; ++i) {
+            _mm256_storeu_pd(c + i * ldc, _mm256_fmadd_pd(va, acc[i][0], _mm256_loadu_pd(c + i * ldc)));
+            _mm256_storeu_pd(c + i * ldc + 4, _mm256_fmadd_pd(va, acc[i][1], _mm256_loadu_pd(c + i * ldc + 4)));
+        }
+        return;
+    }
+    alignas(32) double tile[MR * NR];
+    #pragma GCC unroll 6
+    for (auto i = 0u; i < MR; ++i) { _mm256_store_pd(tile + i * NR, acc[i][0]); _mm256_store_pd(tile + i * NR + 4, acc[i][1]); }
+    __gemm_store_tile<MR, NR>(tile, alpha, c, ldc, mr, nr);
+}
+
+LALIB_TARGET_AVX2 inline void __gemm_micro_kernel_avx2(size_t kc, float alpha, const float* ap, const float* bp, float* c, size_t ldc, size_t mr, size_t nr) noexcept {
+    constexpr size_t MR = 6, NR = 16;
+    __m256 acc[MR][2];
+    #pragma GCC unroll 6
+    for (auto i = 0u; i < MR; ++i) { acc[i][0] = _mm256_setzero_ps(); acc[i][1] = _mm256_setzero_ps(); }
+    for (auto p = size_t(0); p < kc; ++p) {
+        auto b0 = _mm256_loadu_ps(bp + p * NR);
+        auto b1 = _mm256_loadu_ps(bp + p * NR + 8);
+        #pragma GCC unroll 6
+        for (auto i = 0u; i < MR; ++i) {
+            auto a = _mm256_broadcast_ss(ap + p * MR + i);
+            acc[i][0] = _mm256_fmadd_ps(a, b0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_ps(a, b1, acc[i][1]);
+        }
+    }
+    auto va = _mm256_set1_ps(alpha);
+    if (mr == MR && nr == NR) {
+        #pragma GCC unroll 6
+        for (auto i = 0u; i < MR; ++i) {
+            _mm256_storeu_ps(c + i * ldc, _mm256_fmadd_ps(va, acc[i][0], _mm256_loadu_ps(c + i * ldc)));
+            _mm256_storeu_ps(c + i * ldc + 8, _mm256_fmadd_ps(va, acc[i][1], _mm256_loadu_ps(c + i * ldc + 8)));
+        }
+        return;
+    }
+    alignas(32) float tile[MR * NR];
+    #pragma GCC unroll 6
+    for (auto i = 0u; i < MR; ++i) { _mm256_store_ps(tile + i * NR, acc[i][0]); _mm256_store_ps(tile + i * NR + 8, acc[i][1]); }
+    __gemm_store_tile<MR, NR>(tile, alpha, c, ldc, mr, nr);
+}
+
+LALIB_TARGET_AVX512 inline void __gemm_micro_kernel_avx512(size_t kc, double alpha, const double* ap, const double* bp, double* c, size_t ldc, size_t mr, size_t nr) noexcept {
+    constexpr size_t MR = 12, NR = 16;
+    __m512d acc[MR][2];
+    #pragma GCC unroll 12
+    for (auto i = 0u; i < MR; ++i) { acc[i][0] = _mm512_setzero_pd(); acc[i][1] = _mm512_setzero_pd(); }
+    for (auto p = size_t(0); p < kc; ++p) {
+        auto b0 = _mm512_loadu_pd(bp + p * NR);
+        auto b1 = _mm512_loadu_pd(bp + p * NR + 8);
+        #pragma GCC unroll 12
+        for (auto i = 0u; i < MR; ++i) {
+            auto a = _mm512_set1_pd(ap[p * MR + i]);
+            acc[i][0] = _mm512_fmadd_pd(a, b0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_pd(a, b1, acc[i][1]);
+        }
+    }
+    auto va = _mm512_set1_pd(alpha);
+    if (mr == MR && nr == NR) {
+        #pragma GCC unroll 12
+        for (auto i = 0u; i < MR; ++i) {
+            _mm512_storeu_pd(c + i * ldc, _mm512_fmadd_pd(va, acc[i][0], _mm512_loadu_pd(c + i * ldc)));
+            _mm512_storeu_pd(c + i * ldc + 8, _mm512_fmadd_pd(va, acc[i][1], _mm512_loadu_pd(c + i * ldc + 8)));
+        }
+        return;
+    }
+    alignas(64) double tile[MR * NR];
+    #pragma GCC unroll 12
+    for (auto i = 0u; i < MR; ++i) { _mm512_store_pd(tile + i * NR, acc[i][0]); _mm512_store_pd(tile + i * NR + 8, acc[i][1]); }
+    __gemm_store_tile<MR, NR>(tile, alpha, c, ldc, mr, nr);
+}
+
+LALIB_TARGET_AVX512 inline void __gemm_micro_kernel_avx512(size_t kc, float alpha, const float* ap, const float* bp, float* c, size_t ldc, size_t mr, size_t nr) noexcept {
+    constexpr size_t MR = 12, NR = 32;
+    __m512 acc[MR][2];
+    #pragma GCC unroll 12
+    for (auto i = 0u; i < MR; ++i) { acc[i][0] = _mm512_setzero_ps(); acc[i][1] = _mm512_setzero_ps(); }
+    for (auto p = size_t(0); p < kc; ++p) {
+        auto b0 = _mm512_loadu_ps(bp + p * NR);
+        auto b1 = _mm512_loadu_ps(bp + p * NR + 16);
+        #pragma GCC unroll 12
+        for (auto i = 0u; i < MR; ++i) {
+            auto a = _mm512_set1_ps(ap[p * MR + i]);
+            acc[i][0] = _mm512_fmadd_ps(a, b0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_ps(a, b1, acc[i][1]);
+        }
+    }
+    auto va = _mm512_set1_ps(alpha);
+    if (mr == MR && nr == NR) {
+        #pragma GCC unroll 12
+        for (auto i = 0u; i < MR; ++i) {
+            _mm512_storeu_ps(c + i * ldc, _mm512_fmadd_ps(va, acc[i][0], _mm512_loadu_ps(c + i * ldc)));
+            _mm512_storeu_ps(c + i * ldc + 16, _mm512_fmadd_ps(va, acc[i][1], _mm512_loadu_ps(c + i * ldc + 16)));
+        }
+        return;
+    }
+    alignas(64) float tile[MR * NR];
+    #pragma GCC unroll 12
+    for (auto i = 0u; i < MR; ++i) { _mm512_store_ps(tile + i * NR, acc[i][0]); _mm512_store_ps(tile + i * NR + 16, acc[i][1]); }
+    __gemm_store_tile<MR, NR>(tile, alpha, c, ldc, mr, nr);
+}
+
+template<size_t MR, size_t NR, typename T>
+__attribute__((flatten)) LALIB_TARGET_AVX2 inline void __gemm_micro_kernel_generic_avx2(size_t kc, T alpha, const T* ap, const T* bp, T* c, size_t ldc, size_t mr, size_t nr) noexcept {
+    __gemm_micro_kernel<MR, NR>(kc, alpha, ap, bp, c, ldc, mr, nr);
+}
+
+template<size_t MR, size_t NR, typename T>
+__attribute__((flatten)) LALIB_TARGET_AVX512 inline void __gemm_micro_kernel_generic_avx512(size_t kc, T alpha, const T* ap, const T* bp, T* c, size_t ldc, size_t mr, size_t nr) noexcept {
+    __gemm_micro_kernel<MR, NR>(kc, alpha, ap, bp, c, ldc, mr, nr);
+}
+
+/// @brief  The micro-kernel for AVX2 and FMA
+template<typename T, size_t NR = __GEMM_NR<T>>
+struct __GemmKernelAvx2: __GemmBlocking<T, 4, NR> {
+    static void run(size_t kc, T alpha, const T* ap, const T* bp, T* c, size_t ldc, size_t mr, size_t nr) noexcept {
+        __gemm_micro_kernel_generic_avx2<4, NR>(kc, alpha, ap, bp, c, ldc, mr, nr);
+    }
+};
+
+template<>
+struct __GemmKernelAvx2<double>: __GemmBlocking<double, 6, 8> {
+    static void run(size_t kc, double alpha, const double* ap, const double* bp, double* c, size_t ldc, size_t mr, size_t nr) noexcept {
+        __gemm_micro_kernel_avx2(kc, alpha, ap, bp, c, ldc, mr, nr);
+    }
+};
+
+template<>
+struct __GemmKernelAvx2<float>: __GemmBlocking<float, 6, 16> {
+    static void run(size_t kc, float alpha, const float* ap, const float* bp, float* c, size_t ldc, size_t mr, size_t nr) noexcept {
+        __gemm_micro_kernel_avx2(kc, alpha, ap, bp, c, ldc, mr, nr);
+    }
+};
+
+/// @brief  The micro-kernel for AVX-512. Complex numbers use a full vector for each of the real and the imaginary parts.
+template<typename T, size_t NR = __GEMM_NR<T>>
+struct __GemmKernelAvx512: __GemmBlocking<T, 4, NR> {
+    static void run(size_t kc, T alpha, const T* ap, const T* bp, T* c, size_t ldc, size_t mr, size_t nr) noexcept {
+        __gemm_micro_kernel_generic_avx512<4, NR>(kc, alpha, ap, bp, c, ldc, mr, nr);
+    }
+};
+
+template<typename T>
+struct __GemmKernelAvx512<std::complex<T>>: __GemmKernelAvx512<std::complex<T>, 64 / sizeof(T)> {};
+
+template<>
+struct __GemmKernelAvx512<double>: __GemmBlocking<double, 12, 16> {
+    static void run(size_t kc, double alpha, const double* ap, const double* bp, double* c, size_t ldc, size_t mr, size_t nr) noexcept {
+        __gemm_micro_kernel_avx512(kc, alpha, ap, bp, c, ldc, mr, nr);
+    }
+};
+
+template<>
+struct __GemmKernelAvx512<float>: __GemmBlocking<float, 12, 32> {
+    static void run(size_t kc, float alpha, const float* ap, const float* bp, float* c, size_t ldc, size_t mr, size_t nr) noexcept {
+        __gemm_micro_kernel_avx512(kc, alpha, ap, bp, c, ldc, mr, nr);
+    }
+};
+#endif
+
+/// @brief  Performs `matc <- alpha * mata * op(matb) + matc` by the blocked algorithm with the micro-kernel `K`.
+/// @details    The macro-tiles (`MC` rows x `NR` columns of C) of each panel are distributed to the threads
+///             if the product is larger than the threshold of `Kernel::MatMul`. `matc` must not overlap the others.
+/// @tparam TransB  whether `op(matb)` is the transpose of the `m` x `o` matrix `matb`, instead of the `o` x `m` one
+/// @param lda, ldb, ldc    the leading dimensions (the distance between the rows) of the matrices
+template<typename K, bool TransB = false, typename T>
+inline auto __mul_core_blocked(size_t n, size_t m, size_t o, T alpha, const T* mata, size_t lda, const T* matb, size_t ldb, T* matc, size_t ldc) -> T* {
+    constexpr auto MR = K::MR, NR = K::NR, KC = K::KC, MC = K::MC, NC = K::NC;
+
+    auto npad = (n + MR - 1) / MR * MR;
+    auto ncpad = (std::min(m, NC) + NR - 1) / NR * NR;
+    auto apack = std::make_unique_for_overwrite<T[]>(npad * std::min(o, KC));
+    auto bpack = std::make_unique_for_overwrite<T[]>(ncpad * std::min(o, KC));
+    auto* ap = apack.get();
+    auto* bp = bpack.get();
+    auto parallel = _use_parallel<T>(Kernel::MatMul, n * m * o);
+
+    #pragma omp parallel if(parallel)
+    for (auto jc = size_t(0); jc < m; jc += NC) {
+        auto nc = std::min(NC, m - jc);
+        auto nbj = (nc + NR - 1) / NR;
+        for (auto pc = size_t(0); pc < o; pc += KC) {
+            auto kc = std::min(KC, o - pc);
+
+            #pragma omp for schedule(static)
+            for (auto jb = size_t(0); jb < nbj; ++jb) {
+                if constexpr (TransB) {
+                    __gemm_pack_bt<NR>(kc, std::min(NR, nc - jb * NR), matb + (jc + jb * NR) * ldb + pc, ldb, bp + jb * NR * kc);
+                } else {
+                    __gemm_pack_b<NR>(kc, std::min(NR, nc - jb * NR), matb + pc * ldb + jc + jb * NR, ldb, bp + jb * NR * kc);
+                }
+            }
+            #pragma omp for schedule(static)
+            for (auto ib = size_t(0); ib < npad / MR; ++ib) {
+                __gemm_pack_a<MR>(kc, std::min(MR, n - ib * MR), mata + ib * MR * lda + pc, lda, ap + ib * MR * kc);
+            }
+
+            // A thread sweeps an `MC` x `KC` block of A (in L2) with one micro-panel of B (in L1)
+            auto nbi = (n + MC - 1) / MC;
+            #pragma omp for collapse(2) schedule(static)
+            for (auto bi = size_t(0); bi < nbi; ++bi) {
+                for (auto jb = size_t(0); jb < nbj; ++jb) {
+                    auto nr = std::min(NR, nc - jb * NR);
+                    auto iend = std::min(n, (bi + 1) * MC);
+                    for (auto ir = bi * MC; ir < iend; ir += MR) {
+                        K::run(
+                            kc, alpha, ap + ir * kc, bp + jb * NR * kc,
+                            matc + ir * ldc + jc + jb * NR, ldc, std::min(MR, iend - ir), nr
+                        );
+                    }
+                }
+            }
+        }
+    }
+    return matc;
+}
+
+/// @brief  Performs `matc <- alpha * mata * op(matb) + beta * matc` element by element. Used for small matrices.
+template<bool TransB, typename T>
+inline void __gemm_small(size_t n, size_t m, size_t o, T alpha, const T* mata, size_t lda, const T* matb, size_t ldb, T beta, T* matc, size_t ldc) noexcept {
+    for (auto i = size_t(0); i < n; ++i) {
+        auto* c = matc + i * ldc;
+        for (auto j = size_t(0); j < m; ++j) {
+            c[j] = beta == T{} ? T{} : beta * c[j];
+        }
+        if constexpr (TransB) {
+            for (auto j = size_t(0); j < m; ++j) {
+                const auto* a = mata + i * lda;
+                const auto* b = matb + j * ldb;
+                auto sum = T{};
+                for (auto k = size_t(0); k < o; ++k) {
+                    sum += a[k] * b[k];
+                }
+                c[j] += alpha * sum;
+            }
+        } else {
+            for (auto k = size_t(0); k < o; ++k) {
+                auto a = alpha * mata[i * lda + k];
+                const auto* b = matb + k * ldb;
+                #pragma omp simd
+                for (auto j = size_t(0); j < m; ++j) {
+                    c[j] += a * b[j];
                 }
             }
         }
     }
+}
+
+LALIB_ISA_VARIANTS(__gemm_small_isa, __gemm_small<false>)
+LALIB_ISA_VARIANTS(__gemm_small_trans_isa, __gemm_small<true>)
+
+/// @brief  Performs `matc <- alpha * mata * op(matb) + beta * matc` by the internal kernels. See `_gemm_core`.
+template<bool TransB, typename T>
+inline void __gemm_core_internal(size_t n, size_t m, size_t o, T alpha, const T* mata, size_t lda, const T* matb, size_t ldb, T beta, T* matc, size_t ldc) {
+    if (n * m * o < __GEMM_BLOCKED_THRESHOLD) {
+        if constexpr (TransB) {
+            __gemm_small_trans_isa(n, m, o, alpha, mata, lda, matb, ldb, beta, matc, ldc);
+        } else {
+            __gemm_small_isa(n, m, o, alpha, mata, lda, matb, ldb, beta, matc, ldc);
+        }
+        return;
+    }
+
+    if (beta != T(1)) {
+        for (auto i = size_t(0); i < n; ++i) {
+            auto* c = matc + i * ldc;
+            for (auto j = size_t(0); j < m; ++j) {
+                c[j] = beta == T{} ? T{} : beta * c[j];
+            }
+        }
+    }
+    #if defined(LALIB_ISA_DISPATCH)
+    switch (active_isa()) {
+        case Isa::Avx512: 
+            __mul_core_blocked<__GemmKernelAvx512<T>, TransB>(n, m, o, alpha, mata, lda, matb, ldb, matc, ldc);
+            return;
+        case Isa::Avx2: 
+            __mul_core_blocked<__GemmKernelAvx2<T>, TransB>(n, m, o, alpha, mata, lda, matb, ldb, matc, ldc);
+            return;
+        default: break;
+    }
+    #endif
+    __mul_core_blocked<__GemmKernel<T>, TransB>(n, m, o, alpha, mata, lda, matb, ldb, matc, ldc);
+}
+
+/// @brief  Performs `matc <- alpha * mata * op(matb) + beta * matc` for row-major matrices with leading dimensions.
+/// @details    This is the general matrix-matrix product the factorizations are built on. `op(matb)` is `matb` or, 
+///             if `TransB`, the transpose of the `m` x `o` matrix `matb`. Small products are computed directly, and the 
+///             others by the blocked algorithm for the active instruction set, or by the BLAS backend for `float` and `double`. 
+///             `matc` must not overlap the others, and it is overwritten if `beta` is zero.
+template<bool TransB, typename T>
+inline void _gemm_core(size_t n, size_t m, size_t o, T alpha, const T* mata, size_t lda, const T* matb, size_t ldb, T beta, T* matc, size_t ldc) {
+    if (n == 0 || m == 0) { return; }
+    #if defined(LALIB_BLAS_BACKEND)
+    constexpr auto trans = TransB ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans;
+    if constexpr (std::is_same_v<T, float>) {
+        cblas_sgemm(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, trans, n, m, o, alpha, mata, lda, matb, ldb, beta, matc, ldc);
+        return;
+    } else if constexpr (std::is_same_v<T, double>) {
+        cblas_dgemm(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, trans, n, m, o, alpha, mata, lda, matb, ldb, beta, matc, ldc);
+        return;
+    }
+    #endif
+    __gemm_core_internal<TransB>(n, m, o, alpha, mata, lda, matb, ldb, beta, matc, ldc);
+}
+
+/// @brief  Dispatches the matrix-matrix product of the internal backend by the size of the matrices.
+/// @details    Performs `matc <- alpha * mata * matb + beta * matc` for row-major `n` x `o` and `o` x `m` matrices.
+///             `matc` may be `mata` or `matb`, and it is overwritten if `beta` is zero.
+template<typename T>
+inline auto __mul_core_dispatch(size_t n, size_t m, size_t o, T alpha, const T* mata, const T* matb, T beta, T* matc) -> T* {
+    // If the pointers of the multipliers and one storing the result are the same
+    if (mata == matc || matb == matc) {
+        auto tmp = std::make_unique<T[]>(n * m);
+        std::copy(matc, matc + n * m, tmp.get());
+        __mul_core_dispatch(n, m, o, alpha, mata, matb, beta, tmp.get());
+        std::copy(tmp.get(), tmp.get() + n * m, matc);
+        return matc;
+    }
+    if (n * m * o < __GEMM_BLOCKED_THRESHOLD) {
+        return __gemm_core_small_isa(n, m, o, alpha, mata, matb, beta, matc);
+    }
+    __gemm_core_internal<false>(n, m, o, alpha, mata, o, matb, m, beta, matc, m);
     return matc;
 }
 
+/// @brief      Performs matrix-matrix multiplication.
+/// @details    Performs `matc <- alpha * mata * matb + beta * matc` for row-major matrices, returns `matc`.
+///             `matc` is overwritten if `beta` is zero.
+/// @param n    the number of rows of `mata` and `matc`
+/// @param m    the number of columns of `matb` and `matc`
+/// @param o    the number of columns of `mata` and rows of `matb`
+/// @return     `matc`
 template<typename T>
 inline auto mul_core(size_t n, size_t m, size_t o, T alpha, const T* mata, const T* matb, T beta, T* matc) noexcept -> T* {
-    __mul_core_simd(n, m, o, alpha, mata, matb, beta, matc);
+    __mul_core_dispatch(n, m, o, alpha, mata, matb, beta, matc);
     return matc;
 }
 
-template<>
-inline auto mul_core<float>(size_t n, size_t m, size_t l, float alpha, const float* mata, const float* matb, float beta, float* matc) noexcept -> float* {
-    #if defined(LALIB_BLAS_BACKEND)
+#if defined(LALIB_BLAS_BACKEND)
+/// @brief  Calls a CBLAS gemm for row-major matrices, copying `matc` if it is also a multiplier.
+template<typename T, typename F>
+inline auto __mul_core_blas(size_t n, size_t m, const T* mata, const T* matb, T* matc, F gemm) -> T* {
     if (mata == matc || matb == matc) {
-        auto tmp = std::make_unique<float[]>(n * m);
+        auto tmp = std::make_unique<T[]>(n * m);
         std::copy(matc, matc + n * m, tmp.get());
-        cblas_sgemm(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasNoTrans, n, m, l, alpha, mata, l, matb, m, beta, tmp.get(), n);
+        gemm(tmp.get());
         std::copy(tmp.get(), tmp.get() + n * m, matc);
     } else {
-        cblas_sgemm(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasNoTrans, n, m, l, alpha, mata, l, matb, m, beta, matc, n);
+        gemm(matc);
     }
+    return matc;
+}
+#endif
+
+template<>
+inline auto mul_core<float>(size_t n, size_t m, size_t l, float alpha, const float* mata, const float* matb, float beta, float* matc) noexcept -> float* {
+    #if defined(LALIB_BLAS_BACKEND)
+    __mul_core_blas(n, m, mata, matb, matc, [&](float* c) {
+        cblas_sgemm(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasNoTrans, n, m, l, alpha, mata, l, matb, m, beta, c, m);
+    });
     #else
-    __mul_core_simd(n, m, l, alpha, mata, matb, beta, matc);
+    __mul_core_dispatch(n, m, l, alpha, mata, matb, beta, matc);
     #endif
     return matc;
 }
@@ -75,20 +601,39 @@ inline auto mul_core<float>(size_t n, size_t m, size_t l, float alpha, const flo
 template<>
 inline auto mul_core<double>(size_t n, size_t m, size_t l, double alpha, const double* mata, const double* matb, double beta, double* matc) noexcept -> double* {
     #if defined(LALIB_BLAS_BACKEND)
-    if (mata == matc || matb == matc) {
-        auto tmp = std::make_unique<double[]>(n * m);
-        std::copy(matc, matc + n * m, tmp.get());
-        cblas_dgemm(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasNoTrans, n, m, l, alpha, mata, l, matb, m, beta, tmp.get(), n);
-        std::copy(tmp.get(), tmp.get() + n * m, matc);
-    } else {
-        cblas_dgemm(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasNoTrans, n, m, l, alpha, mata, l, matb, m, beta, matc, n);
-    }
+    __mul_core_blas(n, m, mata, matb, matc, [&](double* c) {
+        cblas_dgemm(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasNoTrans, n, m, l, alpha, mata, l, matb, m, beta, c, m);
+    });
+    #else
+    __mul_core_dispatch(n, m, l, alpha, mata, matb, beta, matc);
+    #endif
+    return matc;
+}
+
+template<>
+inline auto mul_core<std::complex<float>>(size_t n, size_t m, size_t l, std::complex<float> alpha, const std::complex<float>* mata, const std::complex<float>* matb, std::complex<float> beta, std::complex<float>* matc) noexcept -> std::complex<float>* {
+    #if defined(LALIB_BLAS_BACKEND)
+    __mul_core_blas(n, m, mata, matb, matc, [&](std::complex<float>* c) {
+        cblas_cgemm(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasNoTrans, n, m, l, &alpha, mata, l, matb, m, &beta, c, m);
+    });
     #else
-    __mul_core_simd(n, m, l, alpha, mata, matb, beta, matc);
+    __mul_core_dispatch(n, m, l, alpha, mata, matb, beta, matc);
     #endif
     return matc;
 }
 
+template<>
+inline auto mul_core<std::complex<double>>(size_t n, size_t m, size_t l, std::complex<double> alpha, const std::complex<double>* mata, const std::complex<double>* matb, std::complex<double> beta, std::complex<double>* matc) noexcept -> std::complex<double>* {
+    #if defined(LALIB_BLAS_BACKEND)
+    __mul_core_blas(n, m, mata, matb, matc, [&](std::complex<double>* c) {
+        cblas_zgemm(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasNoTrans, n, m, l, &alpha, mata, l, matb, m, &beta, c, m);
+    });
+    #else
+    __mul_core_dispatch(n, m, l, alpha, mata, matb, beta, matc);
+    #endif
+    return matc;
 }
 
-#endif
\ No newline at end of file
+}
+
+#endif
@@ -28,14 +28,14 @@ inline auto scale(const T& alpha, DynMat<T>& mat) noexcept -> DynMat<T>& {
     return mat;
 }
 
-template<typename T>
-inline auto scale(const T& alpha, SpCooMat<T>& mat) noexcept -> SpCooMat<T>& {
+template<typename T, typename I>
+inline auto scale(const T& alpha, SpCooMat<T, I>& mat) noexcept -> SpCooMat<T, I>& {
     scal_core(alpha, mat.data(), mat.nnz());
     return mat;
 }
 
-template<typename T>
-inline auto scale(const T& alpha, SpMat<T>& mat) noexcept -> SpMat<T>& {
+template<typename T, typename I>
+inline auto scale(const T& alpha, SpMat<T, I>& mat) noexcept -> SpMat<T, I>& {
     scal_core<T>(alpha, mat.data(), mat.nnz());
     return mat;
 }
@@ -55,15 +55,15 @@ inline auto operator*(const T& alpha, const DynMat<T>& mat) noexcept -> DynMat<T
     return rmat;
 }
 
-template<typename T>
-inline auto operator*(const T& alpha, const SpCooMat<T>& mat) noexcept -> SpCooMat<T> {
+template<typename T, typename I>
+inline auto operator*(const T& alpha, const SpCooMat<T, I>& mat) noexcept -> SpCooMat<T, I> {
     auto rmat = mat;
     scale(alpha, rmat);
     return rmat;
 }
 
-template<typename T>
-inline auto operator*(const T& alpha, const SpMat<T>& mat) noexcept -> SpMat<T> {
+template<typename T, typename I>
+inline auto operator*(const T& alpha, const SpMat<T, I>& mat) noexcept -> SpMat<T, I> {
     auto rmat = mat;
     scale(alpha, rmat);
     return rmat;
@@ -90,17 +90,17 @@ inline auto operator-(const DynMat<T>& mat) noexcept -> DynMat<T> {
     return rmat;
 }
 
-template<typename T>
+template<typename T, typename I>
 requires std::is_integral_v<T> || std::is_floating_point_v<T>
-inline auto operator-(const SpCooMat<T>& mat) noexcept -> SpCooMat<T> {
+inline auto operator-(const SpCooMat<T, I>& mat) noexcept -> SpCooMat<T, I> {
     auto rmat = mat;
     scale(-1.0, rmat);
     return rmat;
 }
 
-template<typename T>
+template<typename T, typename I>
 requires std::is_integral_v<T> || std::is_floating_point_v<T>
-inline auto operator-(const SpMat<T>& mat) noexcept -> SpMat<T> {
+inline auto operator-(const SpMat<T, I>& mat) noexcept -> SpMat<T, I> {
     auto rmat = mat;
     scale(-1.0, rmat);
     return rmat;
@@ -6,9 +6,12 @@
 #include "lalib/mat/sized_mat.hpp"
 #include "lalib/mat/dyn_mat.hpp"
 #include "lalib/mat/sp_mat.hpp"
+#include "lalib/mat/sp_sell_mat.hpp"
+#include "lalib/mat/sp_bsr_mat.hpp"
 #include "lalib/vec/sized_vec.hpp"
 #include "lalib/vec/dyn_vec.hpp"
 #include <cassert>
+#include <concepts>
 
 
 namespace lalib {
@@ -46,15 +49,118 @@ inline auto mul(T alpha, const DynMat<T>& mat, const DynVec<T>& v, T beta, DynVe
     return vr;
 }
 
+/// @brief      Performs transposed matrix-vector multiplication, `vr <- alpha * mat^T * v + beta * vr`.
+/// @details    The transpose is not formed. Complex matrices are not conjugated.
+template<typename T, size_t N, size_t M>
+inline auto mul_trans(T alpha, const SizedMat<T, N, M>& mat, const SizedVec<T, N>& v, T beta, SizedVec<T, M>& vr) noexcept -> SizedVec<T, M>& {
+    mul_trans_core(N, M, alpha, mat.data(), v.data(), beta, vr.data());
+    return vr;
+}
+
+/// @brief      Performs transposed matrix-vector multiplication, `vr <- alpha * mat^T * v + beta * vr`.
+/// @details    The transpose is not formed. Complex matrices are not conjugated.
 template<typename T>
-inline auto mul(T alpha, const SpMat<T>& mat, const DynVec<T>& v, T beta, DynVec<T>& vr) noexcept -> DynVec<T>& {
+inline auto mul_trans(T alpha, const DynMat<T>& mat, const DynVec<T>& v, T beta, DynVec<T>& vr) noexcept -> DynVec<T>& {
+    auto [n, m] = mat.shape();
+    assert(n == v.size());
+    assert(m == vr.size());
+    mul_trans_core(n, m, alpha, mat.data(), v.data(), beta, vr.data());
+    return vr;
+}
+
+/// @brief      Computes `mat^T * v` without forming the transpose.
+template<typename T>
+inline auto mul_trans(const DynMat<T>& mat, const DynVec<T>& v) noexcept -> DynVec<T> {
+    auto [n, m] = mat.shape();
+    assert(n == v.size());
+    auto vr = DynVec<T>::uninit(m);
+    mul_trans_core(n, m, T(1), mat.data(), v.data(), T(0), vr.data());
+    return vr;
+}
+
+/// @brief      Calls `f(nparts, part)` with the row chunks of a product by `mat`.
+/// @details    A serial product uses a single chunk. A parallel one uses the partition stored in the matrix, or computes
+///             one if the number of threads has changed since the matrix was built. The matrix is never modified, so
+///             the products on a shared matrix may run from several threads.
+template<typename T, typename I, typename F>
+inline auto _with_sp_row_partition(const SpMat<T, I>& mat, F f) {
+    auto nparts = _sp_mul_nparts<T>(mat.nnz());
+    if (nparts <= 1) {
+        const size_t part[2] = { 0, mat.shape().first };
+        return f(size_t(1), part);
+    }
+    const auto& cached = mat.thread_row_partition();
+    if (cached.size() == nparts + 1) {
+        return f(nparts, cached.data());
+    }
+    auto part = mat.row_partition(nparts);
+    return f(nparts, part.data());
+}
+
+template<typename T, typename I>
+inline auto mul(T alpha, const SpMat<T, I>& mat, const DynVec<T>& v, T beta, DynVec<T>& vr) noexcept -> DynVec<T>& {
+    assert(mat.shape().second == v.size());
+    assert(mat.shape().first == vr.size());
+    _with_sp_row_partition(mat, [&](size_t nparts, const size_t* part) {
+        sp_mul_core(nparts, part, mat.col_indices().data(), mat.row_ptr().data(), alpha, mat.values().data(), v.data(), beta, vr.data());
+    });
+    return vr;
+}
+
+/// @brief      Performs matrix-vector multiplication, `vr <- alpha * mat * v + beta * vr`, with a summation policy for the rows.
+/// @param summation    `Summation::Compensated` or `Summation::Pairwise` accumulate each row accurately. 
+///                     The others are the same as the overload without the policy, whose rows are already independent of the number of threads.
+template<std::floating_point T>
+inline auto mul(T alpha, const DynMat<T>& mat, const DynVec<T>& v, T beta, DynVec<T>& vr, Summation summation) -> DynVec<T>& {
+    if (summation != Summation::Compensated && summation != Summation::Pairwise) {
+        return mul(alpha, mat, v, beta, vr);
+    }
     auto [n, m] = mat.shape();
     assert(m == v.size());
     assert(n == vr.size());
-    _sp_mul_core(n, mat.col_indices().data(), mat.row_ptr().data(), alpha, mat.values().data(), v.data(), beta, vr.data());
+    _mul_core_accurate(n, m, alpha, mat.data(), v.data(), beta, vr.data(), summation);
     return vr;
 }
 
+/// @brief      Performs matrix-vector multiplication, `vr <- alpha * mat * v + beta * vr`, with a summation policy for the rows.
+/// @param summation    `Summation::Compensated` or `Summation::Pairwise` accumulate each row accurately. 
+///                     The others are the same as the overload without the policy, whose rows are already independent of the number of threads.
+template<std::floating_point T, typename I>
+inline auto mul(T alpha, const SpMat<T, I>& mat, const DynVec<T>& v, T beta, DynVec<T>& vr, Summation summation) -> DynVec<T>& {
+    if (summation != Summation::Compensated && summation != Summation::Pairwise) {
+        return mul(alpha, mat, v, beta, vr);
+    }
+    assert(mat.shape().second == v.size());
+    assert(mat.shape().first == vr.size());
+    _with_sp_row_partition(mat, [&](size_t nparts, const size_t* part) {
+        _sp_mul_core_accurate(nparts, part, mat.col_indices().data(), mat.row_ptr().data(), alpha, mat.values().data(), v.data(), beta, vr.data(), summation);
+    });
+    return vr;
+}
+
+
+template<typename T, size_t C, typename I>
+inline auto mul(T alpha, const SpSellMat<T, C, I>& mat, const DynVec<T>& v, T beta, DynVec<T>& vr) noexcept -> DynVec<T>& {
+    auto [n, m] = mat.shape();
+    assert(m == v.size());
+    assert(n == vr.size());
+    _sp_sell_mul_core<C>(
+        n, mat.nslices(), mat.slice_ptr().data(), mat.slice_len().data(), mat.row_len().data(), mat.col_indices().data(), mat.permutation().data(), 
+        alpha, mat.values().data(), v.data(), beta, vr.data(), _sp_mul_nparts<T>(mat.padded_size()) > 1
+    );
+    return vr;
+}
+
+template<typename T, size_t B, typename I>
+inline auto mul(T alpha, const SpBsrMat<T, B, I>& mat, const DynVec<T>& v, T beta, DynVec<T>& vr) noexcept -> DynVec<T>& {
+    assert(mat.shape().second == v.size());
+    assert(mat.shape().first == vr.size());
+    _sp_bsr_mul_core<B>(
+        mat.block_shape().first, mat.col_indices().data(), mat.row_ptr().data(), 
+        alpha, mat.values().data(), v.data(), beta, vr.data(), _sp_mul_nparts<T>(mat.nnz()) > 1
+    );
+    return vr;
+}
 
 template<typename T, size_t N, size_t M>
 inline auto operator*(const SizedMat<T, N, M>& mat, const SizedVec<T, M>& vec) noexcept -> SizedVec<T, N> {
@@ -89,12 +195,32 @@ inline auto operator*(const DynMat<T>& mat, const DynVec<T>& vec) noexcept -> Dy
     return vr;
 }
 
-template<typename T>
-inline auto operator*(const SpMat<T>& mat, const DynVec<T>& vec) noexcept -> DynVec<T> {
+template<typename T, typename I>
+inline auto operator*(const SpMat<T, I>& mat, const DynVec<T>& vec) noexcept -> DynVec<T> {
+    auto [n, m] = mat.shape();
+    assert(m == vec.size());
+    auto vr = DynVec<T>::uninit(n);
+    _with_sp_row_partition(mat, [&](size_t nparts, const size_t* part) {
+        sp_mul_core(nparts, part, mat.col_indices().data(), mat.row_ptr().data(), T(1), mat.values().data(), vec.data(), T(0), vr.data());
+    });
+    return vr;
+}
+
+template<typename T, size_t C, typename I>
+inline auto operator*(const SpSellMat<T, C, I>& mat, const DynVec<T>& vec) noexcept -> DynVec<T> {
+    auto [n, m] = mat.shape();
+    assert(m == vec.size());
+    auto vr = DynVec<T>::uninit(n);
+    mul(static_cast<T>(1.0), mat, vec, static_cast<T>(0.0), vr);
+    return vr;
+}
+
+template<typename T, size_t B, typename I>
+inline auto operator*(const SpBsrMat<T, B, I>& mat, const DynVec<T>& vec) noexcept -> DynVec<T> {
     auto [n, m] = mat.shape();
     assert(m == vec.size());
     auto vr = DynVec<T>::uninit(n);
-    _sp_mul_core(n, mat.col_indices().data(), mat.row_ptr().data(), 1.0, mat.values().data(), vec.data(), 0.0, vr.data());
+    mul(static_cast<T>(1.0), mat, vec, static_cast<T>(0.0), vr);
     return vr;
 }
 
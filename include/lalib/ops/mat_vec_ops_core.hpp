@@ -18,6 +18,13 @@
 #include <complex>
 #include <algorithm>
 #include <memory>
+#include "vec_ops_core.hpp"
+#include "ops_traits.hpp"
+#include "isa.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #ifdef LALIB_BLAS_BACKEND
 #include <cblas.h>
@@ -25,39 +32,386 @@
 
 namespace lalib {
 
+// ==== Dense products ==== //
+// The rows are processed four at a time, so that each element of `x` (or of `y` for the transposed product) is loaded 
+// once per four rows and the four partial results stay in registers. The columns are split into blocks of 
+// `__GEMV_COL_BLOCK` elements, whose part of `x` (or `y`) stays in L1 while the rows of a chunk sweep it.
+
+/// @brief  The number of columns in a block of the dense matrix-vector products, 16 KiB of `T`
 template<typename T>
-inline auto __mul_core_simd(size_t n, size_t m, T alpha, const T* mat, const T* x, T beta, T* y) noexcept -> T* {
-    // If the pointers of the multiplier and one storing the result are the same
-    if (x == y) {
-        auto tmp = std::make_unique<T[]>(n);
-        #pragma omp simd
-        for (auto i = 0u; i < n; ++i) {
-            tmp[i] = beta * y[i];
-            for (auto k = 0u; k < m; ++k) {
-                tmp[i] += alpha * mat[i * m + k] * x[k];
+constexpr size_t __GEMV_COL_BLOCK = 16384 / sizeof(T);
+
+/// @brief  The number of rows in a chunk distributed to a thread by the dense matrix-vector product
+constexpr size_t __GEMV_ROW_CHUNK = 64;
+
+/// @brief  Returns a buffer of at least `size` elements owned by the calling thread. It is reallocated only when it grows.
+template<typename T>
+inline auto _gemv_scratch(size_t size) -> T* {
+    thread_local auto buffer = std::unique_ptr<T[]>();
+    thread_local auto capacity = size_t(0);
+    if (capacity < size) {
+        buffer = std::make_unique<T[]>(size);
+        capacity = size;
+    }
+    return buffer.get();
+}
+
+/// @brief  Performs `yout[i] <- alpha * (mat * x)[i] + beta * yin[i]` for the `n` rows of a row-major `n` x `m` matrix.
+/// @details    `yout` may be `yin` but must not overlap `x`. `yout` is overwritten if `beta` is zero, as BLAS does.
+template<typename T>
+inline void __gemv_rows(size_t n, size_t m, T alpha, const T* mat, const T* x, T beta, const T* yin, T* yout) noexcept {
+    for (auto i = size_t(0); i < n; ++i) {
+        yout[i] = beta == T{} ? T{} : beta * yin[i];
+    }
+    constexpr auto CB = __GEMV_COL_BLOCK<T>;
+    for (auto kb = size_t(0); kb < m; kb += CB) {
+        auto kc = std::min(CB, m - kb);
+        const auto* xb = x + kb;
+        auto i = size_t(0);
+        for (; i + 4 <= n; i += 4) {
+            const auto* r0 = mat + i * m + kb;
+            const auto* r1 = r0 + m;
+            const auto* r2 = r1 + m;
+            const auto* r3 = r2 + m;
+            auto s0 = T{}, s1 = T{}, s2 = T{}, s3 = T{};
+            if constexpr (std::is_arithmetic_v<T>) {
+                #pragma omp simd reduction(+:s0, s1, s2, s3)
+                for (auto k = size_t(0); k < kc; ++k) {
+                    auto xk = xb[k];
+                    s0 += r0[k] * xk;
+                    s1 += r1[k] * xk;
+                    s2 += r2[k] * xk;
+                    s3 += r3[k] * xk;
+                }
+            } else {
+                // OpenMP reductions do not support complex numbers
+                for (auto k = size_t(0); k < kc; ++k) {
+                    auto xk = xb[k];
+                    s0 += r0[k] * xk;
+                    s1 += r1[k] * xk;
+                    s2 += r2[k] * xk;
+                    s3 += r3[k] * xk;
+                }
             }
+            yout[i] += alpha * s0;
+            yout[i + 1] += alpha * s1;
+            yout[i + 2] += alpha * s2;
+            yout[i + 3] += alpha * s3;
         }
-        std::copy(tmp.get(), tmp.get() + n, y);
-    } 
-    else {
-        #pragma omp simd
-        for (auto i = 0u; i < n; ++i) {
-            y[i] = beta * y[i];
-            for (auto k = 0u; k < m; ++k) {
-                y[i] += alpha * mat[i * m + k] * x[k];
+        for (; i < n; ++i) {
+            const auto* r0 = mat + i * m + kb;
+            auto s0 = T{};
+            if constexpr (std::is_arithmetic_v<T>) {
+                #pragma omp simd reduction(+:s0)
+                for (auto k = size_t(0); k < kc; ++k) {
+                    s0 += r0[k] * xb[k];
+                }
+            } else {
+                for (auto k = size_t(0); k < kc; ++k) {
+                    s0 += r0[k] * xb[k];
+                }
+            }
+            yout[i] += alpha * s0;
+        }
+    }
+}
+
+/// @brief  Performs `y <- y + sum_i coefs[i] * mat[i, :]` for the `n` rows of `m` columns of a row-major matrix with the leading dimension `ld`.
+template<typename T>
+inline void __gemv_trans_rows(size_t n, size_t m, size_t ld, const T* coefs, const T* mat, T* y) noexcept {
+    constexpr auto CB = __GEMV_COL_BLOCK<T>;
+    for (auto jb = size_t(0); jb < m; jb += CB) {
+        auto jc = std::min(CB, m - jb);
+        auto* yb = y + jb;
+        auto i = size_t(0);
+        for (; i + 4 <= n; i += 4) {
+            const auto* r0 = mat + i * ld + jb;
+            const auto* r1 = r0 + ld;
+            const auto* r2 = r1 + ld;
+            const auto* r3 = r2 + ld;
+            auto a0 = coefs[i], a1 = coefs[i + 1], a2 = coefs[i + 2], a3 = coefs[i + 3];
+            #pragma omp simd
+            for (auto j = size_t(0); j < jc; ++j) {
+                yb[j] += a0 * r0[j] + a1 * r1[j] + a2 * r2[j] + a3 * r3[j];
+            }
+        }
+        for (; i < n; ++i) {
+            const auto* r0 = mat + i * ld + jb;
+            auto a0 = coefs[i];
+            #pragma omp simd
+            for (auto j = size_t(0); j < jc; ++j) {
+                yb[j] += a0 * r0[j];
             }
         }
     }
+}
+
+LALIB_ISA_VARIANTS(__gemv_rows_isa, __gemv_rows)
+LALIB_ISA_VARIANTS(__gemv_trans_rows_isa, __gemv_trans_rows)
+
+/// @brief  Performs `y <- alpha * mat * x + beta * y` for a row-major `n` x `m` matrix.
+/// @details    Large products are distributed to the threads by chunks of `__GEMV_ROW_CHUNK` rows. Each row is summed 
+///             in the same order in any case, so the result does not depend on the number of threads. `x` may be `y`.
+template<typename T>
+inline auto __gemv_core(size_t n, size_t m, T alpha, const T* mat, const T* x, T beta, T* y) -> T* {
+    // If the pointers of the multiplier and one storing the result are the same
+    auto* out = x == y ? _gemv_scratch<T>(n) : y;
+
+    if (_use_parallel<T>(Kernel::MatVec, n * m)) {
+        auto nchunks = (n + __GEMV_ROW_CHUNK - 1) / __GEMV_ROW_CHUNK;
+        #pragma omp parallel for schedule(static)
+        for (auto c = size_t(0); c < nchunks; ++c) {
+            auto begin = c * __GEMV_ROW_CHUNK;
+            auto rows = std::min(__GEMV_ROW_CHUNK, n - begin);
+            __gemv_rows_isa(rows, m, alpha, mat + begin * m, x, beta, y + begin, out + begin);
+        }
+    } else {
+        __gemv_rows_isa(n, m, alpha, mat, x, beta, y, out);
+    }
+    if (out != y) {
+        std::copy(out, out + n, y);
+    }
     return y;
 }
 
+/// @brief  Performs `y <- alpha * mat^T * x + beta * y` for a row-major `n` x `m` matrix without forming the transpose.
+/// @details    The rows are streamed once. A wide matrix is distributed to the threads by blocks of columns, and a tall 
+///             one by chunks of rows, each thread accumulating into its own partial vector which are then summed in 
+///             thread order. With `LALIB_REPRODUCIBLE_REDUCTIONS`, the columns are always split, so that the result 
+///             does not depend on the number of threads. `x` may be `y`.
 template<typename T>
-inline auto _sp_mul_core(size_t n, const size_t* col_ids, const size_t* row_ptr, T alpha, const T* mat, const T* x, T beta, T* y) noexcept -> T* {
-    #pragma omp simd
+inline auto __gemv_trans_core(size_t n, size_t m, T alpha, const T* mat, const T* x, T beta, T* y) -> T* {
+    auto nthreads = size_t(1);
+    #ifdef _OPENMP
+    if (_use_parallel<T>(Kernel::MatVec, n * m)) {
+        nthreads = static_cast<size_t>(omp_get_max_threads());
+    }
+    #endif
+    auto col_split = nthreads == 1 || m >= nthreads * __GEMV_COL_BLOCK<T>;
+    #if defined(LALIB_REPRODUCIBLE_REDUCTIONS)
+    col_split = true;
+    #endif
+
+    // The coefficients `alpha * x`, followed by the partial vectors of the threads for the row split
+    auto* coefs = _gemv_scratch<T>(n + (col_split ? 0 : nthreads * m));
+    auto* partial = coefs + n;
+    for (auto i = size_t(0); i < n; ++i) {
+        coefs[i] = alpha * x[i];
+    }
+    // `y` may be `x`, which has already been read into `coefs`
+    for (auto j = size_t(0); j < m; ++j) {
+        y[j] = beta == T{} ? T{} : beta * y[j];
+    }
+
+    if (nthreads == 1) {
+        __gemv_trans_rows_isa(n, m, m, coefs, mat, y);
+    } else if (col_split) {
+        auto nblocks = (m + __GEMV_COL_BLOCK<T> - 1) / __GEMV_COL_BLOCK<T>;
+        #pragma omp parallel for schedule(static)
+        for (auto b = size_t(0); b < nblocks; ++b) {
+            auto jb = b * __GEMV_COL_BLOCK<T>;
+            __gemv_trans_rows_isa(n, std::min(__GEMV_COL_BLOCK<T>, m - jb), m, coefs, mat + jb, y + jb);
+        }
+    }
+    #ifdef _OPENMP
+    else {
+        #pragma omp parallel num_threads(nthreads)
+        {
+            auto t = static_cast<size_t>(omp_get_thread_num());
+            auto p = static_cast<size_t>(omp_get_num_threads());
+            auto begin = n * t / p, end = n * (t + 1) / p;
+            auto* part = partial + t * m;
+            std::fill(part, part + m, T{});
+            __gemv_trans_rows_isa(end - begin, m, m, coefs + begin, mat + begin * m, part);
+
+            #pragma omp barrier
+            #pragma omp for schedule(static)
+            for (auto j = size_t(0); j < m; ++j) {
+                auto sum = y[j];
+                for (auto q = size_t(0); q < p; ++q) {
+                    sum += partial[q * m + j];
+                }
+                y[j] = sum;
+            }
+        }
+    }
+    #endif
+    return y;
+}
+
+template<typename T, typename I>
+inline auto _sp_mul_core(size_t n, const I* col_ids, const I* row_ptr, T alpha, const T* mat, const T* x, T beta, T* y) noexcept -> T* {
     for (auto i = 0u; i < n; ++i) {
-        y[i] = beta * y[i];
+        auto sum = T{};
         for (auto k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
-            y[i] += alpha * mat[k] * x[col_ids[k]];
+            sum += mat[k] * x[col_ids[k]];
+        }
+        y[i] = (beta == T{} ? T{} : beta * y[i]) + alpha * sum;
+    }
+    return y;
+}
+
+/// @brief      Performs CSR matrix-vector multiplication in parallel over row chunks.
+/// @details    Each chunk `[part[p], part[p + 1])` is processed by one thread, so `part` should balance the non-zero elements 
+///             rather than the rows (see `SpMat::row_partition`).
+/// @param nparts   the number of row chunks
+/// @param part     an array of `nparts + 1` row boundaries
+template<typename T, typename I>
+inline auto _sp_mul_core_parallel(size_t nparts, const size_t* part, const I* col_ids, const I* row_ptr, T alpha, const T* mat, const T* x, T beta, T* y) noexcept -> T* {
+    #pragma omp parallel for schedule(static, 1)
+    for (auto p = 0u; p < nparts; ++p) {
+        _sp_mul_core(part[p + 1] - part[p], col_ids, row_ptr + part[p], alpha, mat, x, beta, y + part[p]);
+    }
+    return y;
+}
+
+/// @brief      Returns the number of row chunks to use for a CSR matrix-vector multiplication with `nnz` non-zero elements.
+/// @details    Products smaller than the threshold of `Kernel::SpMatVec`, products requested inside a parallel region 
+///             and those in a `SerialRegion` run serially.
+template<typename T>
+inline auto _sp_mul_nparts(size_t nnz) noexcept -> size_t {
+    #ifdef _OPENMP
+    if (!_use_parallel<T>(Kernel::SpMatVec, nnz)) { return 1; }
+    return static_cast<size_t>(omp_get_max_threads());
+    #else
+    (void)nnz;
+    return 1;
+    #endif
+}
+
+/// @brief      Sums `term(k)` for `k` in `[begin, begin + size)` with the compensated or the pairwise summation.
+template<typename A, typename F>
+inline auto _sum_accurate(size_t begin, size_t size, const F& term, Summation summation) noexcept -> A {
+    if (summation == Summation::Pairwise) {
+        return __sum_pairwise<A>(begin, size, term);
+    }
+    auto sum = A{}, comp = A{};
+    __sum_compensated(begin, size, term, sum, comp);
+    return sum + comp;
+}
+
+/// @brief      Performs dense matrix-vector multiplication accumulating each row with an accurate summation.
+/// @details    The rows of `float` matrices are accumulated in `double`. `y` is overwritten if `beta` is zero, as BLAS does.
+/// @param summation    `Summation::Compensated` or `Summation::Pairwise`
+template<typename T>
+inline auto _mul_core_accurate(size_t n, size_t m, T alpha, const T* mat, const T* x, T beta, T* y, Summation summation) -> T* {
+    using A = typename __AccurateAcc<T>::type;
+    // If the pointers of the multiplier and one storing the result are the same
+    auto tmp = x == y ? std::make_unique<T[]>(n) : nullptr;
+    auto* out = tmp ? tmp.get() : y;
+
+    #pragma omp parallel for schedule(static) if(_use_parallel<T>(Kernel::MatVec, n * m))
+    for (auto i = size_t(0); i < n; ++i) {
+        const auto* row = mat + i * m;
+        auto sum = _sum_accurate<A>(0, m, [=](size_t k) { return A(row[k]) * A(x[k]); }, summation);
+        out[i] = (beta == T{} ? T{} : beta * y[i]) + alpha * static_cast<T>(sum);
+    }
+    if (tmp) {
+        std::copy(tmp.get(), tmp.get() + n, y);
+    }
+    return y;
+}
+
+/// @brief      Performs CSR matrix-vector multiplication accumulating each row with an accurate summation.
+/// @details    The rows of `float` matrices are accumulated in `double`. The chunks are distributed as `_sp_mul_core_parallel` does.
+///             `y` is overwritten if `beta` is zero, as BLAS does.
+/// @param summation    `Summation::Compensated` or `Summation::Pairwise`
+template<typename T, typename I>
+inline auto _sp_mul_core_accurate(size_t nparts, const size_t* part, const I* col_ids, const I* row_ptr, T alpha, const T* mat, const T* x, T beta, T* y, Summation summation) noexcept -> T* {
+    using A = typename __AccurateAcc<T>::type;
+    #pragma omp parallel for schedule(static, 1) if(nparts > 1)
+    for (auto p = size_t(0); p < nparts; ++p) {
+        for (auto i = part[p]; i < part[p + 1]; ++i) {
+            auto sum = _sum_accurate<A>(row_ptr[i], row_ptr[i + 1] - row_ptr[i], [=](size_t k) { return A(mat[k]) * A(x[col_ids[k]]); }, summation);
+            y[i] = (beta == T{} ? T{} : beta * y[i]) + alpha * static_cast<T>(sum);
+        }
+    }
+    return y;
+}
+
+/// @brief      Performs SELL-C-sigma matrix-vector multiplication.
+/// @details    Each slice of `C` rows is stored column-major, so the inner loop runs over the `C` rows of a slice with SIMD lanes.
+///             `y` is overwritten if `beta` is zero, as BLAS does.
+/// @tparam C   the number of rows in a slice
+/// @param n        the number of rows
+/// @param nslices  the number of slices
+/// @param slice_ptr    an array of the offsets of each slice
+/// @param slice_len    an array of the width of each slice
+/// @param row_len  an array of the number of non-zero elements of each stored row
+/// @param perm     the row permutation. the `k`-th stored row is the `perm[k]`-th row of the matrix.
+/// @param parallel whether to distribute the slices over threads
+template<size_t C, typename T, typename I>
+inline auto _sp_sell_mul_core(size_t n, size_t nslices, const size_t* slice_ptr, const size_t* slice_len, const size_t* row_len, const I* col_ids, const size_t* perm, T alpha, const T* mat, const T* x, T beta, T* y, bool parallel) noexcept -> T* {
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (auto s = 0u; s < nslices; ++s) {
+        T sum[C] = {};
+        auto offset = slice_ptr[s];
+        auto nrow = std::min(C, n - s * C);
+        size_t len[C] = {};
+        std::copy(row_len + s * C, row_len + s * C + nrow, len);
+        auto min_len = *std::min_element(len, len + C);
+        for (auto j = 0u; j < min_len; ++j) {
+            #pragma omp simd
+            for (auto r = 0u; r < C; ++r) {
+                sum[r] += mat[offset + j * C + r] * x[col_ids[offset + j * C + r]];
+            }
+        }
+        // The padding is masked out rather than multiplied by zero, which would turn an infinite `x` into NaN.
+        // The rows are sorted by their length, so that few columns of a slice contain padding.
+        for (auto j = min_len; j < slice_len[s]; ++j) {
+            #pragma omp simd
+            for (auto r = 0u; r < C; ++r) {
+                auto prod = mat[offset + j * C + r] * x[col_ids[offset + j * C + r]];
+                sum[r] += j < len[r] ? prod : T{};
+            }
+        }
+
+        for (auto r = 0u; r < nrow; ++r) {
+            auto i = perm[s * C + r];
+            y[i] = (beta == T{} ? T{} : beta * y[i]) + alpha * sum[r];
+        }
+    }
+    return y;
+}
+
+/// @brief      Accumulates the product of a `B` x `B` row-major block and a vector, `y <- y + a x`.
+/// @details    The block size is known at compile time, so the loops are fully unrolled into registers.
+template<size_t B, typename T>
+inline void _block_mul_acc(const T* a, const T* x, T* y) noexcept {
+    for (auto r = 0u; r < B; ++r) {
+        auto sum = T{};
+        if constexpr (std::is_arithmetic_v<T>) {
+            #pragma omp simd reduction(+:sum)
+            for (auto c = 0u; c < B; ++c) {
+                sum += a[r * B + c] * x[c];
+            }
+        } else {
+            // OpenMP reductions do not support complex numbers
+            for (auto c = 0u; c < B; ++c) {
+                sum += a[r * B + c] * x[c];
+            }
+        }
+        y[r] += sum;
+    }
+}
+
+/// @brief      Performs BSR matrix-vector multiplication.
+/// @details    `y` is overwritten if `beta` is zero, as BLAS does.
+/// @tparam B   the size of the blocks
+/// @param nb       the number of block rows
+/// @param col_ids  an array of the block column indices
+/// @param row_ptr  an array of the block row pointers
+/// @param parallel whether to distribute the block rows over threads
+template<size_t B, typename T, typename I>
+inline auto _sp_bsr_mul_core(size_t nb, const I* col_ids, const I* row_ptr, T alpha, const T* mat, const T* x, T beta, T* y, bool parallel) noexcept -> T* {
+    #pragma omp parallel for schedule(dynamic, 64) if(parallel)
+    for (auto bi = 0u; bi < nb; ++bi) {
+        T sum[B] = {};
+        for (auto k = row_ptr[bi]; k < row_ptr[bi + 1]; ++k) {
+            _block_mul_acc<B>(mat + k * B * B, x + col_ids[k] * B, sum);
+        }
+        for (auto r = 0u; r < B; ++r) {
+            y[bi * B + r] = (beta == T{} ? T{} : beta * y[bi * B + r]) + alpha * sum[r];
         }
     }
     return y;
@@ -65,7 +419,7 @@ inline auto _sp_mul_core(size_t n, const size_t* col_ids, const size_t* row_ptr,
 
 template<typename T>
 inline auto mul_core(size_t n, size_t m, T alpha, const T* mat, const T* x, T beta, T* y) noexcept -> T* {
-    __mul_core_simd(n, m, alpha, mat, x, beta, y);
+    __gemv_core(n, m, alpha, mat, x, beta, y);
     return y;
 }
 
@@ -74,13 +428,14 @@ inline auto mul_core<float>(size_t n, size_t m, float alpha, const float* mat, c
     #if defined(LALIB_BLAS_BACKEND)
     if (x == y) {
         auto tmp = std::make_unique<float[]>(n);
+        std::copy(y, y + n, tmp.get());
         cblas_sgemv(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, n, m, alpha, mat, std::max<size_t>(1u, m), x, 1, beta, tmp.get(), 1);
         std::copy(tmp.get(), tmp.get() + n, y);
     } else {
         cblas_sgemv(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, n, m, alpha, mat, std::max<size_t>(1u, m), x, 1, beta, y, 1);
     }
     #else
-    __mul_core_simd(n, m, alpha, mat, x, beta, y);
+    __gemv_core(n, m, alpha, mat, x, beta, y);
     #endif
     return y;
 }
@@ -90,23 +445,80 @@ inline auto mul_core<double>(size_t n, size_t m, double alpha, const double* mat
     #if defined(LALIB_BLAS_BACKEND)
     if (x == y) {
         auto tmp = std::make_unique<double[]>(n);
+        std::copy(y, y + n, tmp.get());
         cblas_dgemv(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, n, m, alpha, mat, std::max<size_t>(1u, m), x, 1, beta, tmp.get(), 1);
         std::copy(tmp.get(), tmp.get() + n, y);
     } else {
         cblas_dgemv(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasNoTrans, n, m, alpha, mat, std::max<size_t>(1u, m), x, 1, beta, y, 1);
     }
     #else
-    __mul_core_simd(n, m, alpha, mat, x, beta, y);
+    __gemv_core(n, m, alpha, mat, x, beta, y);
     #endif
     return y;
 }
 
+/// @brief      Performs transposed matrix-vector multiplication.
+/// @details    Performs `y <- alpha * mat^T * x + beta * y` for a row-major `n` x `m` matrix, returns `y`. 
+///             The transpose is not formed, and complex matrices are not conjugated. `y` is overwritten if `beta` is zero.
+/// @param n    the number of rows of `mat` and elements of `x`
+/// @param m    the number of columns of `mat` and elements of `y`
+/// @return     `y`
 template<typename T>
-inline auto sp_mul_core(size_t n, const size_t* col_ids, const size_t* row_ptr, T alpha, const T* mat, const T* x, T beta, T* y) noexcept -> T* {
+inline auto mul_trans_core(size_t n, size_t m, T alpha, const T* mat, const T* x, T beta, T* y) noexcept -> T* {
+    __gemv_trans_core(n, m, alpha, mat, x, beta, y);
+    return y;
+}
+
+template<>
+inline auto mul_trans_core<float>(size_t n, size_t m, float alpha, const float* mat, const float* x, float beta, float* y) noexcept -> float* {
+    #if defined(LALIB_BLAS_BACKEND)
+    if (x == y) {
+        auto tmp = std::make_unique<float[]>(m);
+        std::copy(y, y + m, tmp.get());
+        cblas_sgemv(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasTrans, n, m, alpha, mat, std::max<size_t>(1u, m), x, 1, beta, tmp.get(), 1);
+        std::copy(tmp.get(), tmp.get() + m, y);
+    } else {
+        cblas_sgemv(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasTrans, n, m, alpha, mat, std::max<size_t>(1u, m), x, 1, beta, y, 1);
+    }
+    #else
+    __gemv_trans_core(n, m, alpha, mat, x, beta, y);
+    #endif
+    return y;
+}
+
+template<>
+inline auto mul_trans_core<double>(size_t n, size_t m, double alpha, const double* mat, const double* x, double beta, double* y) noexcept -> double* {
+    #if defined(LALIB_BLAS_BACKEND)
+    if (x == y) {
+        auto tmp = std::make_unique<double[]>(m);
+        std::copy(y, y + m, tmp.get());
+        cblas_dgemv(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasTrans, n, m, alpha, mat, std::max<size_t>(1u, m), x, 1, beta, tmp.get(), 1);
+        std::copy(tmp.get(), tmp.get() + m, y);
+    } else {
+        cblas_dgemv(CBLAS_LAYOUT::CblasRowMajor, CBLAS_TRANSPOSE::CblasTrans, n, m, alpha, mat, std::max<size_t>(1u, m), x, 1, beta, y, 1);
+    }
+    #else
+    __gemv_trans_core(n, m, alpha, mat, x, beta, y);
+    #endif
+    return y;
+}
+
+template<typename T, typename I>
+inline auto sp_mul_core(size_t n, const I* col_ids, const I* row_ptr, T alpha, const T* mat, const T* x, T beta, T* y) noexcept -> T* {
     _sp_mul_core(n, col_ids, row_ptr, alpha, mat, x, beta, y);
     return y;
 }
 
+template<typename T, typename I>
+inline auto sp_mul_core(size_t nparts, const size_t* part, const I* col_ids, const I* row_ptr, T alpha, const T* mat, const T* x, T beta, T* y) noexcept -> T* {
+    if (nparts <= 1) {
+        _sp_mul_core(part[nparts], col_ids, row_ptr, alpha, mat, x, beta, y);
+    } else {
+        _sp_mul_core_parallel(nparts, part, col_ids, row_ptr, alpha, mat, x, beta, y);
+    }
+    return y;
+}
+
 }
 
 #endif
\ No newline at end of file
@@ -36,6 +36,21 @@ struct One<std::complex<T>> {
 };
 
 
+// === Summation === //
+
+/// @brief  Summation policy of the reductions
+enum class Summation {
+    /// the default of the build: the fastest order, unless `LALIB_REPRODUCIBLE_REDUCTIONS` is defined
+    Fast,
+    /// fixed-size blocks combined by a fixed tree, independent of the number of threads
+    Reproducible,
+    /// the compensated (Neumaier) summation. `float` terms are accumulated in `double`.
+    Compensated,
+    /// the pairwise summation. `float` terms are accumulated in `double`.
+    Pairwise,
+};
+
+
 // === Reciprocal === //
 
 template<typename T>
@@ -6,25 +6,36 @@
 #include "lalib/ops/vec_ops.hpp"
 #include <ranges>
 #include <concepts>
+#include <vector>
 
 namespace lalib::orth {
 
 /// @brief  Preforms the conventional Gram Schmidt (CGS) orthogonalization.
+/// @details    The projections of each vector onto the preceding ones are computed with the fused multi-vector kernels.
 template<std::ranges::random_access_range C>
 requires Vector<std::ranges::range_value_t<C>>
 inline void cgs(C& vecs) {
+    using T = typename std::ranges::range_value_t<C>::ElemType;
     auto n = vecs[0].size();
     auto m = vecs.size();
 
+    auto ptrs = std::vector<const T*>(m);
+    auto norms = std::vector<T>(m);
+    auto coefs = std::vector<T>(m);
+    ptrs[0] = vecs[0].data();
+    norms[0] = dot_core(vecs[0].data(), vecs[0].data(), n);
     for (auto j = 1u; j < m; ++j) {
-        assert(n == vecs[1].size());
-        auto vj = vecs[j];
+        assert(n == vecs[j].size());
+        mdot_core(vecs[j].data(), ptrs.data(), j, n, coefs.data());
         for (auto k = 0u; k < j; ++k) {
-            lalib::axpy(-lalib::dot(vecs[k], vj) / vecs[k].dot(vecs[k]), vecs[k], vecs[j]);
+            coefs[k] = -coefs[k] / norms[k];
         }
+        maxpy_core(coefs.data(), ptrs.data(), j, vecs[j].data(), n);
+
+        ptrs[j] = vecs[j].data();
+        norms[j] = dot_core(vecs[j].data(), vecs[j].data(), n);
     }
 }
-
 }
 
 #endif
\ No newline at end of file
@@ -6,15 +6,15 @@
 
 namespace lalib {
 
-template<typename T>
-inline auto operator+(const SpCooMat<T>& m1, const SpCooMat<T>& m2) noexcept -> SpCooMat<T> {
+template<typename T, typename I>
+inline auto operator+(const SpCooMat<T, I>& m1, const SpCooMat<T, I>& m2) noexcept -> SpCooMat<T, I> {
     auto mr = SpCooMat(m1);
     mr += m2;
     return mr;
 }
 
-template<typename T>
-inline auto operator-(const SpCooMat<T>& m1, const SpCooMat<T>& m2) noexcept -> SpCooMat<T> {
+template<typename T, typename I>
+inline auto operator-(const SpCooMat<T, I>& m1, const SpCooMat<T, I>& m2) noexcept -> SpCooMat<T, I> {
     auto mr = SpCooMat(m1);
     mr += -m2;
     return mr;
@@ -8,8 +8,11 @@
 #include "vec_ops_core.hpp"
 #include "ops_traits.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <cassert>
+#include <span>
+#include <type_traits>
 
 
 namespace lalib {
@@ -163,6 +166,29 @@ template<typename T>
 inline auto dot(const DynVec<T>& x, const DynVec<T>& y) noexcept -> T;
 
 
+/// @brief      Computes the dot products of a vector with several vectors at once, reading `x` only a few times.
+/// @tparam T   a type of element
+/// @param x    a vector
+/// @param ys   vectors of the same size as `x`
+/// @param r    an array storing the results, `r[j] = x . ys[j]`. the size must be `ys.size()`.
+/// @return     `r` (or a new vector storing the results)
+template<typename T>
+inline auto mdot(const DynVec<T>& x, std::type_identity_t<std::span<const DynVec<T>>> ys, std::type_identity_t<std::span<T>> r) -> std::span<T>;
+
+template<typename T>
+inline auto mdot(const DynVec<T>& x, std::type_identity_t<std::span<const DynVec<T>>> ys) -> DynVec<T>;
+
+
+/// @brief      Adds several scaled vectors to a vector at once, `y <- y + sum_j alphas[j] * xs[j]`, updating `y` only a few times.
+/// @tparam T   a type of element
+/// @param alphas   coefficients. the size must be `xs.size()`.
+/// @param xs   vectors of the same size as `y`
+/// @param y    a vector storing the result
+/// @return     `y`
+template<typename T>
+inline auto maxpy(std::type_identity_t<std::span<const T>> alphas, std::type_identity_t<std::span<const DynVec<T>>> xs, DynVec<T>& y) -> DynVec<T>&;
+
+
 template<typename T>
 inline auto cross(const SizedVec<T, 2>& x, const SizedVec<T, 2>& y) noexcept -> T;
 
@@ -248,7 +274,7 @@ template <typename T>
 auto neg(const DynVec<T> &v, DynVec<T>& vr) noexcept -> DynVec<T> &
 {
     __check_size(v.size(), vr.size());
-    __neg_core_simd(v.data(), vr.data(), v.size());
+    neg_core(v.data(), vr.data(), v.size());
     return vr;
 }
 
@@ -465,6 +491,63 @@ inline auto dot(const DynVec<T>& x, const DynVec<T>& y) noexcept -> T {
     return d;
 }
 
+template<typename T>
+inline auto dot(const DynVec<T>& x, const DynVec<T>& y, Summation summation) -> T {
+    __check_size(x.size(), y.size());
+    return dot_core(x.data(), y.data(), x.size(), summation);
+}
+
+
+// === NORM ============================================================== //
+
+template<typename T>
+inline auto norm2(const DynVec<T>& x, Summation summation = Summation::Fast) -> T {
+    return norm2_core(x.data(), x.size(), summation);
+}
+
+
+// === MULTI-VECTOR ============================================================== //
+
+/// @brief  The number of vectors passed to the multi-vector kernels at once
+constexpr size_t __MULTI_VEC_PTRS = 32;
+
+template<typename T>
+inline auto mdot(const DynVec<T>& x, std::type_identity_t<std::span<const DynVec<T>>> ys, std::type_identity_t<std::span<T>> r) -> std::span<T> {
+    __check_size(ys.size(), r.size());
+    const T* ptrs[__MULTI_VEC_PTRS];
+    for (auto j = size_t(0); j < ys.size(); j += __MULTI_VEC_PTRS) {
+        auto k = std::min(__MULTI_VEC_PTRS, ys.size() - j);
+        for (auto l = 0u; l < k; ++l) {
+            __check_size(x.size(), ys[j + l].size());
+            ptrs[l] = ys[j + l].data();
+        }
+        mdot_core(x.data(), ptrs, k, x.size(), r.data() + j);
+    }
+    return r;
+}
+
+template<typename T>
+inline auto mdot(const DynVec<T>& x, std::type_identity_t<std::span<const DynVec<T>>> ys) -> DynVec<T> {
+    auto r = DynVec<T>::uninit(ys.size());
+    mdot(x, ys, std::span<T>(r.data(), r.size()));
+    return r;
+}
+
+template<typename T>
+inline auto maxpy(std::type_identity_t<std::span<const T>> alphas, std::type_identity_t<std::span<const DynVec<T>>> xs, DynVec<T>& y) -> DynVec<T>& {
+    __check_size(alphas.size(), xs.size());
+    const T* ptrs[__MULTI_VEC_PTRS];
+    for (auto j = size_t(0); j < xs.size(); j += __MULTI_VEC_PTRS) {
+        auto k = std::min(__MULTI_VEC_PTRS, xs.size() - j);
+        for (auto l = 0u; l < k; ++l) {
+            __check_size(y.size(), xs[j + l].size());
+            ptrs[l] = xs[j + l].data();
+        }
+        maxpy_core(alphas.data() + j, ptrs, k, y.data(), y.size());
+    }
+    return y;
+}
+
 
 // === CROSS ============================================================== //
 
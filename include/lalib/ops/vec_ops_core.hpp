@@ -3,12 +3,28 @@
 #define LALIB_VEC_OPS_CORE_HPP
 
 #include <cstddef>
+#include <cmath>
 #include <complex>
+#include <limits>
+#include <type_traits>
+#include "ops_traits.hpp"
+#include "dispatch.hpp"
+#include "isa.hpp"
 
 #ifdef LALIB_BLAS_BACKEND
 #include <cblas.h>
 #endif
 
+// The serial kernels run on the active instruction set and the parallel ones on the baseline, so FMA contractions may
+// change the last bit of the results with the number of threads. Reproducible builds keep the serial kernels on the baseline.
+#if defined(LALIB_REPRODUCIBLE_REDUCTIONS)
+#define __VEC_ISA_VARIANTS(variant, kernel) \
+    template<typename... Args> \
+    inline auto variant(Args... args) { return kernel(args...); }
+#else
+#define __VEC_ISA_VARIANTS(variant, kernel) LALIB_ISA_VARIANTS(variant, kernel)
+#endif
+
 template<typename T>
 inline auto __neg_core_simd(const T* v, T* vr, size_t size) noexcept -> T* {
     #pragma omp simd
@@ -18,6 +34,8 @@ inline auto __neg_core_simd(const T* v, T* vr, size_t size) noexcept -> T* {
     return vr;
 }
 
+__VEC_ISA_VARIANTS(__neg_core_isa, __neg_core_simd)
+
 template<typename T>
 inline auto __neg_core_parallel(const T* v, T* vr, size_t size) noexcept -> T* {
     #pragma omp parallel for simd
@@ -27,6 +45,20 @@ inline auto __neg_core_parallel(const T* v, T* vr, size_t size) noexcept -> T* {
     return vr;
 }
 
+/// @brief      Performs negation of a vector.
+/// @details    Performs `vr <- -v`, returns `vr`
+/// @param v    a pointer to the head of the vector
+/// @param vr   a pointer to the head of the vector storing the result. it may be `v` itself.
+/// @param size number of elements in the vectors
+/// @return     `vr`
+template<typename T>
+inline auto neg_core(const T* v, T* vr, size_t size) noexcept -> T* {
+    if (lalib::_use_parallel<T>(lalib::Kernel::Neg, size)) {
+        return __neg_core_parallel(v, vr, size);
+    }
+    return __neg_core_isa(v, vr, size);
+}
+
 template<typename T>
 inline auto __add_core_simd(const T* v1, const T* v2, T* vr, size_t size) noexcept -> T* {
     #pragma omp simd
@@ -36,6 +68,8 @@ inline auto __add_core_simd(const T* v1, const T* v2, T* vr, size_t size) noexce
     return vr;
 }
 
+__VEC_ISA_VARIANTS(__add_core_isa, __add_core_simd)
+
 template<typename T>
 inline auto __add_core_parallel(const T* v1, const T* v2, T* vr, size_t size) noexcept -> T* {
     #pragma omp parallel for simd
@@ -64,8 +98,8 @@ inline auto __add_core_accelerator(const T* v1, const T* v2, T* vr, size_t size)
 /// @return     a vector resulted in this operation
 template<typename T>
 inline auto add_core(const T* v1, const T* v2, T* vr, size_t size) noexcept -> T* {
-    if (size < 16) {
-        __add_core_simd(v1, v2, vr, size);
+    if (!lalib::_use_parallel<T>(lalib::Kernel::Add, size)) {
+        __add_core_isa(v1, v2, vr, size);
     } else {
         #ifdef LALIB_USE_ACCELERATOR
         __add_core_accelerator(v1, v2, vr, size);
@@ -86,6 +120,8 @@ inline auto __sub_core_simd(const T* v1, const T* v2, T* vr, size_t size) noexce
     return vr;
 }
 
+__VEC_ISA_VARIANTS(__sub_core_isa, __sub_core_simd)
+
 template<typename T>
 inline auto __sub_core_parallel(const T* v1, const T* v2, T* vr, size_t size) noexcept -> T* {
     #pragma omp parallel for simd
@@ -114,8 +150,8 @@ inline auto __sub_core_accelerator(const T* v1, const T* v2, T* vr, size_t size)
 /// @return     a vector resulted in this operation
 template<typename T>
 inline auto sub_core(const T* v1, const T* v2, T* vr, size_t size) noexcept -> T* {
-    if (size < 16) {
-        __sub_core_simd(v1, v2, vr, size);
+    if (!lalib::_use_parallel<T>(lalib::Kernel::Sub, size)) {
+        __sub_core_isa(v1, v2, vr, size);
     } else {
         #ifdef LALIB_USE_ACCELERATOR
         __sub_core_accelerator(v1, v2, vr, size);
@@ -136,6 +172,8 @@ inline auto __axpy_core_simd(T alpha, const T* vx, T* vy, size_t size) noexcept
     return vy;
 }
 
+__VEC_ISA_VARIANTS(__axpy_core_isa, __axpy_core_simd)
+
 template<typename T>
 inline auto __axpy_core_parallel(T alpha, const T* vx, T* vy, size_t size) noexcept -> T* {
     #pragma omp parallel for simd
@@ -154,9 +192,22 @@ inline auto __axpy_core_accelerator(T alpha, const T* vx, T* vy, size_t size) no
     return vy;
 }
 
+/// @brief  Dispatches the axpy of the internal backend by the size of the vectors.
+template<typename T>
+inline auto __axpy_core_dispatch(T alpha, const T* vx, T* vy, size_t size) noexcept -> T* {
+    if (lalib::_use_parallel<T>(lalib::Kernel::Axpy, size)) {
+        #ifdef LALIB_USE_ACCELERATOR
+        return __axpy_core_accelerator(alpha, vx, vy, size);
+        #else
+        return __axpy_core_parallel(alpha, vx, vy, size);
+        #endif
+    }
+    return __axpy_core_isa(alpha, vx, vy, size);
+}
+
 template<typename T>
 inline auto axpy_core(T alpha, const T* vx, T* vy, size_t size) noexcept -> T* {
-    __axpy_core_simd(alpha, vx, vy, size);
+    __axpy_core_dispatch(alpha, vx, vy, size);
     return vy;
 }
 
@@ -165,7 +216,7 @@ inline auto axpy_core<float>(float alpha, const float* vx, float* vy, size_t siz
     #ifdef LALIB_BLAS_BACKEND
     cblas_saxpy(size, alpha, vx, 1, vy, 1);
     #else
-    __axpy_core_simd(alpha, vx, vy, size);
+    __axpy_core_dispatch(alpha, vx, vy, size);
     #endif
     return vy;
 }
@@ -175,7 +226,7 @@ inline auto axpy_core<double>(double alpha, const double* vx, double* vy, size_t
     #ifdef LALIB_BLAS_BACKEND
     cblas_daxpy(size, alpha, vx, 1, vy, 1);
     #else
-    __axpy_core_simd(alpha, vx, vy, size);
+    __axpy_core_dispatch(alpha, vx, vy, size);
     #endif
     return vy;
 }
@@ -185,7 +236,7 @@ inline auto axpy_core<std::complex<float>>(std::complex<float> alpha, const std:
     #ifdef LALIB_BLAS_BACKEND
     cblas_caxpy(size, &alpha, vx, 1, vy, 1);
     #else
-    __axpy_core_simd(alpha, vx, vy, size);
+    __axpy_core_dispatch(alpha, vx, vy, size);
     #endif
     return vy;
 }
@@ -195,7 +246,7 @@ inline auto axpy_core<std::complex<double>>(std::complex<double> alpha, const st
     #ifdef LALIB_BLAS_BACKEND
     cblas_zaxpy(size, &alpha, vx, 1, vy, 1);
     #else
-    __axpy_core_simd(alpha, vx, vy, size);
+    __axpy_core_dispatch(alpha, vx, vy, size);
     #endif
     return vy;
 }
@@ -205,27 +256,182 @@ inline auto axpy_core<std::complex<double>>(std::complex<double> alpha, const st
 
 template<typename T>
 inline auto __dot_core_simd(const T* v1, const T* v2, size_t size) -> T {
-    auto r = v1[0] * v2[0];
+    auto r = T{};
     #pragma omp simd reduction(+:r)
-    for (auto i = 1u; i < size; ++i) {
+    for (auto i = 0u; i < size; ++i) {
         r += v1[i] * v2[i];
     }
     return r;
 }
 
+// OpenMP reductions do not support complex numbers, so the real and imaginary parts are accumulated separately.
+template<typename T>
+inline auto __dot_core_simd(const std::complex<T>* v1, const std::complex<T>* v2, size_t size) -> std::complex<T> {
+    const auto* a = reinterpret_cast<const T*>(v1);
+    const auto* b = reinterpret_cast<const T*>(v2);
+    auto re = T{}, im = T{};
+    #pragma omp simd reduction(+:re, im)
+    for (auto i = 0u; i < size; ++i) {
+        re += a[2 * i] * b[2 * i] - a[2 * i + 1] * b[2 * i + 1];
+        im += a[2 * i] * b[2 * i + 1] + a[2 * i + 1] * b[2 * i];
+    }
+    return std::complex<T>(re, im);
+}
+
+__VEC_ISA_VARIANTS(__dot_core_isa, __dot_core_simd)
+
+template<typename T>
+inline auto __dot_core_parallel(const T* v1, const T* v2, size_t size) -> T {
+    auto r = T{};
+    #pragma omp parallel for simd reduction(+:r)
+    for (auto i = 0u; i < size; ++i) {
+        r += v1[i] * v2[i];
+    }
+    return r;
+}
+
+template<typename T>
+inline auto __dot_core_parallel(const std::complex<T>* v1, const std::complex<T>* v2, size_t size) -> std::complex<T> {
+    const auto* a = reinterpret_cast<const T*>(v1);
+    const auto* b = reinterpret_cast<const T*>(v2);
+    auto re = T{}, im = T{};
+    #pragma omp parallel for simd reduction(+:re, im)
+    for (auto i = 0u; i < size; ++i) {
+        re += a[2 * i] * b[2 * i] - a[2 * i + 1] * b[2 * i + 1];
+        im += a[2 * i] * b[2 * i + 1] + a[2 * i + 1] * b[2 * i];
+    }
+    return std::complex<T>(re, im);
+}
+
+// ==== Reproducible reductions ==== //
+// The vectors are split into blocks whose size depends only on the number of elements. Each block is summed with a fixed
+// set of lanes, and the partial sums are combined by a fixed binary tree, so that the result does not depend on
+// the number of threads, the scheduling, or the alignment of the vectors.
+
+/// @brief  The minimum number of elements in a block of the reproducible reductions
+constexpr size_t __REPRODUCIBLE_BLOCK = 1024;
+
+/// @brief  The maximum number of blocks of the reproducible reductions
+constexpr size_t __REPRODUCIBLE_MAX_BLOCKS = 1024;
+
+/// @brief  The number of independent accumulators in a block of the reproducible reductions
+constexpr size_t __REPRODUCIBLE_LANES = 8;
+
+template<typename T>
+inline auto __tree_sum_inplace(T* partial, size_t n) noexcept -> T {
+    for (auto stride = size_t(1); stride < n; stride *= 2) {
+        for (auto b = size_t(0); b + stride < n; b += 2 * stride) {
+            partial[b] += partial[b + stride];
+        }
+    }
+    return n > 0 ? partial[0] : T{};
+}
+
+template<typename T>
+inline auto __dot_block_reproducible(const T* v1, const T* v2, size_t size) noexcept -> T {
+    T acc[__REPRODUCIBLE_LANES] = {};
+    auto i = size_t(0);
+    for (; i + __REPRODUCIBLE_LANES <= size; i += __REPRODUCIBLE_LANES) {
+        #pragma omp simd
+        for (auto l = 0u; l < __REPRODUCIBLE_LANES; ++l) {
+            acc[l] += v1[i + l] * v2[i + l];
+        }
+    }
+    for (auto l = 0u; i < size; ++i, ++l) {
+        acc[l] += v1[i] * v2[i];
+    }
+    return __tree_sum_inplace(acc, __REPRODUCIBLE_LANES);
+}
+
+template<typename T>
+inline auto __dot_block_reproducible(const std::complex<T>* v1, const std::complex<T>* v2, size_t size) noexcept -> std::complex<T> {
+    const auto* a = reinterpret_cast<const T*>(v1);
+    const auto* b = reinterpret_cast<const T*>(v2);
+    T re[__REPRODUCIBLE_LANES] = {};
+    T im[__REPRODUCIBLE_LANES] = {};
+    auto i = size_t(0);
+    for (; i + __REPRODUCIBLE_LANES <= size; i += __REPRODUCIBLE_LANES) {
+        #pragma omp simd
+        for (auto l = 0u; l < __REPRODUCIBLE_LANES; ++l) {
+            auto k = 2 * (i + l);
+            re[l] += a[k] * b[k] - a[k + 1] * b[k + 1];
+            im[l] += a[k] * b[k + 1] + a[k + 1] * b[k];
+        }
+    }
+    for (auto l = 0u; i < size; ++i, ++l) {
+        re[l] += a[2 * i] * b[2 * i] - a[2 * i + 1] * b[2 * i + 1];
+        im[l] += a[2 * i] * b[2 * i + 1] + a[2 * i + 1] * b[2 * i];
+    }
+    return std::complex<T>(__tree_sum_inplace(re, __REPRODUCIBLE_LANES), __tree_sum_inplace(im, __REPRODUCIBLE_LANES));
+}
+
+/// @brief  Calls `block(b, begin, len)` for each of the blocks of `size` elements, in parallel if `parallel` is true.
+/// @return the number of the blocks, at most `__REPRODUCIBLE_MAX_BLOCKS`
+template<typename F>
+inline auto __for_each_block(size_t size, bool parallel, F block) -> size_t {
+    auto len = (size + __REPRODUCIBLE_MAX_BLOCKS - 1) / __REPRODUCIBLE_MAX_BLOCKS;
+    len = len < __REPRODUCIBLE_BLOCK ? __REPRODUCIBLE_BLOCK : len;
+    auto nblocks = (size + len - 1) / len;
+
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (auto b = size_t(0); b < nblocks; ++b) {
+        auto begin = b * len;
+        block(b, begin, size - begin < len ? size - begin : len);
+    }
+    return nblocks;
+}
+
+/// @brief  Sums `block_sum(begin, len)` over the blocks of `size` elements in a reproducible order.
+template<typename T, typename F>
+inline auto __reduce_reproducible(size_t size, bool parallel, F block_sum) -> T {
+    T partial[__REPRODUCIBLE_MAX_BLOCKS];
+    auto nblocks = __for_each_block(size, parallel, [&](size_t b, size_t begin, size_t len) {
+        partial[b] = block_sum(begin, len);
+    });
+    return __tree_sum_inplace(partial, nblocks);
+}
+
+/// @brief  Computes the dot product whose result is independent of the number of threads.
+template<typename T>
+inline auto __dot_core_reproducible(const T* v1, const T* v2, size_t size) -> T {
+    auto parallel = lalib::_use_parallel<T>(lalib::Kernel::Dot, size);
+    return __reduce_reproducible<T>(size, parallel, [=](size_t begin, size_t len) {
+        return __dot_block_reproducible(v1 + begin, v2 + begin, len);
+    });
+}
+
+/// @brief  Dispatches the dot product of the internal backend by the size of the vectors.
+template<typename T>
+inline auto __dot_core_dispatch(const T* v1, const T* v2, size_t size) -> T {
+    #if defined(LALIB_REPRODUCIBLE_REDUCTIONS)
+    return __dot_core_reproducible(v1, v2, size);
+    #else
+    if (!lalib::_use_parallel<T>(lalib::Kernel::Dot, size)) {
+        return __dot_core_isa(v1, v2, size);
+    } else {
+        return __dot_core_parallel(v1, v2, size);
+    }
+    #endif
+}
+
+/// @brief      Computes the dot product of two vectors (without conjugation for complex numbers).
+/// @details    With `LALIB_REPRODUCIBLE_REDUCTIONS`, the result does not depend on the number of threads.
+/// @param v1   a pointer to the head of the first vector
+/// @param v2   a pointer to the head of the second vector
+/// @param size number of elements in the vectors
+/// @return     the dot product
 template<typename T>
 inline auto dot_core(const T* v1, const T* v2, size_t size) -> T {
-    __dot_core_simd(v1, v2, size);
-    return v2;
+    return __dot_core_dispatch(v1, v2, size);
 }
 
 template<>
 inline auto dot_core<float>(const float* v1, const float* v2, size_t size) -> float {
     float d;
-    #if defined(LALIB_BLAS_BACKEND)
+    #if defined(LALIB_BLAS_BACKEND) && !defined(LALIB_REPRODUCIBLE_REDUCTIONS)
     d = cblas_sdot(size, v1, 1, v2, 1);
     #else
-    d = __dot_core_simd(v1, v2, size);
+    d = __dot_core_dispatch(v1, v2, size);
     #endif
     return d;
 }
@@ -233,14 +439,353 @@ inline auto dot_core<float>(const float* v1, const float* v2, size_t size) -> fl
 template<>
 inline auto dot_core<double>(const double* v1, const double* v2, size_t size) -> double {
     double d;
-    #if defined(LALIB_BLAS_BACKEND)
+    #if defined(LALIB_BLAS_BACKEND) && !defined(LALIB_REPRODUCIBLE_REDUCTIONS)
     d = cblas_ddot(size, v1, 1, v2, 1);
     #else
-    d = __dot_core_simd(v1, v2, size);
+    d = __dot_core_dispatch(v1, v2, size);
     #endif
     return d;
 }
 
+template<>
+inline auto dot_core<std::complex<float>>(const std::complex<float>* v1, const std::complex<float>* v2, size_t size) -> std::complex<float> {
+    std::complex<float> d;
+    #if defined(LALIB_BLAS_BACKEND) && !defined(LALIB_REPRODUCIBLE_REDUCTIONS)
+    cblas_cdotu_sub(size, v1, 1, v2, 1, &d);
+    #else
+    d = __dot_core_dispatch(v1, v2, size);
+    #endif
+    return d;
+}
+
+template<>
+inline auto dot_core<std::complex<double>>(const std::complex<double>* v1, const std::complex<double>* v2, size_t size) -> std::complex<double> {
+    std::complex<double> d;
+    #if defined(LALIB_BLAS_BACKEND) && !defined(LALIB_REPRODUCIBLE_REDUCTIONS)
+    cblas_zdotu_sub(size, v1, 1, v2, 1, &d);
+    #else
+    d = __dot_core_dispatch(v1, v2, size);
+    #endif
+    return d;
+}
+
+
+// ==== Accurate reductions ==== //
+// Compensated (Neumaier) and pairwise summations of the terms `term(i)`. The terms are accumulated in 
+// `__AccurateAcc<T>::type`, which is `double` for `float`, so that the products of `float` elements are exact and 
+// the reductions of `float` vectors get the accuracy of `double` at the bandwidth of `float`. The products of the
+// other types are rounded before the summation. Both summations run over the blocks of the reproducible reductions,
+// so that their results do not depend on the number of threads either.
+
+/// @brief  The type accumulating the terms of the accurate reductions
+template<typename T>
+struct __AccurateAcc { using type = T; };
+
+template<>
+struct __AccurateAcc<float> { using type = double; };
+
+/// @brief  The maximum number of terms summed directly by the pairwise summation
+constexpr size_t __PAIRWISE_BASE = 128;
+
+/// @brief  Adds `x` to `sum` keeping the rounding error in `comp` (the Neumaier variant of the Kahan summation).
+template<typename A>
+inline void __neumaier_add(A& sum, A& comp, A x) noexcept {
+    // Selecting the operands instead of the expressions keeps the loops free of branches
+    auto sum_larger = std::abs(sum) >= std::abs(x);
+    auto large = sum_larger ? sum : x;
+    auto small = sum_larger ? x : sum;
+    auto t = sum + x;
+    comp += (large - t) + small;
+    sum = t;
+}
+
+/// @brief  Accumulates `term(i)` for `i` in `[begin, begin + size)` into `sum` and `comp` with independent lanes.
+template<typename A, typename F>
+inline void __sum_compensated(size_t begin, size_t size, const F& term, A& sum, A& comp) noexcept {
+    A s[__REPRODUCIBLE_LANES] = {};
+    A c[__REPRODUCIBLE_LANES] = {};
+    auto i = begin;
+    auto end = begin + size;
+    for (; i + __REPRODUCIBLE_LANES <= end; i += __REPRODUCIBLE_LANES) {
+        #pragma omp simd
+        for (auto l = 0u; l < __REPRODUCIBLE_LANES; ++l) {
+            __neumaier_add(s[l], c[l], term(i + l));
+        }
+    }
+    for (auto l = 0u; i < end; ++i, ++l) {
+        __neumaier_add(s[l], c[l], term(i));
+    }
+    for (auto l = 0u; l < __REPRODUCIBLE_LANES; ++l) {
+        __neumaier_add(sum, comp, s[l]);
+        comp += c[l];
+    }
+}
+
+/// @brief  Sums `term(i)` for `i` in `[begin, begin + size)` by recursive halving.
+template<typename A, typename F>
+inline auto __sum_pairwise(size_t begin, size_t size, const F& term) noexcept -> A {
+    if (size > __PAIRWISE_BASE) {
+        auto half = size / 2;
+        return __sum_pairwise<A>(begin, half, term) + __sum_pairwise<A>(begin + half, size - half, term);
+    }
+    A s[__REPRODUCIBLE_LANES] = {};
+    auto i = begin;
+    auto end = begin + size;
+    for (; i + __REPRODUCIBLE_LANES <= end; i += __REPRODUCIBLE_LANES) {
+        #pragma omp simd
+        for (auto l = 0u; l < __REPRODUCIBLE_LANES; ++l) {
+            s[l] += term(i + l);
+        }
+    }
+    for (auto l = 0u; i < end; ++i, ++l) {
+        s[l] += term(i);
+    }
+    return __tree_sum_inplace(s, __REPRODUCIBLE_LANES);
+}
+
+/// @brief  Does nothing on a block of the accurate reductions.
+struct __NoBlockVisit {
+    void operator()(size_t, size_t, size_t) const noexcept {}
+};
+
+/// @brief  Sums `term(i)` by the compensated summation over the blocks, calling `visit(b, begin, len)` after each block.
+template<typename A, typename F, typename G = __NoBlockVisit>
+inline auto __reduce_compensated(size_t size, bool parallel, const F& term, const G& visit = G{}) -> A {
+    A sums[__REPRODUCIBLE_MAX_BLOCKS];
+    A comps[__REPRODUCIBLE_MAX_BLOCKS];
+    auto nblocks = __for_each_block(size, parallel, [&](size_t b, size_t begin, size_t len) {
+        sums[b] = A{};
+        comps[b] = A{};
+        __sum_compensated(begin, len, term, sums[b], comps[b]);
+        visit(b, begin, len);
+    });
+    auto sum = A{}, comp = A{};
+    for (auto b = size_t(0); b < nblocks; ++b) {
+        __neumaier_add(sum, comp, sums[b]);
+        comp += comps[b];
+    }
+    return sum + comp;
+}
+
+/// @brief  Sums `term(i)` by the pairwise summation over the blocks, calling `visit(b, begin, len)` after each block.
+template<typename A, typename F, typename G = __NoBlockVisit>
+inline auto __reduce_pairwise(size_t size, bool parallel, const F& term, const G& visit = G{}) -> A {
+    A partial[__REPRODUCIBLE_MAX_BLOCKS];
+    auto nblocks = __for_each_block(size, parallel, [&](size_t b, size_t begin, size_t len) {
+        partial[b] = __sum_pairwise<A>(begin, len, term);
+        visit(b, begin, len);
+    });
+    return __tree_sum_inplace(partial, nblocks);
+}
+
+/// @brief  Computes the dot product by the compensated summation.
+template<typename T>
+inline auto __dot_core_compensated(const T* v1, const T* v2, size_t size) -> T {
+    using A = typename __AccurateAcc<T>::type;
+    return static_cast<T>(__reduce_compensated<A>(size, lalib::_use_parallel<T>(lalib::Kernel::Dot, size), [=](size_t i) { return A(v1[i]) * A(v2[i]); }));
+}
+
+template<typename T>
+inline auto __dot_core_compensated(const std::complex<T>* v1, const std::complex<T>* v2, size_t size) -> std::complex<T> {
+    using A = typename __AccurateAcc<T>::type;
+    const auto* a = reinterpret_cast<const T*>(v1);
+    const auto* b = reinterpret_cast<const T*>(v2);
+    auto parallel = lalib::_use_parallel<std::complex<T>>(lalib::Kernel::Dot, size);
+    auto re = __reduce_compensated<A>(size, parallel, [=](size_t i) { return A(a[2 * i]) * A(b[2 * i]) - A(a[2 * i + 1]) * A(b[2 * i + 1]); });
+    auto im = __reduce_compensated<A>(size, parallel, [=](size_t i) { return A(a[2 * i]) * A(b[2 * i + 1]) + A(a[2 * i + 1]) * A(b[2 * i]); });
+    return std::complex<T>(static_cast<T>(re), static_cast<T>(im));
+}
+
+/// @brief  Computes the dot product by the pairwise summation.
+template<typename T>
+inline auto __dot_core_pairwise(const T* v1, const T* v2, size_t size) -> T {
+    using A = typename __AccurateAcc<T>::type;
+    return static_cast<T>(__reduce_pairwise<A>(size, lalib::_use_parallel<T>(lalib::Kernel::Dot, size), [=](size_t i) { return A(v1[i]) * A(v2[i]); }));
+}
+
+template<typename T>
+inline auto __dot_core_pairwise(const std::complex<T>* v1, const std::complex<T>* v2, size_t size) -> std::complex<T> {
+    using A = typename __AccurateAcc<T>::type;
+    const auto* a = reinterpret_cast<const T*>(v1);
+    const auto* b = reinterpret_cast<const T*>(v2);
+    auto parallel = lalib::_use_parallel<std::complex<T>>(lalib::Kernel::Dot, size);
+    auto re = __reduce_pairwise<A>(size, parallel, [=](size_t i) { return A(a[2 * i]) * A(b[2 * i]) - A(a[2 * i + 1]) * A(b[2 * i + 1]); });
+    auto im = __reduce_pairwise<A>(size, parallel, [=](size_t i) { return A(a[2 * i]) * A(b[2 * i + 1]) + A(a[2 * i + 1]) * A(b[2 * i]); });
+    return std::complex<T>(static_cast<T>(re), static_cast<T>(im));
+}
+
+/// @brief      Computes the dot product with a summation policy.
+/// @param summation    the summation policy. `Summation::Fast` is the same as `dot_core(v1, v2, size)`.
+template<typename T>
+inline auto dot_core(const T* v1, const T* v2, size_t size, lalib::Summation summation) -> T {
+    switch (summation) {
+    case lalib::Summation::Reproducible:
+        return __dot_core_reproducible(v1, v2, size);
+    case lalib::Summation::Compensated:
+        return __dot_core_compensated(v1, v2, size);
+    case lalib::Summation::Pairwise:
+        return __dot_core_pairwise(v1, v2, size);
+    default:
+        return dot_core(v1, v2, size);
+    }
+}
+
+
+// ==== Fused multi-vector operations ==== //
+// The vectors are processed four at a time, so that the shared vector is streamed once per four vectors 
+// instead of once per vector, and the four partial results stay in registers.
+
+template<typename T>
+inline auto __mdot_core_simd(const T* vx, const T* const* vys, size_t k, size_t size, T* r) noexcept -> T* {
+    auto j = size_t(0);
+    for (; j + 4 <= k; j += 4) {
+        const auto* y0 = vys[j];
+        const auto* y1 = vys[j + 1];
+        const auto* y2 = vys[j + 2];
+        const auto* y3 = vys[j + 3];
+        auto d0 = T{}, d1 = T{}, d2 = T{}, d3 = T{};
+        if constexpr (std::is_arithmetic_v<T>) {
+            #pragma omp simd reduction(+:d0, d1, d2, d3)
+            for (auto i = 0u; i < size; ++i) {
+                auto x = vx[i];
+                d0 += x * y0[i];
+                d1 += x * y1[i];
+                d2 += x * y2[i];
+                d3 += x * y3[i];
+            }
+        } else {
+            // OpenMP reductions do not support complex numbers
+            for (auto i = 0u; i < size; ++i) {
+                auto x = vx[i];
+                d0 += x * y0[i];
+                d1 += x * y1[i];
+                d2 += x * y2[i];
+                d3 += x * y3[i];
+            }
+        }
+        r[j] = d0; r[j + 1] = d1; r[j + 2] = d2; r[j + 3] = d3;
+    }
+    for (; j < k; ++j) {
+        r[j] = __dot_core_simd(vx, vys[j], size);
+    }
+    return r;
+}
+
+template<typename T>
+inline auto __maxpy_core_simd(const T* alphas, const T* const* vxs, size_t k, T* vy, size_t size) noexcept -> T* {
+    auto j = size_t(0);
+    for (; j + 4 <= k; j += 4) {
+        const auto* x0 = vxs[j];
+        const auto* x1 = vxs[j + 1];
+        const auto* x2 = vxs[j + 2];
+        const auto* x3 = vxs[j + 3];
+        auto a0 = alphas[j], a1 = alphas[j + 1], a2 = alphas[j + 2], a3 = alphas[j + 3];
+        #pragma omp simd
+        for (auto i = 0u; i < size; ++i) {
+            vy[i] += a0 * x0[i] + a1 * x1[i] + a2 * x2[i] + a3 * x3[i];
+        }
+    }
+    for (; j < k; ++j) {
+        const auto* x0 = vxs[j];
+        auto a0 = alphas[j];
+        #pragma omp simd
+        for (auto i = 0u; i < size; ++i) {
+            vy[i] += a0 * x0[i];
+        }
+    }
+    return vy;
+}
+
+__VEC_ISA_VARIANTS(__mdot_core_isa, __mdot_core_simd)
+__VEC_ISA_VARIANTS(__maxpy_core_isa, __maxpy_core_simd)
+
+/// @brief  The number of elements in a chunk distributed to a thread by the parallel multi-vector kernels
+constexpr size_t __MULTI_VEC_CHUNK = 4096;
+
+template<typename T>
+inline auto __mdot_core_parallel(const T* vx, const T* const* vys, size_t k, size_t size, T* r) noexcept -> T* {
+    for (auto j = 0u; j < k; ++j) {
+        r[j] = T{};
+    }
+    auto nchunks = (size + __MULTI_VEC_CHUNK - 1) / __MULTI_VEC_CHUNK;
+    #pragma omp parallel for schedule(static) reduction(+:r[:k])
+    for (auto c = size_t(0); c < nchunks; ++c) {
+        auto begin = c * __MULTI_VEC_CHUNK;
+        auto len = size - begin < __MULTI_VEC_CHUNK ? size - begin : __MULTI_VEC_CHUNK;
+        const T* ys[4];
+        T d[4];
+        for (auto j = size_t(0); j < k; j += 4) {
+            auto nj = k - j < 4 ? k - j : 4;
+            for (auto l = 0u; l < nj; ++l) { ys[l] = vys[j + l] + begin; }
+            __mdot_core_simd(vx + begin, ys, nj, len, d);
+            for (auto l = 0u; l < nj; ++l) { r[j + l] += d[l]; }
+        }
+    }
+    return r;
+}
+
+template<typename T>
+inline auto __maxpy_core_parallel(const T* alphas, const T* const* vxs, size_t k, T* vy, size_t size) noexcept -> T* {
+    auto nchunks = (size + __MULTI_VEC_CHUNK - 1) / __MULTI_VEC_CHUNK;
+    #pragma omp parallel for schedule(static)
+    for (auto c = size_t(0); c < nchunks; ++c) {
+        auto begin = c * __MULTI_VEC_CHUNK;
+        auto len = size - begin < __MULTI_VEC_CHUNK ? size - begin : __MULTI_VEC_CHUNK;
+        const T* xs[4];
+        for (auto j = size_t(0); j < k; j += 4) {
+            auto nj = k - j < 4 ? k - j : 4;
+            for (auto l = 0u; l < nj; ++l) { xs[l] = vxs[j + l] + begin; }
+            __maxpy_core_simd(alphas + j, xs, nj, vy + begin, len);
+        }
+    }
+    return vy;
+}
+
+/// @brief      Computes the dot products of a vector with `k` vectors at once.
+/// @details    Performs `r[j] <- vx . vys[j]` for `j < k`, reading `vx` once per four vectors. 
+///             Large vectors of real numbers are processed in parallel. With `LALIB_REPRODUCIBLE_REDUCTIONS`,
+///             each product is computed by the reproducible dot product instead.
+/// @param vx   a pointer to the head of the shared vector
+/// @param vys  an array of `k` pointers to the heads of the other vectors
+/// @param k    the number of the other vectors
+/// @param size the number of elements in each vector
+/// @param r    a pointer to the head of the array storing the `k` results
+/// @return     `r`
+template<typename T>
+inline auto mdot_core(const T* vx, const T* const* vys, size_t k, size_t size, T* r) noexcept -> T* {
+    #if defined(LALIB_REPRODUCIBLE_REDUCTIONS)
+    // Each product goes through the reproducible dot, so that the results match `dot_core` exactly
+    for (auto j = 0u; j < k; ++j) {
+        r[j] = __dot_core_reproducible(vx, vys[j], size);
+    }
+    return r;
+    #else
+    // OpenMP array reductions support arithmetic types only
+    if constexpr (std::is_arithmetic_v<T>) {
+        if (lalib::_use_parallel<T>(lalib::Kernel::MultiDot, size)) {
+            return __mdot_core_parallel(vx, vys, k, size, r);
+        }
+    }
+    return __mdot_core_isa(vx, vys, k, size, r);
+    #endif
+}
+
+/// @brief      Performs `k` axpy operations on a vector at once.
+/// @details    Performs `vy <- vy + sum_j alphas[j] * vxs[j]` for `j < k`, updating `vy` once per four vectors. 
+///             Large vectors are processed in parallel.
+/// @param alphas   a pointer to the head of the array of `k` coefficients
+/// @param vxs  an array of `k` pointers to the heads of the vectors to be added
+/// @param k    the number of the vectors to be added
+/// @param vy   a pointer to the head of the vector storing the result
+/// @param size the number of elements in each vector
+/// @return     `vy`
+template<typename T>
+inline auto maxpy_core(const T* alphas, const T* const* vxs, size_t k, T* vy, size_t size) noexcept -> T* {
+    if (lalib::_use_parallel<T>(lalib::Kernel::MultiAxpy, size)) {
+        return __maxpy_core_parallel(alphas, vxs, k, vy, size);
+    }
+    return __maxpy_core_isa(alphas, vxs, k, vy, size);
+}
 
 // ==== Crosses ==== //
 
@@ -282,9 +827,29 @@ inline auto __scal_core_simd(T alpha, T* v1, size_t size) -> T* {
     return v1;
 }
 
+__VEC_ISA_VARIANTS(__scal_core_isa, __scal_core_simd)
+
+template<typename T>
+inline auto __scal_core_parallel(T alpha, T* v1, size_t size) -> T* {
+    #pragma omp parallel for simd
+    for (auto i = 0u; i < size; ++i) {
+        v1[i] = alpha * v1[i];
+    }
+    return v1;
+}
+
+/// @brief  Dispatches the scaling of the internal backend by the size of the vector.
+template<typename T>
+inline auto __scal_core_dispatch(T alpha, T* v1, size_t size) -> T* {
+    if (lalib::_use_parallel<T>(lalib::Kernel::Scal, size)) {
+        return __scal_core_parallel(alpha, v1, size);
+    }
+    return __scal_core_isa(alpha, v1, size);
+}
+
 template<typename T>
 inline auto scal_core(T alpha, T* v1, size_t size) -> T* {
-    __scal_core_simd(alpha, v1, size);
+    __scal_core_dispatch(alpha, v1, size);
     return v1;
 }
 
@@ -293,7 +858,7 @@ inline auto scal_core<float>(float alpha, float* v1, size_t size) -> float* {
     #if defined(LALIB_BLAS_BACKEND)
     cblas_sscal(size, alpha, v1, 1);
     #else 
-    __scal_core_simd(alpha, v1, size);
+    __scal_core_dispatch(alpha, v1, size);
     #endif
     return v1;
 }
@@ -303,37 +868,344 @@ inline auto scal_core<double>(double alpha, double* v1, size_t size) -> double*
     #if defined(LALIB_BLAS_BACKEND)
     cblas_dscal(size, alpha, v1, 1);
     #else 
-    __scal_core_simd(alpha, v1, size);
+    __scal_core_dispatch(alpha, v1, size);
     #endif
     return v1;
 }
 
 
 // ==== Eucledian Norm ==== //
+// The plain sum of the squares is as fast as a dot product, and it is accurate unless it overflows or is so small
+// that the underflow of the squares matters. Only in such cases, the norm is recomputed in one pass with Blue's 
+// algorithm, as the reference BLAS does: the squares of the large, the medium and the small elements are accumulated
+// separately, the large and the small ones scaled towards 1, so that the sums neither overflow nor underflow.
+
+constexpr auto __floor_half(int e) noexcept -> int {
+    return e >= 0 ? e / 2 : -((1 - e) / 2);
+}
+
+constexpr auto __ceil_half(int e) noexcept -> int {
+    return -__floor_half(-e);
+}
+
+template<typename T>
+constexpr auto __pow2(int e) noexcept -> T {
+    auto r = T(1);
+    for (; e > 0; --e) { r *= T(2); }
+    for (; e < 0; ++e) { r /= T(2); }
+    return r;
+}
+
+/// @brief  The thresholds and the scaling factors of Blue's algorithm, as chosen by the reference BLAS `nrm2`
+template<typename T>
+struct __BlueNorm {
+    static constexpr int _min_exp = std::numeric_limits<T>::min_exponent;
+    static constexpr int _max_exp = std::numeric_limits<T>::max_exponent;
+    static constexpr int _digits = std::numeric_limits<T>::digits;
+
+    /// the elements below `tsml` are small
+    static constexpr T tsml = __pow2<T>(__ceil_half(_min_exp - 1));
+    /// the elements above `tbig` are large
+    static constexpr T tbig = __pow2<T>(__floor_half(_max_exp - _digits + 1));
+    /// the scaling factor of the small elements
+    static constexpr T ssml = __pow2<T>(-__floor_half(_min_exp - _digits));
+    /// the scaling factor of the large elements
+    static constexpr T sbig = __pow2<T>(-__ceil_half(_max_exp + _digits - 1));
+};
+
+/// @brief  The sums of the squares of Blue's algorithm
+template<typename T>
+struct __BlueSums {
+    T small = T{};
+    T medium = T{};
+    T big = T{};
+
+    auto operator+=(const __BlueSums<T>& other) noexcept -> __BlueSums<T>& {
+        this->small += other.small;
+        this->medium += other.medium;
+        this->big += other.big;
+        return *this;
+    }
+};
+
+/// @brief  Accumulates the square of `x` into one of the sums. NaN goes to the medium sum, so that it propagates.
+template<typename T>
+inline void __blue_accumulate(T x, T& small, T& medium, T& big) noexcept {
+    using B = __BlueNorm<T>;
+    auto ax = std::abs(x);
+    auto is_big = ax > B::tbig;
+    auto is_small = ax < B::tsml;
+    auto is_medium = !(is_big | is_small);
+    auto xb = ax * B::sbig;
+    auto xs = ax * B::ssml;
+    auto sq_big = xb * xb;
+    auto sq_small = xs * xs;
+    auto sq_medium = ax * ax;
+    big += is_big ? sq_big : T{};
+    small += is_small ? sq_small : T{};
+    medium += is_medium ? sq_medium : T{};
+}
+
+/// @brief  Combines the sums of the squares into the norm.
+template<typename T>
+inline auto __blue_combine(__BlueSums<T> sums) noexcept -> T {
+    using B = __BlueNorm<T>;
+    auto [small, medium, big] = sums;
+    if (big > T{}) {
+        // The small elements are negligible against the large ones
+        if (medium > T{} || std::isnan(medium)) {
+            big += (medium * B::sbig) * B::sbig;
+        }
+        return std::sqrt(big) / B::sbig;
+    }
+    if (small > T{}) {
+        if (medium > T{} || std::isnan(medium)) {
+            auto ymed = std::sqrt(medium);
+            auto ysml = std::sqrt(small) / B::ssml;
+            auto ymin = ysml > ymed ? ymed : ysml;
+            auto ymax = ysml > ymed ? ysml : ymed;
+            return ymax * std::sqrt(T(1) + (ymin / ymax) * (ymin / ymax));
+        }
+        return std::sqrt(small) / B::ssml;
+    }
+    return std::sqrt(medium);
+}
+
+/// @brief  Returns whether the plain sum of the squares of `size` elements is free of overflow and harmful underflow.
+template<typename T>
+inline auto __sumsq_is_safe(T sumsq, size_t size) noexcept -> bool {
+    // Each square loses less than `min()` by underflow, which is negligible against a large enough sum
+    constexpr auto tiny = std::numeric_limits<T>::min() / std::numeric_limits<T>::epsilon();
+    return sumsq <= std::numeric_limits<T>::max() && sumsq >= static_cast<T>(size) * tiny;
+}
+
+/// @brief  Gets the norm from the plain sum of the squares and the largest absolute value of the elements.
+/// @details    A zero vector, whose sum fails `__sumsq_is_safe`, is decided by `amax` without reading it again.
+/// @return whether `norm` is set. Otherwise Blue's algorithm is needed.
+template<typename T, typename A>
+inline auto __norm2_from_sumsq(A sumsq, T amax, size_t size, T& norm) noexcept -> bool {
+    if (sumsq == A{} && amax == T{}) {
+        norm = T{};
+        return true;
+    }
+    if (__sumsq_is_safe(sumsq, size)) {
+        norm = static_cast<T>(std::sqrt(sumsq));
+        return true;
+    }
+    return false;
+}
+
+/// @brief  Returns the largest absolute value of the elements. NaN is ignored.
+template<typename T>
+inline auto __max_abs_simd(const T* v1, size_t size) noexcept -> T {
+    auto r = T{};
+    #pragma omp simd reduction(max:r)
+    for (auto i = 0u; i < size; ++i) {
+        auto ax = std::abs(v1[i]);
+        r = ax > r ? ax : r;
+    }
+    return r;
+}
+
+template<typename T>
+inline auto __blue_sums_simd(const T* v1, size_t size) noexcept -> __BlueSums<T> {
+    auto small = T{}, medium = T{}, big = T{};
+    #pragma omp simd reduction(+:small, medium, big)
+    for (auto i = 0u; i < size; ++i) {
+        __blue_accumulate(v1[i], small, medium, big);
+    }
+    return __BlueSums<T>{ small, medium, big };
+}
+
+template<typename T>
+inline auto __blue_sums_parallel(const T* v1, size_t size) noexcept -> __BlueSums<T> {
+    auto small = T{}, medium = T{}, big = T{};
+    #pragma omp parallel for simd reduction(+:small, medium, big)
+    for (auto i = 0u; i < size; ++i) {
+        __blue_accumulate(v1[i], small, medium, big);
+    }
+    return __BlueSums<T>{ small, medium, big };
+}
 
 template<typename T>
 inline auto __norm2_core_simd(const T* v1, size_t size) -> T {
-    T r = 0;
-    #pragma omp simd reduction(+:r)
+    auto r = T{}, amax = T{};
+    #pragma omp simd reduction(+:r) reduction(max:amax)
     for (auto i = 0u; i < size; ++i) {
         r += v1[i] * v1[i];
+        auto ax = std::abs(v1[i]);
+        amax = ax > amax ? ax : amax;
+    }
+    auto norm = T{};
+    if (__norm2_from_sumsq(r, amax, size, norm)) {
+        return norm;
     }
-    return std::sqrt(r);
+    return __blue_combine(__blue_sums_simd(v1, size));
+}
+
+// The norm of a complex vector is the norm of the real vector of its real and imaginary parts.
+template<typename T>
+inline auto __norm2_core_simd(const std::complex<T>* v1, size_t size) -> std::complex<T> {
+    return std::complex<T>(__norm2_core_simd(reinterpret_cast<const T*>(v1), 2 * size));
+}
+
+__VEC_ISA_VARIANTS(__norm2_core_isa, __norm2_core_simd)
+
+template<typename T>
+inline auto __norm2_core_parallel(const T* v1, size_t size) -> T {
+    auto r = T{}, amax = T{};
+    #pragma omp parallel for simd reduction(+:r) reduction(max:amax)
+    for (auto i = 0u; i < size; ++i) {
+        r += v1[i] * v1[i];
+        auto ax = std::abs(v1[i]);
+        amax = ax > amax ? ax : amax;
+    }
+    auto norm = T{};
+    if (__norm2_from_sumsq(r, amax, size, norm)) {
+        return norm;
+    }
+    return __blue_combine(__blue_sums_parallel(v1, size));
+}
+
+template<typename T>
+inline auto __norm2_core_parallel(const std::complex<T>* v1, size_t size) -> std::complex<T> {
+    return std::complex<T>(__norm2_core_parallel(reinterpret_cast<const T*>(v1), 2 * size));
 }
 
+template<typename T>
+inline auto __blue_sums_block_reproducible(const T* v1, size_t size) noexcept -> __BlueSums<T> {
+    T small[__REPRODUCIBLE_LANES] = {};
+    T medium[__REPRODUCIBLE_LANES] = {};
+    T big[__REPRODUCIBLE_LANES] = {};
+    auto i = size_t(0);
+    for (; i + __REPRODUCIBLE_LANES <= size; i += __REPRODUCIBLE_LANES) {
+        #pragma omp simd
+        for (auto l = 0u; l < __REPRODUCIBLE_LANES; ++l) {
+            __blue_accumulate(v1[i + l], small[l], medium[l], big[l]);
+        }
+    }
+    for (auto l = 0u; i < size; ++i, ++l) {
+        __blue_accumulate(v1[i], small[l], medium[l], big[l]);
+    }
+    return __BlueSums<T>{ 
+        __tree_sum_inplace(small, __REPRODUCIBLE_LANES), 
+        __tree_sum_inplace(medium, __REPRODUCIBLE_LANES), 
+        __tree_sum_inplace(big, __REPRODUCIBLE_LANES) 
+    };
+}
+
+/// @brief  The sum of the squares and the largest absolute value of a block of the reproducible norm
+template<typename T>
+struct __SumsqMax {
+    T sumsq = T{};
+    T amax = T{};
+
+    auto operator+=(const __SumsqMax<T>& other) noexcept -> __SumsqMax<T>& {
+        this->sumsq += other.sumsq;
+        this->amax = other.amax > this->amax ? other.amax : this->amax;
+        return *this;
+    }
+};
+
+/// @brief  Computes the Euclidean norm whose result is independent of the number of threads.
+template<typename T>
+inline auto __norm2_core_reproducible(const T* v1, size_t size) -> T {
+    auto parallel = lalib::_use_parallel<T>(lalib::Kernel::Norm2, size);
+    // The maximum of a block is taken while the block is still in the cache
+    auto [r, amax] = __reduce_reproducible<__SumsqMax<T>>(size, parallel, [=](size_t begin, size_t len) {
+        return __SumsqMax<T>{ __dot_block_reproducible(v1 + begin, v1 + begin, len), __max_abs_simd(v1 + begin, len) };
+    });
+    auto norm = T{};
+    if (__norm2_from_sumsq(r, amax, size, norm)) {
+        return norm;
+    }
+    return __blue_combine(__reduce_reproducible<__BlueSums<T>>(size, parallel, [=](size_t begin, size_t len) {
+        return __blue_sums_block_reproducible(v1 + begin, len);
+    }));
+}
+
+template<typename T>
+inline auto __norm2_core_reproducible(const std::complex<T>* v1, size_t size) -> std::complex<T> {
+    return std::complex<T>(__norm2_core_reproducible(reinterpret_cast<const T*>(v1), 2 * size));
+}
+
+/// @brief  Computes the Euclidean norm by the compensated summation.
+template<typename T>
+inline auto __norm2_core_compensated(const T* v1, size_t size) -> T {
+    using A = typename __AccurateAcc<T>::type;
+    T maxes[__REPRODUCIBLE_MAX_BLOCKS];
+    auto nblocks = size_t(0);
+    auto r = __reduce_compensated<A>(size, lalib::_use_parallel<T>(lalib::Kernel::Norm2, size), [=](size_t i) { return A(v1[i]) * A(v1[i]); },
+        [&](size_t b, size_t begin, size_t len) {
+            maxes[b] = __max_abs_simd(v1 + begin, len);
+            if (begin + len == size) { nblocks = b + 1; }
+        });
+    auto norm = T{};
+    if (__norm2_from_sumsq(r, __max_abs_simd(maxes, nblocks), size, norm)) {
+        return norm;
+    }
+    return __norm2_core_reproducible(v1, size);
+}
+
+template<typename T>
+inline auto __norm2_core_compensated(const std::complex<T>* v1, size_t size) -> std::complex<T> {
+    return std::complex<T>(__norm2_core_compensated(reinterpret_cast<const T*>(v1), 2 * size));
+}
+
+/// @brief  Computes the Euclidean norm by the pairwise summation.
+template<typename T>
+inline auto __norm2_core_pairwise(const T* v1, size_t size) -> T {
+    using A = typename __AccurateAcc<T>::type;
+    T maxes[__REPRODUCIBLE_MAX_BLOCKS];
+    auto nblocks = size_t(0);
+    auto r = __reduce_pairwise<A>(size, lalib::_use_parallel<T>(lalib::Kernel::Norm2, size), [=](size_t i) { return A(v1[i]) * A(v1[i]); },
+        [&](size_t b, size_t begin, size_t len) {
+            maxes[b] = __max_abs_simd(v1 + begin, len);
+            if (begin + len == size) { nblocks = b + 1; }
+        });
+    auto norm = T{};
+    if (__norm2_from_sumsq(r, __max_abs_simd(maxes, nblocks), size, norm)) {
+        return norm;
+    }
+    return __norm2_core_reproducible(v1, size);
+}
+
+template<typename T>
+inline auto __norm2_core_pairwise(const std::complex<T>* v1, size_t size) -> std::complex<T> {
+    return std::complex<T>(__norm2_core_pairwise(reinterpret_cast<const T*>(v1), 2 * size));
+}
+
+/// @brief  Dispatches the Euclidean norm of the internal backend by the size of the vector.
+template<typename T>
+inline auto __norm2_core_dispatch(const T* v1, size_t size) -> T {
+    #if defined(LALIB_REPRODUCIBLE_REDUCTIONS)
+    return __norm2_core_reproducible(v1, size);
+    #else
+    if (!lalib::_use_parallel<T>(lalib::Kernel::Norm2, size)) {
+        return __norm2_core_isa(v1, size);
+    } else {
+        return __norm2_core_parallel(v1, size);
+    }
+    #endif
+}
+
+/// @brief      Computes the Euclidean norm of a vector.
+/// @details    With `LALIB_REPRODUCIBLE_REDUCTIONS`, the result does not depend on the number of threads.
+/// @param v1   a pointer to the head of the vector
+/// @param size number of elements in the vector
+/// @return     the norm. for complex numbers, the norm is stored in the real part.
 template<typename T>
 inline auto norm2_core(const T* v1, size_t size) -> T {
-    auto norm = __norm2_core_simd(v1, size);
-    return norm;
+    return __norm2_core_dispatch(v1, size);
 }
 
 template<>
 inline auto norm2_core<float>(const float* v1, size_t size) -> float {
     float norm = 0;
-    #if defined(LALIB_BLAS_BACKEND)    
+    #if defined(LALIB_BLAS_BACKEND) && !defined(LALIB_REPRODUCIBLE_REDUCTIONS)
     norm = cblas_snrm2(size, v1, 1);
     #else 
-    norm = __norm2_core_simd(v1, size);
+    norm = __norm2_core_dispatch(v1, size);
     #endif
     return norm;
 }
@@ -341,12 +1213,50 @@ inline auto norm2_core<float>(const float* v1, size_t size) -> float {
 template<>
 inline auto norm2_core<double>(const double* v1, size_t size) -> double {
     double norm = 0;
-    #if defined(LALIB_BLAS_BACKEND)    
+    #if defined(LALIB_BLAS_BACKEND) && !defined(LALIB_REPRODUCIBLE_REDUCTIONS)
     norm = cblas_dnrm2(size, v1, 1);
     #else 
-    norm = __norm2_core_simd(v1, size);
+    norm = __norm2_core_dispatch(v1, size);
+    #endif
+    return norm;
+}
+
+template<>
+inline auto norm2_core<std::complex<float>>(const std::complex<float>* v1, size_t size) -> std::complex<float> {
+    std::complex<float> norm = 0;
+    #if defined(LALIB_BLAS_BACKEND) && !defined(LALIB_REPRODUCIBLE_REDUCTIONS)
+    norm = cblas_scnrm2(size, v1, 1);
+    #else 
+    norm = __norm2_core_dispatch(v1, size);
+    #endif
+    return norm;
+}
+
+template<>
+inline auto norm2_core<std::complex<double>>(const std::complex<double>* v1, size_t size) -> std::complex<double> {
+    std::complex<double> norm = 0;
+    #if defined(LALIB_BLAS_BACKEND) && !defined(LALIB_REPRODUCIBLE_REDUCTIONS)
+    norm = cblas_dznrm2(size, v1, 1);
+    #else 
+    norm = __norm2_core_dispatch(v1, size);
     #endif
     return norm;
 }
 
+/// @brief      Computes the Euclidean norm with a summation policy.
+/// @param summation    the summation policy. `Summation::Fast` is the same as `norm2_core(v1, size)`.
+template<typename T>
+inline auto norm2_core(const T* v1, size_t size, lalib::Summation summation) -> T {
+    switch (summation) {
+    case lalib::Summation::Reproducible:
+        return __norm2_core_reproducible(v1, size);
+    case lalib::Summation::Compensated:
+        return __norm2_core_compensated(v1, size);
+    case lalib::Summation::Pairwise:
+        return __norm2_core_pairwise(v1, size);
+    default:
+        return norm2_core(v1, size);
+    }
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,209 @@
+#ifndef LALIB_SOLVER_BICGSTAB_HPP
+#define LALIB_SOLVER_BICGSTAB_HPP
+
+#include "lalib/ops/ops_traits.hpp"
+#include "lalib/ops/vec_ops_core.hpp"
+#include "lalib/vec/dyn_vec.hpp"
+#include "lalib/solver/ilu.hpp"
+#include "lalib/solver/linear_operator.hpp"
+#include "lalib/solver/preconditioner.hpp"
+#include "lalib/solver/solver_status.hpp"
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+
+namespace lalib::solver {
+
+/// @brief      Working memory of the BiCGSTAB solver, i.e. the seven vectors of the recurrence.
+/// @tparam T   a floating-point type
+template<typename T>
+struct BicgstabWorkspace {
+    /// @brief      Creates an empty workspace, which is sized on the first solve.
+    BicgstabWorkspace() noexcept = default;
+
+    /// @brief      Creates a workspace for systems of size `n`.
+    BicgstabWorkspace(size_t n) {
+        this->resize(n);
+    }
+
+    /// @brief      Reallocates the workspace if the size of the system differs.
+    void resize(size_t n) {
+        if (this->_r.size() == n) { return; }
+        for (auto v: { &this->_r, &this->_r0, &this->_p, &this->_v, &this->_ph, &this->_sh, &this->_t }) {
+            *v = lalib::DynVec<T>::uninit(n);
+        }
+    }
+
+private:
+    template<std::floating_point U, typename M, Preconditioner<U> P> friend struct Bicgstab;
+
+    lalib::DynVec<T> _r;
+    lalib::DynVec<T> _r0;
+    lalib::DynVec<T> _p;
+    lalib::DynVec<T> _v;
+    lalib::DynVec<T> _ph;
+    lalib::DynVec<T> _sh;
+    lalib::DynVec<T> _t;
+};
+
+
+/// @brief      Right-preconditioned BiCGSTAB solver for non-symmetric systems
+/// @details    The memory footprint is fixed to seven vectors of the size of the system. Each iteration applies the 
+///             operator and the preconditioner twice. The solver refers to the operator without copying it, so 
+///             the operator must outlive the solver.
+/// @tparam T   a floating-point type
+/// @tparam M   a linear operator type, i.e. a matrix or a matrix-free operator
+/// @tparam P   a preconditioner type. the ILU(0) factorization of the matrix by default.
+template<std::floating_point T, typename M, Preconditioner<T> P = Ilu<T, M>>
+struct Bicgstab {
+    /// @brief      Constructs a BiCGSTAB solver preconditioned by `P` built from the matrix
+    /// @param mat  a matrix
+    /// @param tol  a tolerance of the residual norm
+    /// @param max_iter the maximum number of the iterations. `0` means the size of the matrix.
+    Bicgstab(const M& mat, T tol, size_t max_iter = 0) requires internal::_BuildablePreconditioner<P, M>:
+        Bicgstab(mat, internal::_make_preconditioner<P>(mat), tol, max_iter) {}
+
+    /// @brief      Constructs a BiCGSTAB solver with a given preconditioner
+    /// @param mat  a linear operator
+    /// @param precond  a preconditioner
+    /// @param tol  a tolerance of the residual norm
+    /// @param max_iter the maximum number of the iterations. `0` means the size of the matrix.
+    Bicgstab(const M& mat, P precond, T tol, size_t max_iter = 0):
+        _mat(mat), _precond(std::move(precond)), _tol(tol), _max_iter(max_iter) {}
+
+    // The operator is referred to by the solver, so temporaries are rejected.
+    Bicgstab(const M&& mat, T tol, size_t max_iter = 0) = delete;
+    Bicgstab(const M&& mat, P precond, T tol, size_t max_iter = 0) = delete;
+
+    /// @brief      Gets the preconditioner
+    auto preconditioner() const noexcept -> const P& {
+        return this->_precond;
+    }
+
+    /// @brief      Solves a linear system
+    /// @param rhs  a right-hand side vector
+    /// @return     a solution vector
+    auto solve(const lalib::DynVec<T>& rhs) const -> lalib::DynVec<T>;
+
+    /// @brief      Solves a linear system from an initial guess
+    /// @param rhs  a right-hand side vector
+    /// @param x    an initial guess, and the solution vector after the operation
+    /// @return     the status of the solve. the residual is the norm of the true residual `b - A x`.
+    auto solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x) const -> SolverStatus<T>;
+
+    /// @brief      Solves a linear system from an initial guess with a reusable workspace
+    /// @param rhs  a right-hand side vector
+    /// @param x    an initial guess, and the solution vector after the operation
+    /// @param ws   a workspace. once sized for the system, the solve performs no heap allocation.
+    /// @return     the status of the solve. the residual is the norm of the true residual `b - A x`.
+    auto solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x, BicgstabWorkspace<T>& ws) const -> SolverStatus<T>;
+
+private:
+    const M& _mat;
+    const P _precond;
+    const T _tol;
+    const size_t _max_iter;
+};
+
+
+// === Implementation === //
+
+template<std::floating_point T, typename M, Preconditioner<T> P>
+auto Bicgstab<T, M, P>::solve(const lalib::DynVec<T>& rhs) const -> lalib::DynVec<T> {
+    auto x = lalib::DynVec<T>::filled(this->_mat.shape().first, Zero<T>::value());
+    this->solve(rhs, x);
+    return x;
+}
+
+template<std::floating_point T, typename M, Preconditioner<T> P>
+auto Bicgstab<T, M, P>::solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x) const -> SolverStatus<T> {
+    auto ws = BicgstabWorkspace<T>(this->_mat.shape().first);
+    return this->solve(rhs, x, ws);
+}
+
+template<std::floating_point T, typename M, Preconditioner<T> P>
+auto Bicgstab<T, M, P>::solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x, BicgstabWorkspace<T>& ws) const -> SolverStatus<T> {
+    auto n = this->_mat.shape().first;
+    auto max_iter = this->_max_iter == 0 ? n : this->_max_iter;
+    ws.resize(n);
+    auto& r = ws._r;
+    auto& r0 = ws._r0;
+    auto& p = ws._p;
+    auto& v = ws._v;
+    auto& ph = ws._ph;
+    auto& sh = ws._sh;
+    auto& t = ws._t;
+
+    // r = b - Ax, and the shadow residual r0 = r
+    internal::_residual(this->_mat, rhs, x, r);
+    auto status = SolverStatus<T>{ 0, std::sqrt(dot_core(r.data(), r.data(), n)), false };
+    if (status.residual < this->_tol) {
+        status.converged = true;
+        return status;
+    }
+    std::copy(r.begin(), r.end(), r0.begin());
+    std::fill(p.begin(), p.end(), Zero<T>::value());
+    std::fill(v.begin(), v.end(), Zero<T>::value());
+    auto rho = One<T>::value();
+    auto alpha = One<T>::value();
+    auto omega = One<T>::value();
+
+    while (status.iterations < max_iter) {
+        auto rho_next = dot_core(r0.data(), r.data(), n);
+        if (rho_next == Zero<T>::value()) { break; }    // breakdown
+
+        // p = r + beta (p - omega v)
+        auto beta = (rho_next / rho) * (alpha / omega);
+        rho = rho_next;
+        axpy_core(-omega, v.data(), p.data(), n);
+        scal_core(beta, p.data(), n);
+        axpy_core(One<T>::value(), r.data(), p.data(), n);
+
+        // Bi-CG step: v = A P^-1 p, and s = r - alpha v stored in r
+        this->_precond.apply(p, ph);
+        internal::_apply_operator(this->_mat, ph, v);
+        auto r0v = dot_core(r0.data(), v.data(), n);
+        if (r0v == Zero<T>::value()) { break; }         // breakdown
+        alpha = rho / r0v;
+        axpy_core(alpha, ph.data(), x.data(), n);
+        axpy_core(-alpha, v.data(), r.data(), n);
+        ++status.iterations;
+
+        status.residual = std::sqrt(dot_core(r.data(), r.data(), n));
+        if (status.residual < this->_tol) {
+            // Replaces the recurrence by the true residual, and goes on if it has not converged yet
+            status.residual = internal::_true_residual_norm(this->_mat, rhs, x, r);
+            if (status.residual < this->_tol) {
+                status.converged = true;
+                break;
+            }
+        }
+
+        // Stabilizing step: t = A P^-1 s, and the minimal residual along t
+        this->_precond.apply(r, sh);
+        internal::_apply_operator(this->_mat, sh, t);
+        auto tt = dot_core(t.data(), t.data(), n);
+        if (tt == Zero<T>::value()) { break; }
+        omega = dot_core(t.data(), r.data(), n) / tt;
+        axpy_core(omega, sh.data(), x.data(), n);
+        axpy_core(-omega, t.data(), r.data(), n);
+
+        status.residual = std::sqrt(dot_core(r.data(), r.data(), n));
+        if (status.residual < this->_tol) {
+            status.residual = internal::_true_residual_norm(this->_mat, rhs, x, r);
+            if (status.residual < this->_tol) {
+                status.converged = true;
+                break;
+            }
+        }
+        if (omega == Zero<T>::value()) { break; }       // stagnation
+    }
+
+    if (!status.converged) {
+        status.residual = internal::_true_residual_norm(this->_mat, rhs, x, r);
+    }
+    return status;
+}
+
+}
+#endif // LALIB_SOLVER_BICGSTAB_HPP
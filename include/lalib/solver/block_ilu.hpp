@@ -0,0 +1,180 @@
+#ifndef LALIB_SOLVER_BLOCK_ILU_HPP
+#define LALIB_SOLVER_BLOCK_ILU_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "lalib/mat.hpp"
+#include "lalib/vec.hpp"
+
+namespace lalib::solver {
+
+/// A structure providing the block incomplete LU(0) factorization of a BSR matrix.
+/// @details    The factors keep the block sparsity pattern of the matrix. The diagonal blocks of U are stored inverted,
+///             so that both the factorization and the substitutions only perform dense `B` x `B` block operations.
+/// @tparam T a floating-point type
+/// @tparam B the size of the blocks
+/// @tparam I an unsigned integer type of the block indices
+template<std::floating_point T, size_t B, std::unsigned_integral I = size_t>
+struct BlockIlu {
+    /// Constructs a block ILU(0) factorization of a matrix.
+    /// @param mat a BSR matrix
+    /// @throw std::runtime_error if a diagonal block is missing or singular
+    BlockIlu(SpBsrMat<T, B, I>&& mat);
+
+    /// Gets the decomposed matrix. The strictly lower blocks hold L (with unit diagonal blocks), and the others hold U.
+    /// @return the decomposed matrix
+    auto mat() const noexcept -> const SpBsrMat<T, B, I>& {
+        return this->_mat;
+    }
+
+    /// Solves a linear system.
+    /// @param rhs a right-hand side vector
+    /// @return a solution vector
+    auto solve(const lalib::DynVec<T>& rhs) const noexcept -> lalib::DynVec<T>;
+
+    /// Applies the factorization as a preconditioner, `out <- (LU)^-1 in`.
+    /// @param in an input vector
+    /// @param out a vector storing the result. it may be `in` itself.
+    void apply(const lalib::DynVec<T>& in, lalib::DynVec<T>& out) const noexcept;
+
+private:
+    SpBsrMat<T, B, I> _mat;
+    std::vector<size_t> _diag;
+    std::vector<SizedMat<T, B, B>> _diag_inv;
+};
+
+namespace internal {
+    /// `c <- c - a * b` for `B` x `B` row-major blocks
+    template<size_t B, typename T>
+    inline void _block_gemm_sub(const T* a, const T* b, T* c) noexcept {
+        for (auto i = 0u; i < B; ++i) {
+            for (auto k = 0u; k < B; ++k) {
+                auto aik = a[i * B + k];
+                #pragma omp simd
+                for (auto j = 0u; j < B; ++j) {
+                    c[i * B + j] -= aik * b[k * B + j];
+                }
+            }
+        }
+    }
+
+    /// `a <- a * b` for `B` x `B` row-major blocks
+    template<size_t B, typename T>
+    inline void _block_gemm_right(T* a, const T* b) noexcept {
+        T tmp[B * B] = {};
+        for (auto i = 0u; i < B; ++i) {
+            for (auto k = 0u; k < B; ++k) {
+                auto aik = a[i * B + k];
+                #pragma omp simd
+                for (auto j = 0u; j < B; ++j) {
+                    tmp[i * B + j] += aik * b[k * B + j];
+                }
+            }
+        }
+        std::copy(tmp, tmp + B * B, a);
+    }
+
+    template<size_t B, typename T, typename I>
+    auto _decomp_block_lu_inplace(SpBsrMat<T, B, I>& mat, std::vector<size_t>& diag, std::vector<SizedMat<T, B, B>>& diag_inv) -> bool {
+        const auto& row_ptr = mat.row_ptr();
+        const auto& col_ids = mat.col_indices();
+        auto nb = mat.block_shape().first;
+
+        diag.resize(nb);
+        diag_inv.assign(nb, SizedMat<T, B, B>::filled(Zero<T>::value()));
+
+        // Position of each block column in the current block row (`SIZE_MAX` if absent)
+        auto marker = std::vector<size_t>(mat.block_shape().second, SIZE_MAX);
+        for (auto i = 0u; i < nb; ++i) {
+            for (auto k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+                marker[col_ids[k]] = k;
+            }
+            if (marker[i] == SIZE_MAX) { return false; }
+            diag[i] = marker[i];
+
+            // Eliminate the lower blocks with the rows already factorized
+            for (auto k = row_ptr[i]; k < row_ptr[i + 1] && col_ids[k] < i; ++k) {
+                auto j = col_ids[k];
+                _block_gemm_right<B>(mat.block(k), diag_inv[j].data());
+                for (auto l = diag[j] + 1; l < row_ptr[j + 1]; ++l) {
+                    if (marker[col_ids[l]] != SIZE_MAX) {
+                        _block_gemm_sub<B>(mat.block(k), mat.block(l), mat.block(marker[col_ids[l]]));
+                    }
+                }
+            }
+
+            // Invert the diagonal block of U. The closed form for `B = 2` does not throw, so check the result as well.
+            auto d = SizedMat<T, B, B>::uninit();
+            std::copy(mat.block(diag[i]), mat.block(diag[i]) + B * B, d.data());
+            try {
+                invert(d, diag_inv[i]);
+            } catch (const std::runtime_error&) {
+                return false;
+            }
+            if (!std::all_of(diag_inv[i].data(), diag_inv[i].data() + B * B, [](T v) { return std::isfinite(v); })) {
+                return false;
+            }
+
+            for (auto k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+                marker[col_ids[k]] = SIZE_MAX;
+            }
+        }
+        return true;
+    }
+}
+
+template<std::floating_point T, size_t B, std::unsigned_integral I>
+BlockIlu<T, B, I>::BlockIlu(SpBsrMat<T, B, I>&& mat) : _mat(std::move(mat)) {
+    if (!internal::_decomp_block_lu_inplace(this->_mat, this->_diag, this->_diag_inv)) {
+        throw std::runtime_error("Matrix is singular.");
+    }
+}
+
+template<std::floating_point T, size_t B, std::unsigned_integral I>
+auto BlockIlu<T, B, I>::solve(const lalib::DynVec<T>& rhs) const noexcept -> lalib::DynVec<T> {
+    auto x = rhs;
+    this->apply(x, x);
+    return x;
+}
+
+template<std::floating_point T, size_t B, std::unsigned_integral I>
+void BlockIlu<T, B, I>::apply(const lalib::DynVec<T>& in, lalib::DynVec<T>& x) const noexcept {
+    const auto& row_ptr = this->_mat.row_ptr();
+    const auto& col_ids = this->_mat.col_indices();
+    auto nb = this->_mat.block_shape().first;
+
+    // Forward substitution with the unit lower blocks
+    if (&in != &x) {
+        std::copy(in.begin(), in.end(), x.begin());
+    }
+    for (auto i = 0u; i < nb; ++i) {
+        T sum[B] = {};
+        for (auto k = row_ptr[i]; k < this->_diag[i]; ++k) {
+            _block_mul_acc<B>(this->_mat.block(k), x.data() + col_ids[k] * B, sum);
+        }
+        for (auto r = 0u; r < B; ++r) {
+            x[i * B + r] -= sum[r];
+        }
+    }
+
+    // Backward substitution with the upper blocks
+    for (auto i = nb; i-- > 0;) {
+        T sum[B] = {};
+        for (auto k = this->_diag[i] + 1; k < row_ptr[i + 1]; ++k) {
+            _block_mul_acc<B>(this->_mat.block(k), x.data() + col_ids[k] * B, sum);
+        }
+        T y[B];
+        for (auto r = 0u; r < B; ++r) {
+            y[r] = x[i * B + r] - sum[r];
+            x[i * B + r] = Zero<T>::value();
+        }
+        _block_mul_acc<B>(this->_diag_inv[i].data(), y, x.data() + i * B);
+    }
+}
+
+}
+#endif // LALIB_SOLVER_BLOCK_ILU_HPP
@@ -0,0 +1,170 @@
+#ifndef LALIB_SOLVER_CG_HPP
+#define LALIB_SOLVER_CG_HPP
+
+#include "lalib/ops/ops_traits.hpp"
+#include "lalib/ops/vec_ops_core.hpp"
+#include "lalib/vec/dyn_vec.hpp"
+#include "lalib/solver/linear_operator.hpp"
+#include "lalib/solver/preconditioner.hpp"
+#include "lalib/solver/solver_status.hpp"
+#include <cmath>
+#include <concepts>
+
+namespace lalib::solver {
+
+/// @brief      Working memory of the CG solver, i.e. the four vectors of the recurrence.
+/// @tparam T   a floating-point type
+template<typename T>
+struct CgWorkspace {
+    /// @brief      Creates an empty workspace, which is sized on the first solve.
+    CgWorkspace() noexcept = default;
+
+    /// @brief      Creates a workspace for systems of size `n`.
+    CgWorkspace(size_t n) {
+        this->resize(n);
+    }
+
+    /// @brief      Reallocates the workspace if the size of the system differs.
+    void resize(size_t n) {
+        if (this->_r.size() == n) { return; }
+        this->_r = lalib::DynVec<T>::uninit(n);
+        this->_z = lalib::DynVec<T>::uninit(n);
+        this->_p = lalib::DynVec<T>::uninit(n);
+        this->_q = lalib::DynVec<T>::uninit(n);
+    }
+
+private:
+    template<std::floating_point U, typename M, Preconditioner<U> P> friend struct Cg;
+
+    lalib::DynVec<T> _r;
+    lalib::DynVec<T> _z;
+    lalib::DynVec<T> _p;
+    lalib::DynVec<T> _q;
+};
+
+
+/// @brief      Preconditioned conjugate gradient solver for symmetric positive definite systems
+/// @details    The memory footprint is fixed to four vectors of the size of the system, regardless of the number of 
+///             the iterations. The solver refers to the operator without copying it, so the operator must outlive 
+///             the solver.
+/// @tparam T   a floating-point type
+/// @tparam M   a linear operator type, i.e. a matrix or a matrix-free operator
+/// @tparam P   a symmetric positive definite preconditioner type. the Jacobi preconditioner by default.
+template<std::floating_point T, typename M, Preconditioner<T> P = JacobiPreconditioner<T>>
+struct Cg {
+    /// @brief      Constructs a CG solver preconditioned by `P` built from the matrix
+    /// @param mat  a symmetric positive definite matrix
+    /// @param tol  a tolerance of the residual norm
+    /// @param max_iter the maximum number of the iterations. `0` means the size of the matrix.
+    Cg(const M& mat, T tol, size_t max_iter = 0) requires std::constructible_from<P, const M&>:
+        Cg(mat, P(mat), tol, max_iter) {}
+
+    /// @brief      Constructs a CG solver with a given preconditioner
+    /// @param mat  a symmetric positive definite linear operator
+    /// @param precond  a symmetric positive definite preconditioner
+    /// @param tol  a tolerance of the residual norm
+    /// @param max_iter the maximum number of the iterations. `0` means the size of the matrix.
+    Cg(const M& mat, P precond, T tol, size_t max_iter = 0):
+        _mat(mat), _precond(std::move(precond)), _tol(tol), _max_iter(max_iter) {}
+
+    // The operator is referred to by the solver, so temporaries are rejected.
+    Cg(const M&& mat, T tol, size_t max_iter = 0) = delete;
+    Cg(const M&& mat, P precond, T tol, size_t max_iter = 0) = delete;
+
+    /// @brief      Gets the preconditioner
+    auto preconditioner() const noexcept -> const P& {
+        return this->_precond;
+    }
+
+    /// @brief      Solves a linear system
+    /// @param rhs  a right-hand side vector
+    /// @return     a solution vector
+    auto solve(const lalib::DynVec<T>& rhs) const -> lalib::DynVec<T>;
+
+    /// @brief      Solves a linear system from an initial guess
+    /// @param rhs  a right-hand side vector
+    /// @param x    an initial guess, and the solution vector after the operation
+    /// @return     the status of the solve. the residual is the norm of the (unpreconditioned) residual.
+    auto solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x) const -> SolverStatus<T>;
+
+    /// @brief      Solves a linear system from an initial guess with a reusable workspace
+    /// @param rhs  a right-hand side vector
+    /// @param x    an initial guess, and the solution vector after the operation
+    /// @param ws   a workspace. once sized for the system, the solve performs no heap allocation.
+    /// @return     the status of the solve. the residual is the norm of the (unpreconditioned) residual.
+    auto solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x, CgWorkspace<T>& ws) const -> SolverStatus<T>;
+
+private:
+    const M& _mat;
+    const P _precond;
+    const T _tol;
+    const size_t _max_iter;
+};
+
+
+// === Implementation === //
+
+template<std::floating_point T, typename M, Preconditioner<T> P>
+auto Cg<T, M, P>::solve(const lalib::DynVec<T>& rhs) const -> lalib::DynVec<T> {
+    auto x = lalib::DynVec<T>::filled(this->_mat.shape().first, Zero<T>::value());
+    this->solve(rhs, x);
+    return x;
+}
+
+template<std::floating_point T, typename M, Preconditioner<T> P>
+auto Cg<T, M, P>::solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x) const -> SolverStatus<T> {
+    auto ws = CgWorkspace<T>(this->_mat.shape().first);
+    return this->solve(rhs, x, ws);
+}
+
+template<std::floating_point T, typename M, Preconditioner<T> P>
+auto Cg<T, M, P>::solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x, CgWorkspace<T>& ws) const -> SolverStatus<T> {
+    auto n = this->_mat.shape().first;
+    auto max_iter = this->_max_iter == 0 ? n : this->_max_iter;
+    ws.resize(n);
+    auto& r = ws._r;
+    auto& z = ws._z;
+    auto& p = ws._p;
+    auto& q = ws._q;
+
+    // r = b - Ax, z = P^-1 r, p = z
+    internal::_residual(this->_mat, rhs, x, r);
+    auto status = SolverStatus<T>{ 0, std::sqrt(dot_core(r.data(), r.data(), n)), false };
+    if (status.residual < this->_tol) {
+        status.converged = true;
+        return status;
+    }
+    this->_precond.apply(r, z);
+    std::copy(z.begin(), z.end(), p.begin());
+    auto rz = dot_core(r.data(), z.data(), n);
+
+    while (status.iterations < max_iter) {
+        // q = Ap, and the step length along p
+        internal::_apply_operator(this->_mat, p, q);
+        auto pq = dot_core(p.data(), q.data(), n);
+        if (!(pq > Zero<T>::value())) { break; }     // not positive definite, or breakdown
+        auto alpha = rz / pq;
+
+        axpy_core(alpha, p.data(), x.data(), n);
+        axpy_core(-alpha, q.data(), r.data(), n);
+        ++status.iterations;
+
+        status.residual = std::sqrt(dot_core(r.data(), r.data(), n));
+        if (status.residual < this->_tol) {
+            status.converged = true;
+            break;
+        }
+
+        // p = z + beta p
+        this->_precond.apply(r, z);
+        auto rz_next = dot_core(r.data(), z.data(), n);
+        scal_core(rz_next / rz, p.data(), n);
+        axpy_core(One<T>::value(), z.data(), p.data(), n);
+        rz = rz_next;
+    }
+
+    return status;
+}
+
+}
+#endif // LALIB_SOLVER_CG_HPP
@@ -7,118 +7,340 @@
 #include "lalib/ops/vec_ops.hpp"
 #include "lalib/ops/mat_vec_ops.hpp"
 #include "lalib/solver/ilu.hpp"
+#include "lalib/solver/linear_operator.hpp"
+#include "lalib/solver/preconditioner.hpp"
+#include "lalib/solver/solver_status.hpp"
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <limits>
 #include <ranges>
 
 namespace lalib::solver {
 
-/// @brief      GMRES solver
+/// @brief      Working memory of the GMRES solver.
+/// @details    The Krylov basis, the Hessenberg matrix, the Givens rotations and the temporary vectors are kept 
+///             across solves, so that repeated solves of the same size do not allocate on the heap.
 /// @tparam T   a floating-point type
-/// @tparam M   a matrix type
-template<typename T, typename M>
+template<typename T>
+struct GmresWorkspace {
+    /// @brief      Creates an empty workspace, which is sized on the first solve.
+    GmresWorkspace() noexcept:
+        _hess(HessenbergMat<T>::with_capacity(0)), _r(DynUpperTriMat<T>::with_capacity(0)) {}
+
+    /// @brief      Creates a workspace for systems of size `n` with restart length `m`.
+    GmresWorkspace(size_t n, size_t m): GmresWorkspace() {
+        this->resize(n, m);
+    }
+
+    /// @brief      Reallocates the workspace if the size of the system or the restart length differs.
+    void resize(size_t n, size_t m) {
+        if (this->_n == n && this->_m == m) { return; }
+        this->_n = n;
+        this->_m = m;
+        this->_q.assign(m + 1, lalib::DynVec<T>::uninit(n));
+        this->_w = lalib::DynVec<T>::uninit(n);
+        this->_z = lalib::DynVec<T>::uninit(n);
+        this->_hess.reserve(m * (m + 3) / 2);
+        this->_r.reserve(m * (m + 1) / 2);
+        this->_c.reserve(m);
+        this->_s.reserve(m);
+        this->_beta.reserve(m + 1);
+        this->_coef.resize(m + 2);
+        this->_basis.resize(m + 2);
+        for (auto j = 0u; j <= m; ++j) {
+            this->_basis[j] = this->_q[j].data();
+        }
+    }
+
+private:
+    template<typename U, typename M, Preconditioner<U> P> friend struct Gmres;
+
+    size_t _n = 0;
+    size_t _m = 0;
+
+    std::vector<lalib::DynVec<T>> _q;
+    lalib::DynVec<T> _w;
+    lalib::DynVec<T> _z;
+    HessenbergMat<T> _hess;
+    DynUpperTriMat<T> _r;
+    std::vector<T> _c;
+    std::vector<T> _s;
+    std::vector<T> _beta;
+
+    // Coefficients and pointers to the basis vectors for the fused kernels
+    std::vector<T> _coef;
+    std::vector<const T*> _basis;
+};
+
+
+/// @brief      Orthogonalization schemes of the Arnoldi process in GMRES
+/// @details    Both schemes project against the whole basis with one fused multi-dot kernel and one fused multi-axpy 
+///             kernel per pass. `Cgs` is the classical Gram-Schmidt process with a single pass. `Cgs2` repeats the 
+///             pass once (reorthogonalization), which keeps the basis orthogonal to working precision, so that the 
+///             norm of the new vector is obtained from the reduction of the second pass by Pythagoras' theorem.
+enum class Orthogonalization { Cgs, Cgs2 };
+
+
+/// @brief      Restarted GMRES solver, GMRES(m)
+/// @details    After `restart` iterations, the solution is updated, and the method restarts from the new residual, 
+///             so that at most `restart + 1` basis vectors are kept.
+///             The solver refers to the operator without copying it, so the operator must outlive the solver.
+/// @tparam T   a floating-point type
+/// @tparam M   a linear operator type, i.e. a matrix or a matrix-free operator
+/// @tparam P   a preconditioner type. the ILU(0) factorization of the matrix by default.
+template<typename T, typename M, Preconditioner<T> P = Ilu<T, M>>
 struct Gmres {
-    /// @brief      Constructs a GMRES solver
+    /// @brief      Constructs a GMRES solver preconditioned by `P` built from a copy of the matrix
     /// @param mat  a matrix
     /// @param tol  a tolerance
-    Gmres(M&& mat, T tol): _mat(M(mat)), _lu(std::forward<M>(mat)), _tol(tol) {}
+    /// @param restart  the number of the iterations in a cycle. `0` means the size of the matrix (no restart).
+    /// @param max_iter the maximum number of the iterations in total. `0` means the size of the matrix.
+    /// @param side the side on which the preconditioner is applied
+    /// @param orth the orthogonalization scheme
+    Gmres(const M& mat, T tol, size_t restart = 0, size_t max_iter = 0, PrecondSide side = PrecondSide::Left,
+        Orthogonalization orth = Orthogonalization::Cgs) requires internal::_BuildablePreconditioner<P, M>:
+        Gmres(mat, internal::_make_preconditioner<P>(mat), tol, restart, max_iter, side, orth) {}
+
+    /// @brief      Constructs a GMRES solver with a given preconditioner
+    /// @param mat  a linear operator
+    /// @param precond  a preconditioner
+    /// @param tol  a tolerance
+    /// @param restart  the number of the iterations in a cycle. `0` means the size of the matrix (no restart).
+    /// @param max_iter the maximum number of the iterations in total. `0` means the size of the matrix.
+    /// @param side the side on which the preconditioner is applied
+    /// @param orth the orthogonalization scheme
+    Gmres(const M& mat, P precond, T tol, size_t restart = 0, size_t max_iter = 0, PrecondSide side = PrecondSide::Left,
+        Orthogonalization orth = Orthogonalization::Cgs): 
+        _mat(mat), _precond(std::move(precond)), _tol(tol), _restart(restart), _max_iter(max_iter), _side(side), _orth(orth) {}
+
+    // The operator is referred to by the solver, so temporaries are rejected.
+    Gmres(const M&& mat, T tol, size_t restart = 0, size_t max_iter = 0, PrecondSide side = PrecondSide::Left,
+        Orthogonalization orth = Orthogonalization::Cgs) = delete;
+    Gmres(const M&& mat, P precond, T tol, size_t restart = 0, size_t max_iter = 0, PrecondSide side = PrecondSide::Left,
+        Orthogonalization orth = Orthogonalization::Cgs) = delete;
+
+    /// @brief      Gets the preconditioner
+    auto preconditioner() const noexcept -> const P& {
+        return this->_precond;
+    }
 
     /// @brief      Solves a linear system
     /// @param rhs  a right-hand side vector
     /// @return     a solution vector
     auto solve(const lalib::DynVec<T>& rhs) const -> lalib::DynVec<T>;
 
+    /// @brief      Solves a linear system from an initial guess
+    /// @param rhs  a right-hand side vector
+    /// @param x    an initial guess, and the solution vector after the operation
+    /// @return     the status of the solve. the residual is the norm of the preconditioned residual for the left 
+    ///             preconditioning, and of the true residual for the right preconditioning.
+    auto solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x) const -> SolverStatus<T>;
+
+    /// @brief      Solves a linear system from an initial guess with a reusable workspace
+    /// @param rhs  a right-hand side vector
+    /// @param x    an initial guess, and the solution vector after the operation
+    /// @param ws   a workspace. once sized for the system, the solve performs no heap allocation.
+    /// @return     the status of the solve. the residual is the norm of the preconditioned residual for the left 
+    ///             preconditioning, and of the true residual for the right preconditioning.
+    auto solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x, GmresWorkspace<T>& ws) const -> SolverStatus<T>;
+
 private:
-    const M _mat;
-    const Ilu<T, M> _lu;
+    const M& _mat;
+    const P _precond;
     const T _tol;
+    const size_t _restart;
+    const size_t _max_iter;
+    const PrecondSide _side;
+    const Orthogonalization _orth;
 
-    void _arnoldi(std::vector<DynVec<T>>& q, HessenbergMat<T>& hess, T& h) const;
+    auto _cycle_length() const noexcept -> size_t;
+    void _arnoldi(GmresWorkspace<T>& ws, size_t i, T& h) const;
+    /// Projects `v` out of the first `k` basis vectors, and adds the coefficients to the `i`-th column of `hess`
+    /// @return the squared norms of `v` before and after the projection if `with_norm`, or zeros otherwise
+    auto _project(GmresWorkspace<T>& ws, size_t k, DynVec<T>& v, size_t i, bool with_norm) const -> std::pair<T, T>;
+    /// `y <- P^-1 A x` (left) or `y <- A P^-1 x` (right), using `w` as a temporary
+    void _precond_op(const DynVec<T>& x, DynVec<T>& w, DynVec<T>& y) const;
     void _givens_rot(const HessenbergMat<T>& hess, T h, std::vector<T>& s, std::vector<T>& c, DynUpperTriMat<T>& r, std::vector<T>& beta) const;
 };
 
 
 // === Implementation === //
 
-template<typename T, typename M>
-auto Gmres<T, M>::solve(const lalib::DynVec<T>& rhs) const -> lalib::DynVec<T> {
-    auto n = this->_mat.shape().first;
+template<typename T, typename M, Preconditioner<T> P>
+auto Gmres<T, M, P>::solve(const lalib::DynVec<T>& rhs) const -> lalib::DynVec<T> {
+    auto x = lalib::DynVec<T>::filled(this->_mat.shape().first, Zero<T>::value());
+    this->solve(rhs, x);
+    return x;
+}
+
+template<typename T, typename M, Preconditioner<T> P>
+auto Gmres<T, M, P>::solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x) const -> SolverStatus<T> {
+    auto ws = GmresWorkspace<T>(this->_mat.shape().first, this->_cycle_length());
+    return this->solve(rhs, x, ws);
+}
 
-    // Krylov subspace basis
-    auto q = std::vector<lalib::DynVec<T>>();
-    q.reserve(n);
-    
-    // Initial Krylov subspace basis
-    auto b_prime = this->_lu.solve(rhs);
-    q.emplace_back((1.0 / b_prime.norm2()) * b_prime);
+template<typename T, typename M, Preconditioner<T> P>
+auto Gmres<T, M, P>::solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x, GmresWorkspace<T>& ws) const -> SolverStatus<T> {
+    auto m = this->_cycle_length();
+    auto max_iter = this->_max_iter == 0 ? this->_mat.shape().first : this->_max_iter;
+    ws.resize(this->_mat.shape().first, m);
+
+    // Krylov subspace basis, reused across the restarts
+    auto& q = ws._q;
 
     // Givens rotation components
-    auto c = std::vector<T>();
-    auto s = std::vector<T>();
-    c.reserve(n);
-    s.reserve(n);
+    auto& c = ws._c;
+    auto& s = ws._s;
 
     // Beta vector ( beta = ||b||| U^T e_1 )
-    auto beta = std::vector<T>();
-    beta.reserve(n);
-    beta.emplace_back(b_prime.norm2());
-
-    auto r = DynUpperTriMat<T>::with_capacity(n);
-    auto hess = HessenbergMat<T>::with_capacity(n);
-    auto h = Zero<T>::value();
-
-    // Start the GMRES iteration
-    for ([[maybe_unused]] auto i: std::views::iota(0u, n)) {
-        // Extend the Krylob subspace
-        this->_arnoldi(q, hess, h);
-        this->_givens_rot(hess, h, s, c, r, beta);
-
-        // Check the convergence
-        if (std::abs(beta.back()) < this->_tol) { break; }
-    }
+    auto& beta = ws._beta;
+
+    auto& r = ws._r;
+    auto& hess = ws._hess;
 
-    // Solve the uper triangle system
-    auto bend = beta.size() - 1;
-    r.back_sub(beta | std::views::take(bend));
+    auto status = SolverStatus<T>{ 0, Zero<T>::value(), false };
+    while (true) {
+        // Residual of the current solution, preconditioned on the left
+        if (this->_side == PrecondSide::Left) {
+            internal::_residual(this->_mat, rhs, x, ws._w);
+            this->_precond.apply(ws._w, q[0]);
+        } else {
+            internal::_residual(this->_mat, rhs, x, q[0]);
+        }
+        status.residual = q[0].norm2();
+        if (status.residual < this->_tol) { 
+            status.converged = true;
+            break; 
+        }
+        if (status.iterations >= max_iter) { break; }
+        scale(One<T>::value() / status.residual, q[0]);
 
-    // Transform the solution from the Krylov subspace
-    auto x = lalib::DynVec<T>::filled(n, Zero<T>::value());
-    for (auto i = 0u; i < beta.size() - 1; ++i) {
-        axpy(1.0, beta[i] * q[i], x);
+        c.clear();
+        s.clear();
+        beta.assign(1, status.residual);
+        r.clear();
+        hess.clear();
+        auto h = Zero<T>::value();
+
+        // Start the GMRES cycle
+        auto k = 0u;
+        while (k < m && status.iterations < max_iter) {
+            // Extend the Krylob subspace
+            this->_arnoldi(ws, k, h);
+            this->_givens_rot(hess, h, s, c, r, beta);
+            ++k;
+            ++status.iterations;
+
+            // Check the convergence
+            if (std::abs(beta.back()) < this->_tol) { break; }
+        }
+
+        // Solve the uper triangle system, and update the solution from the Krylov subspace
+        r.back_sub(beta | std::views::take(k));
+        if (this->_side == PrecondSide::Left) {
+            for (auto i = 0u; i < k; ++i) {
+                axpy(beta[i], q[i], x);
+            }
+        } else {
+            std::fill(ws._w.begin(), ws._w.end(), Zero<T>::value());
+            for (auto i = 0u; i < k; ++i) {
+                axpy(beta[i], q[i], ws._w);
+            }
+            this->_precond.apply(ws._w, ws._z);
+            axpy(One<T>::value(), ws._z, x);
+        }
+
+        if (std::abs(beta[k]) < this->_tol) {
+            status.residual = std::abs(beta[k]);
+            status.converged = true;
+            break;
+        }
     }
 
-    return x;
+    return status;
 }
 
+template<typename T, typename M, Preconditioner<T> P>
+auto Gmres<T, M, P>::_cycle_length() const noexcept -> size_t {
+    auto n = this->_mat.shape().first;
+    return this->_restart == 0 ? n : std::min(this->_restart, n);
+}
 
-template<typename T, typename M>
-void Gmres<T, M>::_arnoldi(std::vector<DynVec<T>>& q, HessenbergMat<T>& hess, T& h) const {
-    auto i = q.size() - 1;
 
+template<typename T, typename M, Preconditioner<T> P>
+void Gmres<T, M, P>::_arnoldi(GmresWorkspace<T>& ws, size_t i, T& h) const {
     // Extend the Hessenberg matrix
+    auto& hess = ws._hess;
     hess.extend_with_zero();
     if (i > 0) {
         hess(i, i - 1) = h;
     }
     assert(hess.shape().first == i + 1);
-    auto rhs = this->_mat * q[i];
-    auto v = this->_lu.solve(rhs);
-    for (auto j: std::views::iota(0u, i + 1)) {
-        hess(j, i) = dot(q[j], v);
+    auto& v = ws._q[i + 1];
+    this->_precond_op(ws._q[i], ws._w, v);
+
+    // The second pass of CGS2 also yields the norm, unless the cancellation loses the accuracy
+    auto cgs2 = this->_orth == Orthogonalization::Cgs2;
+    auto norms = this->_project(ws, i + 1, v, i, false);
+    if (cgs2) {
+        norms = this->_project(ws, i + 1, v, i, true);
+    }
+    auto [vv, nn] = norms;
+    if (cgs2 && nn > vv * std::sqrt(std::numeric_limits<T>::epsilon())) {
+        h = std::sqrt(nn);
+    } else {
+        h = v.norm2();
     }
-    for (auto j: std::views::iota(0u, i + 1)) {
-        axpy(-1.0, hess(j, i) * q[j], v);
+
+    // A zero norm means the subspace is invariant, and the next basis vector is never used.
+    if (h != Zero<T>::value()) {
+        scale(One<T>::value() / h, v);
+    }
+}
+
+template<typename T, typename M, Preconditioner<T> P>
+auto Gmres<T, M, P>::_project(GmresWorkspace<T>& ws, size_t k, DynVec<T>& v, size_t i, bool with_norm) const -> std::pair<T, T> {
+    auto& coef = ws._coef;
+    auto& basis = ws._basis;
+    auto n = v.size();
+
+    // [Q^T v, v^T v] in a single pass over v and the basis
+    auto nk = with_norm ? k + 1 : k;
+    basis[k] = v.data();
+    mdot_core(v.data(), basis.data(), nk, n, coef.data());
+    basis[k] = ws._q[k].data();
+
+    auto vv = with_norm ? coef[k] : Zero<T>::value();
+    auto nn = vv;
+    for (auto j = 0u; j < k; ++j) {
+        ws._hess(j, i) += coef[j];
+        nn -= coef[j] * coef[j];
+        coef[j] = -coef[j];
     }
 
-    h = v.norm2();
-    q.emplace_back((1.0 / h) * v);
+    // v <- v - Q (Q^T v)
+    maxpy_core(coef.data(), basis.data(), k, v.data(), n);
+    return std::make_pair(vv, nn);
+}
+
+template<typename T, typename M, Preconditioner<T> P>
+void Gmres<T, M, P>::_precond_op(const DynVec<T>& x, DynVec<T>& w, DynVec<T>& y) const {
+    if (this->_side == PrecondSide::Left) {
+        internal::_apply_operator(this->_mat, x, w);
+        this->_precond.apply(w, y);
+    } else {
+        this->_precond.apply(x, w);
+        internal::_apply_operator(this->_mat, w, y);
+    }
 }
 
-template<typename T, typename M>
-void Gmres<T, M>::_givens_rot(const HessenbergMat<T>& hess, T h, std::vector<T>& s, std::vector<T>& c, DynUpperTriMat<T>& r, std::vector<T>& beta) const {
+template<typename T, typename M, Preconditioner<T> P>
+void Gmres<T, M, P>::_givens_rot(const HessenbergMat<T>& hess, T h, std::vector<T>& s, std::vector<T>& c, DynUpperTriMat<T>& r, std::vector<T>& beta) const {
     auto n = hess.shape().first;
 
     // Extend the upper triangular matrix
-    auto col = hess.get_col(n - 1);
-    r.extend_with(std::vector(col.begin(), col.end()));
+    r.extend_with(hess.get_col(n - 1));
     assert(r.shape().first == n);
 
     // Extend the beta vector
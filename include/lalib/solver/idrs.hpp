@@ -0,0 +1,300 @@
+#ifndef LALIB_SOLVER_IDRS_HPP
+#define LALIB_SOLVER_IDRS_HPP
+
+#include "lalib/ops/ops_traits.hpp"
+#include "lalib/ops/vec_ops_core.hpp"
+#include "lalib/vec/dyn_vec.hpp"
+#include "lalib/solver/ilu.hpp"
+#include "lalib/solver/linear_operator.hpp"
+#include "lalib/solver/preconditioner.hpp"
+#include "lalib/solver/solver_status.hpp"
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace lalib::solver {
+
+/// @brief      Working memory of the IDR(s) solver
+/// @details    Holds `2s + 3` vectors of the size of the system, and the small `s` x `s` projected system.
+/// @tparam T   a floating-point type
+template<typename T>
+struct IdrsWorkspace {
+    /// @brief      Creates an empty workspace, which is sized on the first solve.
+    IdrsWorkspace() noexcept = default;
+
+    /// @brief      Creates a workspace for systems of size `n` with the shadow space dimension `s`.
+    IdrsWorkspace(size_t n, size_t s) {
+        this->resize(n, s);
+    }
+
+    /// @brief      Reallocates the workspace if the size of the system or the shadow space dimension differs.
+    void resize(size_t n, size_t s) {
+        if (this->_r.size() == n && this->_g.size() == s) { return; }
+        this->_g.assign(s, lalib::DynVec<T>::uninit(n));
+        this->_u.assign(s, lalib::DynVec<T>::uninit(n));
+        this->_r = lalib::DynVec<T>::uninit(n);
+        this->_v = lalib::DynVec<T>::uninit(n);
+        this->_t = lalib::DynVec<T>::uninit(n);
+        this->_m.resize(s * s);
+        this->_f.resize(s);
+        this->_c.resize(s);
+    }
+
+private:
+    template<std::floating_point U, typename M, Preconditioner<U> P> friend struct Idrs;
+
+    std::vector<lalib::DynVec<T>> _g;
+    std::vector<lalib::DynVec<T>> _u;
+    lalib::DynVec<T> _r;
+    lalib::DynVec<T> _v;
+    lalib::DynVec<T> _t;
+    std::vector<T> _m;
+    std::vector<T> _f;
+    std::vector<T> _c;
+};
+
+
+/// @brief      Right-preconditioned IDR(s) solver for non-symmetric systems
+/// @details    The induced dimension reduction method with biorthogonalization (van Gijzen and Sonneveld, 2011).
+///             The memory footprint is fixed to `2s + 3` vectors plus the `s` shadow vectors, and each iteration 
+///             applies the operator and the preconditioner once. The shadow space is generated from a fixed seed, 
+///             so that solves are reproducible. The solver refers to the operator without copying it, so the 
+///             operator must outlive the solver.
+/// @tparam T   a floating-point type
+/// @tparam M   a linear operator type, i.e. a matrix or a matrix-free operator
+/// @tparam P   a preconditioner type. the ILU(0) factorization of the matrix by default.
+template<std::floating_point T, typename M, Preconditioner<T> P = Ilu<T, M>>
+struct Idrs {
+    /// @brief      Constructs an IDR(s) solver preconditioned by `P` built from the matrix
+    /// @param mat  a matrix
+    /// @param tol  a tolerance of the residual norm
+    /// @param s    the dimension of the shadow space
+    /// @param max_iter the maximum number of the iterations. `0` means the size of the matrix.
+    /// @throw      `std::invalid_argument` if `s` is zero
+    Idrs(const M& mat, T tol, size_t s = 4, size_t max_iter = 0) requires internal::_BuildablePreconditioner<P, M>:
+        Idrs(mat, internal::_make_preconditioner<P>(mat), tol, s, max_iter) {}
+
+    /// @brief      Constructs an IDR(s) solver with a given preconditioner
+    /// @param mat  a linear operator
+    /// @param precond  a preconditioner
+    /// @param tol  a tolerance of the residual norm
+    /// @param s    the dimension of the shadow space
+    /// @param max_iter the maximum number of the iterations. `0` means the size of the matrix.
+    /// @throw      `std::invalid_argument` if `s` is zero
+    Idrs(const M& mat, P precond, T tol, size_t s = 4, size_t max_iter = 0);
+
+    // The operator is referred to by the solver, so temporaries are rejected.
+    Idrs(const M&& mat, T tol, size_t s = 4, size_t max_iter = 0) = delete;
+    Idrs(const M&& mat, P precond, T tol, size_t s = 4, size_t max_iter = 0) = delete;
+
+    /// @brief      Gets the preconditioner
+    auto preconditioner() const noexcept -> const P& {
+        return this->_precond;
+    }
+
+    /// @brief      Solves a linear system
+    /// @param rhs  a right-hand side vector
+    /// @return     a solution vector
+    auto solve(const lalib::DynVec<T>& rhs) const -> lalib::DynVec<T>;
+
+    /// @brief      Solves a linear system from an initial guess
+    /// @param rhs  a right-hand side vector
+    /// @param x    an initial guess, and the solution vector after the operation
+    /// @return     the status of the solve. the residual is the norm of the true residual `b - A x`.
+    auto solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x) const -> SolverStatus<T>;
+
+    /// @brief      Solves a linear system from an initial guess with a reusable workspace
+    /// @param rhs  a right-hand side vector
+    /// @param x    an initial guess, and the solution vector after the operation
+    /// @param ws   a workspace. once sized for the system, the solve performs no heap allocation.
+    /// @return     the status of the solve. the residual is the norm of the true residual `b - A x`.
+    auto solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x, IdrsWorkspace<T>& ws) const -> SolverStatus<T>;
+
+private:
+    const M& _mat;
+    const P _precond;
+    const T _tol;
+    const size_t _max_iter;
+
+    /// Orthonormal basis of the shadow space
+    std::vector<lalib::DynVec<T>> _shadow;
+};
+
+
+// === Implementation === //
+
+template<std::floating_point T, typename M, Preconditioner<T> P>
+Idrs<T, M, P>::Idrs(const M& mat, P precond, T tol, size_t s, size_t max_iter):
+    _mat(mat), _precond(std::move(precond)), _tol(tol), _max_iter(max_iter)
+{
+    if (s == 0) {
+        throw std::invalid_argument("The dimension of the shadow space must be positive.");
+    }
+    auto n = mat.shape().first;
+    s = std::min(s, n);
+
+    // Random shadow vectors, orthonormalized by the modified Gram-Schmidt process
+    auto rand = std::mt19937(0);
+    auto dist = std::normal_distribution<T>(Zero<T>::value(), One<T>::value());
+    this->_shadow.reserve(s);
+    for (auto k = 0u; k < s; ++k) {
+        auto p = lalib::DynVec<T>::uninit(n);
+        for (auto& e: p) { e = dist(rand); }
+        for (auto i = 0u; i < k; ++i) {
+            axpy_core(-dot_core(this->_shadow[i].data(), p.data(), n), this->_shadow[i].data(), p.data(), n);
+        }
+        scal_core(One<T>::value() / std::sqrt(dot_core(p.data(), p.data(), n)), p.data(), n);
+        this->_shadow.emplace_back(std::move(p));
+    }
+}
+
+template<std::floating_point T, typename M, Preconditioner<T> P>
+auto Idrs<T, M, P>::solve(const lalib::DynVec<T>& rhs) const -> lalib::DynVec<T> {
+    auto x = lalib::DynVec<T>::filled(this->_mat.shape().first, Zero<T>::value());
+    this->solve(rhs, x);
+    return x;
+}
+
+template<std::floating_point T, typename M, Preconditioner<T> P>
+auto Idrs<T, M, P>::solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x) const -> SolverStatus<T> {
+    auto ws = IdrsWorkspace<T>(this->_mat.shape().first, this->_shadow.size());
+    return this->solve(rhs, x, ws);
+}
+
+template<std::floating_point T, typename M, Preconditioner<T> P>
+auto Idrs<T, M, P>::solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x, IdrsWorkspace<T>& ws) const -> SolverStatus<T> {
+    // Keeps the angle between `t` and `r` away from orthogonal when choosing omega
+    constexpr auto kappa = static_cast<T>(0.7);
+
+    auto n = this->_mat.shape().first;
+    auto s = this->_shadow.size();
+    auto max_iter = this->_max_iter == 0 ? n : this->_max_iter;
+    ws.resize(n, s);
+    const auto& q = this->_shadow;
+    auto& g = ws._g;
+    auto& u = ws._u;
+    auto& r = ws._r;
+    auto& v = ws._v;
+    auto& t = ws._t;
+    auto& m = ws._m;
+    auto& f = ws._f;
+    auto& c = ws._c;
+
+    internal::_residual(this->_mat, rhs, x, r);
+    auto status = SolverStatus<T>{ 0, std::sqrt(dot_core(r.data(), r.data(), n)), false };
+    if (status.residual < this->_tol) {
+        status.converged = true;
+        return status;
+    }
+
+    // G = U = 0, and M = Q^T G = I
+    for (auto k = 0u; k < s; ++k) {
+        std::fill(g[k].begin(), g[k].end(), Zero<T>::value());
+        std::fill(u[k].begin(), u[k].end(), Zero<T>::value());
+    }
+    std::fill(m.begin(), m.end(), Zero<T>::value());
+    for (auto k = 0u; k < s; ++k) { m[k * s + k] = One<T>::value(); }
+    auto omega = One<T>::value();
+
+    auto breakdown = false;
+    while (!status.converged && !breakdown && status.iterations < max_iter) {
+        auto replaced = false;
+        // f = Q^T r
+        for (auto i = 0u; i < s; ++i) {
+            f[i] = dot_core(q[i].data(), r.data(), n);
+        }
+
+        for (auto k = 0u; k < s; ++k) {
+            // Solve the lower triangular system M(k:s, k:s) c = f(k:s)
+            for (auto i = k; i < s; ++i) {
+                auto sum = f[i];
+                for (auto j = k; j < i; ++j) {
+                    sum -= m[i * s + j] * c[j];
+                }
+                c[i] = sum / m[i * s + i];
+            }
+
+            // v = P^-1 (r - G(:, k:s) c), and u_k = U(:, k:s) c + omega v
+            std::copy(r.begin(), r.end(), v.begin());
+            for (auto j = k; j < s; ++j) {
+                axpy_core(-c[j], g[j].data(), v.data(), n);
+            }
+            this->_precond.apply(v, v);
+            scal_core(c[k], u[k].data(), n);
+            for (auto j = k + 1; j < s; ++j) {
+                axpy_core(c[j], u[j].data(), u[k].data(), n);
+            }
+            axpy_core(omega, v.data(), u[k].data(), n);
+
+            // g_k = A u_k, biorthogonalized against q_i for i < k
+            internal::_apply_operator(this->_mat, u[k], g[k]);
+            for (auto i = 0u; i < k; ++i) {
+                auto alpha = dot_core(q[i].data(), g[k].data(), n) / m[i * s + i];
+                axpy_core(-alpha, g[i].data(), g[k].data(), n);
+                axpy_core(-alpha, u[i].data(), u[k].data(), n);
+            }
+            for (auto i = k; i < s; ++i) {
+                m[i * s + k] = dot_core(q[i].data(), g[k].data(), n);
+            }
+            if (m[k * s + k] == Zero<T>::value()) {
+                breakdown = true;
+                break;
+            }
+
+            // Make r orthogonal to q_i for i <= k
+            auto beta = f[k] / m[k * s + k];
+            axpy_core(-beta, g[k].data(), r.data(), n);
+            axpy_core(beta, u[k].data(), x.data(), n);
+            ++status.iterations;
+
+            status.residual = std::sqrt(dot_core(r.data(), r.data(), n));
+            if (status.residual < this->_tol) {
+                // Replaces the recurrence by the true residual. If it has not converged yet, the cycle restarts from
+                // it, since f = Q^T r no longer follows the updates.
+                status.residual = internal::_true_residual_norm(this->_mat, rhs, x, r);
+                status.converged = status.residual < this->_tol;
+                replaced = true;
+                break;
+            }
+            if (status.iterations >= max_iter) { break; }
+            for (auto i = k + 1; i < s; ++i) {
+                f[i] -= beta * m[i * s + k];
+            }
+        }
+        if (status.converged || breakdown || status.iterations >= max_iter) { break; }
+        if (replaced) { continue; }
+
+        // Dimension reduction step: v = P^-1 r, t = A v, and the minimal residual along t with a safeguarded angle
+        this->_precond.apply(r, v);
+        internal::_apply_operator(this->_mat, v, t);
+        auto tt = dot_core(t.data(), t.data(), n);
+        auto tr = dot_core(t.data(), r.data(), n);
+        if (tt == Zero<T>::value() || tr == Zero<T>::value()) { break; }
+        omega = tr / tt;
+        auto rho = std::abs(tr) / (std::sqrt(tt) * status.residual);
+        if (rho < kappa) {
+            omega *= kappa / rho;
+        }
+
+        axpy_core(omega, v.data(), x.data(), n);
+        axpy_core(-omega, t.data(), r.data(), n);
+        ++status.iterations;
+
+        status.residual = std::sqrt(dot_core(r.data(), r.data(), n));
+        if (status.residual < this->_tol) {
+            status.residual = internal::_true_residual_norm(this->_mat, rhs, x, r);
+            status.converged = status.residual < this->_tol;
+        }
+    }
+
+    if (!status.converged) {
+        status.residual = internal::_true_residual_norm(this->_mat, rhs, x, r);
+    }
+    return status;
+}
+
+}
+#endif // LALIB_SOLVER_IDRS_HPP
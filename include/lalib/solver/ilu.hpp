@@ -1,9 +1,18 @@
 #ifndef LALIB_SOLVER_ILU_HPP
 #define LALIB_SOLVER_ILU_HPP
 
+#include <algorithm>
 #include <memory>
 #include <concepts>
+#include <cstdint>
+#include <numeric>
+#include <vector>
 #include "lalib/vec.hpp"
+#include "lalib/mat/sp_mat.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace lalib::solver {
 
@@ -28,6 +37,19 @@ struct Ilu {
     /// @return a solution vector
     auto solve(const lalib::DynVec<T>& rhs) const noexcept -> lalib::DynVec<T>;
 
+    /// Solves a linear system without allocation.
+    /// @param rhs a right-hand side vector
+    /// @param x a vector storing the solution. it must have the same size as `rhs`, and may be `rhs` itself.
+    /// @return a reference to `x`
+    auto solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x) const noexcept -> lalib::DynVec<T>&;
+
+    /// Applies the factorization as a preconditioner, `out <- (LU)^-1 in`.
+    /// @param in an input vector
+    /// @param out a vector storing the result. it may be `in` itself.
+    void apply(const lalib::DynVec<T>& in, lalib::DynVec<T>& out) const noexcept {
+        this->solve(in, out);
+    }
+
 private:
     M _mat;
 };
@@ -63,6 +85,210 @@ namespace internal {
     }
 }
 
+namespace internal {
+    /// Level sets of a sparse triangular factor. 
+    /// @details    Rows in the same level depend only on rows in the preceding levels, so that they can be solved in parallel.
+    ///             The `p`-th row in level order is `rows[p]`, and its off-diagonal elements are in `[row_begin[p], row_end[p])`.
+    template<typename T, typename I>
+    struct _SpTriLevels {
+        std::vector<size_t> level_ptr;
+        std::vector<size_t> rows;
+        std::vector<size_t> row_begin;
+        std::vector<size_t> row_end;
+
+        /// Diagonal elements in level order (empty for a unit triangular factor)
+        std::vector<T> diag;
+
+        /// Off-diagonal elements copied in level order (empty unless the storage is reordered)
+        std::vector<T> val;
+        std::vector<I> col_ids;
+
+        auto nlevels() const noexcept -> size_t { return this->level_ptr.size() - 1; }
+    };
+
+    /// Performs ILU(0) factorization of a CSR matrix in place.
+    /// @param diag an array storing the position of the diagonal element of each row
+    /// @return `false` if a diagonal element is missing or zero
+    template<typename T, typename I>
+    bool _decomp_sp_lu_inplace(size_t n, const I* row_ptr, const I* col_ids, T* val, std::vector<size_t>& diag) {
+        diag.resize(n);
+
+        // Position of each column in the current row (`SIZE_MAX` if absent)
+        auto marker = std::vector<size_t>(n, SIZE_MAX);
+        for (auto i = 0u; i < n; ++i) {
+            for (auto k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+                marker[col_ids[k]] = k;
+            }
+
+            // Eliminate the lower elements with the rows already factorized
+            for (auto k = row_ptr[i]; k < row_ptr[i + 1] && col_ids[k] < i; ++k) {
+                auto j = col_ids[k];
+                val[k] /= val[diag[j]];
+                for (auto l = diag[j] + 1; l < row_ptr[j + 1]; ++l) {
+                    if (marker[col_ids[l]] != SIZE_MAX) {
+                        val[marker[col_ids[l]]] -= val[k] * val[l];
+                    }
+                }
+            }
+
+            if (marker[i] == SIZE_MAX || val[marker[i]] == 0) { return false; }
+            diag[i] = marker[i];
+
+            for (auto k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+                marker[col_ids[k]] = SIZE_MAX;
+            }
+        }
+        return true;
+    }
+
+    /// Computes the level sets of the strictly lower (`upper = false`) or upper (`upper = true`) part of a factorized CSR matrix.
+    /// @param diag     an array storing the position of the diagonal element of each row
+    /// @param reorder  whether to copy the off-diagonal elements in level order
+    template<typename T, typename I>
+    void _analyze_sp_tri_levels(size_t n, const I* row_ptr, const I* col_ids, const T* val, const std::vector<size_t>& diag, bool upper, bool reorder, _SpTriLevels<T, I>& lv) {
+        auto begin = [&](size_t i) -> size_t { return upper ? diag[i] + 1 : row_ptr[i]; };
+        auto end = [&](size_t i) -> size_t { return upper ? row_ptr[i + 1] : diag[i]; };
+
+        // The level of a row is one more than the deepest row it depends on
+        auto level = std::vector<size_t>(n, 0);
+        auto nlevels = size_t(n > 0);
+        for (auto c = 0u; c < n; ++c) {
+            auto i = upper ? n - 1 - c : c;
+            auto l = size_t(0);
+            for (auto k = begin(i); k < end(i); ++k) {
+                l = std::max(l, level[col_ids[k]] + 1);
+            }
+            level[i] = l;
+            nlevels = std::max(nlevels, l + 1);
+        }
+
+        // Sort the rows by level (stable in the order of the solve)
+        lv.level_ptr.assign(nlevels + 1, 0);
+        for (auto i = 0u; i < n; ++i) {
+            ++lv.level_ptr[level[i] + 1];
+        }
+        std::partial_sum(lv.level_ptr.begin(), lv.level_ptr.end(), lv.level_ptr.begin());
+
+        auto cursor = std::vector<size_t>(lv.level_ptr.begin(), lv.level_ptr.end() - 1);
+        lv.rows.resize(n);
+        for (auto c = 0u; c < n; ++c) {
+            auto i = upper ? n - 1 - c : c;
+            lv.rows[cursor[level[i]]++] = i;
+        }
+
+        lv.row_begin.resize(n);
+        lv.row_end.resize(n);
+        lv.diag.clear();
+        lv.val.clear();
+        lv.col_ids.clear();
+        for (auto p = 0u; p < n; ++p) {
+            auto i = lv.rows[p];
+            if (reorder) {
+                lv.row_begin[p] = lv.val.size();
+                lv.val.insert(lv.val.end(), val + begin(i), val + end(i));
+                lv.col_ids.insert(lv.col_ids.end(), col_ids + begin(i), col_ids + end(i));
+                lv.row_end[p] = lv.val.size();
+            } else {
+                lv.row_begin[p] = begin(i);
+                lv.row_end[p] = end(i);
+            }
+            if (upper) {
+                lv.diag.emplace_back(val[diag[i]]);
+            }
+        }
+    }
+
+    /// Returns whether to solve a triangular system with `n` rows in `nlevels` levels in parallel.
+    /// @details    Every level ends with a barrier, so that only factors with wide levels on average are worth distributing.
+    inline auto _sp_tri_parallel(size_t n, size_t nlevels) noexcept -> bool {
+        #ifdef _OPENMP
+        return n >= (1u << 14) && n >= 64 * nlevels && !omp_in_parallel() && omp_get_max_threads() > 1;
+        #else
+        (void)n; (void)nlevels;
+        return false;
+        #endif
+    }
+
+    /// Solves a sparse triangular system in place level by level.
+    /// @param col_ids  an array of the column indices the level sets point to
+    /// @param val      an array of the values the level sets point to
+    template<typename T, typename I>
+    void _sp_tri_solve_levels(const _SpTriLevels<T, I>& lv, const I* col_ids, const T* val, T* x, bool parallel) noexcept {
+        if (!lv.val.empty()) {
+            col_ids = lv.col_ids.data();
+            val = lv.val.data();
+        }
+        const auto* diag = lv.diag.empty() ? nullptr : lv.diag.data();
+
+        #pragma omp parallel if(parallel)
+        for (auto l = 0u; l < lv.nlevels(); ++l) {
+            #pragma omp for schedule(static)
+            for (auto p = lv.level_ptr[l]; p < lv.level_ptr[l + 1]; ++p) {
+                auto i = lv.rows[p];
+                auto sum = x[i];
+                for (auto k = lv.row_begin[p]; k < lv.row_end[p]; ++k) {
+                    sum -= val[k] * x[col_ids[k]];
+                }
+                x[i] = diag ? sum / diag[p] : sum;
+            }
+        }
+    }
+}
+
+/// A structure providing the incomplete LU(0) factorization specialized for CSR matrices.
+/// @details    The factorization walks the sparsity pattern row by row, so that its cost is `O(nnz * avg_row)` 
+///             rather than the dense triple loop. The column indices in each row must be sorted.
+///             The level sets of both factors are computed once at construction, and the substitutions process 
+///             the rows in each level in parallel.
+/// @tparam T a floating-point type
+/// @tparam I an index type of the matrix
+template<std::floating_point T, std::unsigned_integral I>
+struct Ilu<T, SpMat<T, I>> {
+    /// Constructs an ILU factorization of a matrix.
+    /// @param mat      a matrix
+    /// @param reorder  whether to keep a copy of the factors stored in level order, so that the substitutions access them contiguously
+    /// @throw std::runtime_error if a diagonal element is missing or zero
+    Ilu(SpMat<T, I>&& mat, bool reorder = false);
+
+    /// Gets the decomposed matrix. The strictly lower part holds L (with unit diagonal), and the others hold U.
+    /// @return the decomposed matrix
+    auto mat() const noexcept -> const SpMat<T, I>& {
+        return this->_mat;
+    }
+
+    /// Gets the number of the levels of the factors.
+    /// @return a pair of the numbers of the levels of L and U
+    auto nlevels() const noexcept -> std::pair<size_t, size_t> {
+        return std::make_pair(this->_lower.nlevels(), this->_upper.nlevels());
+    }
+
+    /// Solves a linear system.
+    /// @param rhs a right-hand side vector
+    /// @return a solution vector
+    auto solve(const lalib::DynVec<T>& rhs) const noexcept -> lalib::DynVec<T>;
+
+    /// Solves a linear system without allocation.
+    /// @param rhs a right-hand side vector
+    /// @param x a vector storing the solution. it must have the same size as `rhs`, and may be `rhs` itself.
+    /// @return a reference to `x`
+    auto solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x) const noexcept -> lalib::DynVec<T>&;
+
+    /// Applies the factorization as a preconditioner, `out <- (LU)^-1 in`.
+    /// @param in an input vector
+    /// @param out a vector storing the result. it may be `in` itself.
+    void apply(const lalib::DynVec<T>& in, lalib::DynVec<T>& out) const noexcept {
+        this->solve(in, out);
+    }
+
+private:
+    SpMat<T, I> _mat;
+    std::vector<size_t> _diag;
+
+    internal::_SpTriLevels<T, I> _lower;
+    internal::_SpTriLevels<T, I> _upper;
+};
+
+
 template<std::floating_point T, typename M>
 Ilu<T, M>::Ilu(M&& mat) : _mat(std::forward<M>(mat)) {
     if (!internal::_decomp_lu_inplace(this->_mat)) {
@@ -72,18 +298,24 @@ Ilu<T, M>::Ilu(M&& mat) : _mat(std::forward<M>(mat)) {
 
 template<std::floating_point T, typename M>
 auto Ilu<T, M>::solve(const lalib::DynVec<T>& rhs) const noexcept -> lalib::DynVec<T> {
-    auto y = lalib::DynVec<T>::uninit(rhs.size());
-    for (auto i = 0u; i < y.size(); ++i) {
+    auto x = lalib::DynVec<T>::uninit(rhs.size());
+    this->solve(rhs, x);
+    return x;
+}
+
+template<std::floating_point T, typename M>
+auto Ilu<T, M>::solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x) const noexcept -> lalib::DynVec<T>& {
+    // Forward substitution. `x[i]` only depends on `rhs[i]` and `x[j]` for `j < i`, so that `x` may alias `rhs`.
+    for (auto i = 0u; i < x.size(); ++i) {
         auto sum = rhs[i];
         for (auto j = 0u; j < i; ++j) {
-            sum -= this->_mat(i, j) * y[j];
+            sum -= this->_mat(i, j) * x[j];
         }
-        y[i] = sum;
+        x[i] = sum;
     }
 
-    auto x = lalib::DynVec<T>::uninit(rhs.size());
     for (auto i = x.size(); i-- > 0;) {
-        auto sum = y[i];
+        auto sum = x[i];
         for (auto j = i + 1; j < x.size(); ++j) {
             sum -= this->_mat(i, j) * x[j];
         }
@@ -92,5 +324,41 @@ auto Ilu<T, M>::solve(const lalib::DynVec<T>& rhs) const noexcept -> lalib::DynV
     return x;
 }
 
+template<std::floating_point T, std::unsigned_integral I>
+Ilu<T, SpMat<T, I>>::Ilu(SpMat<T, I>&& mat, bool reorder) : _mat(std::move(mat)) {
+    auto n = this->_mat.shape().first;
+    const auto* row_ptr = this->_mat.row_ptr().data();
+    const auto* col_ids = this->_mat.col_indices().data();
+    if (!internal::_decomp_sp_lu_inplace(n, row_ptr, col_ids, this->_mat.data(), this->_diag)) {
+        throw std::runtime_error("Matrix is singular.");
+    }
+
+    const auto* val = this->_mat.values().data();
+    internal::_analyze_sp_tri_levels(n, row_ptr, col_ids, val, this->_diag, false, reorder, this->_lower);
+    internal::_analyze_sp_tri_levels(n, row_ptr, col_ids, val, this->_diag, true, reorder, this->_upper);
+}
+
+template<std::floating_point T, std::unsigned_integral I>
+auto Ilu<T, SpMat<T, I>>::solve(const lalib::DynVec<T>& rhs) const noexcept -> lalib::DynVec<T> {
+    auto x = rhs;
+    this->solve(x, x);
+    return x;
+}
+
+template<std::floating_point T, std::unsigned_integral I>
+auto Ilu<T, SpMat<T, I>>::solve(const lalib::DynVec<T>& rhs, lalib::DynVec<T>& x) const noexcept -> lalib::DynVec<T>& {
+    const auto* col_ids = this->_mat.col_indices().data();
+    const auto* val = this->_mat.values().data();
+    auto n = rhs.size();
+
+    // Forward substitution with the unit lower part, and then backward substitution with the upper part
+    if (&x != &rhs) {
+        std::copy(rhs.begin(), rhs.end(), x.begin());
+    }
+    internal::_sp_tri_solve_levels(this->_lower, col_ids, val, x.data(), internal::_sp_tri_parallel(n, this->_lower.nlevels()));
+    internal::_sp_tri_solve_levels(this->_upper, col_ids, val, x.data(), internal::_sp_tri_parallel(n, this->_upper.nlevels()));
+    return x;
+}
+
 }
 #endif // LALIB_SOLVER_ILU_HPP
\ No newline at end of file
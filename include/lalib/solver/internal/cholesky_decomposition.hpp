@@ -2,7 +2,14 @@
 #ifndef LALIB_SOLVER_INTERNAL_CHOLESKY_HPP
 #define LALIB_SOLVER_INTERNAL_CHOLESKY_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <vector>
 #include "lalib/mat.hpp"
+#include "lalib/ops/dispatch.hpp"
+#include "lalib/ops/mat_mat_ops_core.hpp"
 
 namespace lalib::solver::_internal_ {
 
@@ -22,34 +29,330 @@ inline constexpr auto index<MemType::Triangle>(size_t, size_t i, size_t j) noexc
 }
 
 
+/// @brief  Factorizes the lower triangle of `l` in place by the unblocked algorithm.
+/// @return 0 on success, or `i + 1` if the `i`-th leading minor is not positive definite
 template<typename T, MemType MType>
-auto cholesky_decomposition(size_t n, double* l) -> int32_t {
+auto unblocked_cholesky_decomposition(size_t n, T* l) -> int32_t {
     for (auto i = 0u; i < n; ++i) {
 		for (auto j = 0u; j < i; ++j) {
+			auto sum = l[index<MType>(n, i, j)];
 			for (auto k = 0u; k < j; ++k) { 
-				l[index<MType>(n, i, j)] -= l[index<MType>(n, i, k)] * l[index<MType>(n, j, k)]; 
+				sum -= l[index<MType>(n, i, k)] * l[index<MType>(n, j, k)]; 
 			}
-			l[index<MType>(n, i, j)] /= l[index<MType>(n, j, j)];
+			l[index<MType>(n, i, j)] = sum / l[index<MType>(n, j, j)];
 		}
 
+		auto diag = l[index<MType>(n, i, i)];
 		for (auto k = 0u; k < i; ++k) { 
-			l[index<MType>(n, i, i)] -= std::pow(l[index<MType>(n, i, k)], 2); 
+			diag -= l[index<MType>(n, i, k)] * l[index<MType>(n, i, k)]; 
 		} 
 
-		if (l[index<MType>(n, i, i)] == 0) { 
-            return i;
-		} 
-		else if (l[index<MType>(n, i, i)] < 0) { 
-            return i;
+		// It also fails on NaN
+		if (!(diag > 0)) { 
+            return i + 1;
 		}
 
-		l[index<MType>(n, i, i)] = std::sqrt( l[index<MType>(n, i, i)] );
+		l[index<MType>(n, i, i)] = std::sqrt(diag);
 	}
     return 0;
 }
 
+
+// ==== Blocked factorization ==== //
+// The lower triangle is copied into `CHOLESKY_TILE` x `CHOLESKY_TILE` tiles stored contiguously, so that both layouts 
+// share the tile kernels. The tiles are factorized by the right-looking algorithm, each step `k` running
+//   POTRF: L_kk <- chol(A_kk)
+//   TRSM:  L_ik <- A_ik L_kk^-T             for i > k
+//   SYRK:  A_ii <- A_ii - L_ik L_ik^T       for i > k
+//   GEMM:  A_ij <- A_ij - L_ik L_jk^T       for i > j > k
+// as OpenMP tasks whose dependencies on the tiles form the DAG, so that the next steps start before a step ends.
+
+/// @brief  The size of the tiles of the blocked Cholesky factorization
+constexpr size_t CHOLESKY_TILE = 256;
+
+/// @brief  The width of the column blocks inside a tile, which are solved directly between the products
+constexpr size_t CHOLESKY_INNER_BLOCK = 32;
+
+/// @brief  Performs `x <- x * l^-T` for an `m` x `nb` block `x` and a factorized `nb` x `nb` block `l` (`nb <= CHOLESKY_INNER_BLOCK`).
+/// @details    The rows are solved together through a transposed copy of 64 rows, so that every step is a vector operation.
+template<typename T>
+void trsm_block(size_t m, size_t nb, const T* l, size_t ldl, T* x, size_t ldx) noexcept {
+	constexpr size_t RB = 64;
+	T xt[CHOLESKY_INNER_BLOCK * RB];
+	for (auto rb = size_t(0); rb < m; rb += RB) {
+		auto rows = std::min(RB, m - rb);
+		for (auto r = size_t(0); r < rows; ++r) {
+			for (auto j = size_t(0); j < nb; ++j) {
+				xt[j * RB + r] = x[(rb + r) * ldx + j];
+			}
+		}
+		for (auto j = size_t(0); j < nb; ++j) {
+			auto* tj = xt + j * RB;
+			for (auto p = size_t(0); p < j; ++p) {
+				auto ljp = l[j * ldl + p];
+				const auto* tp = xt + p * RB;
+				#pragma omp simd
+				for (auto r = size_t(0); r < rows; ++r) {
+					tj[r] -= ljp * tp[r];
+				}
+			}
+			auto ljj = l[j * ldl + j];
+			#pragma omp simd
+			for (auto r = size_t(0); r < rows; ++r) {
+				tj[r] /= ljj;
+			}
+		}
+		for (auto r = size_t(0); r < rows; ++r) {
+			for (auto j = size_t(0); j < nb; ++j) {
+				x[(rb + r) * ldx + j] = xt[j * RB + r];
+			}
+		}
+	}
+}
+
+/// @brief  Performs `x <- x * l^-T` for an `m` x `nb` tile `x` and a factorized `nb` x `nb` tile `l`.
+/// @details    The columns are solved by blocks, after subtracting the solved columns from each block by a matrix product.
+template<typename T>
+void trsm_tile(size_t m, size_t nb, const T* l, T* x, size_t ld) {
+	for (auto jb = size_t(0); jb < nb; jb += CHOLESKY_INNER_BLOCK) {
+		auto sb = std::min(CHOLESKY_INNER_BLOCK, nb - jb);
+		if (jb > 0) {
+			lalib::_gemm_core<true>(m, sb, jb, T(-1), x, ld, l + jb * ld, ld, T(1), x + jb, ld);
+		}
+		trsm_block(m, sb, l + jb * ld + jb, ld, x + jb, ld);
+	}
+}
+
+/// @brief  Performs `c <- c - a * a^T` on the lower triangle of an `m` x `m` tile `c`, where `a` is `m` x `kb`.
+/// @details    The rows are updated by blocks up to the diagonal, so that the upper triangle is mostly skipped.
+template<typename T>
+void syrk_tile(size_t m, size_t kb, const T* a, T* c, size_t ld) {
+	constexpr size_t RB = 64;
+	for (auto rb = size_t(0); rb < m; rb += RB) {
+		auto rows = std::min(RB, m - rb);
+		lalib::_gemm_core<true>(rows, rb + rows, kb, T(-1), a + rb * ld, ld, a, ld, T(1), c + rb * ld, ld);
+	}
+}
+
+/// @brief  Factorizes an `nb` x `nb` block (`nb <= CHOLESKY_INNER_BLOCK`) with the leading dimension `ld` in place.
+/// @return 0 on success, or `i + 1` if the `i`-th leading minor of the block is not positive definite
+template<typename T>
+auto potrf_block(size_t nb, T* a, size_t ld) noexcept -> size_t {
+	for (auto j = size_t(0); j < nb; ++j) {
+		auto* rj = a + j * ld;
+		auto diag = rj[j];
+		for (auto p = size_t(0); p < j; ++p) {
+			diag -= rj[p] * rj[p];
+		}
+		if (!(diag > 0)) {
+			return j + 1;
+		}
+		auto ljj = std::sqrt(diag);
+		rj[j] = ljj;
+
+		for (auto i = j + 1; i < nb; ++i) {
+			auto* ri = a + i * ld;
+			auto sum = ri[j];
+			for (auto p = size_t(0); p < j; ++p) {
+				sum -= ri[p] * rj[p];
+			}
+			ri[j] = sum / ljj;
+		}
+	}
+	return 0;
+}
+
+/// @brief  Factorizes an `nb` x `nb` tile with the leading dimension `ld` in place, right-looking over blocks of columns.
+/// @return 0 on success, or `i + 1` if the `i`-th leading minor of the tile is not positive definite
+template<typename T>
+auto potrf_tile(size_t nb, T* a, size_t ld) -> size_t {
+	for (auto jb = size_t(0); jb < nb; jb += CHOLESKY_INNER_BLOCK) {
+		auto sb = std::min(CHOLESKY_INNER_BLOCK, nb - jb);
+		auto* diag = a + jb * ld + jb;
+		auto rslt = potrf_block(sb, diag, ld);
+		if (rslt != 0) {
+			return jb + rslt;
+		}
+		auto rest = nb - jb - sb;
+		if (rest > 0) {
+			auto* below = diag + sb * ld;
+			trsm_block(rest, sb, diag, ld, below, ld);
+			syrk_tile(rest, sb, below, below + sb, ld);
+		}
+	}
+	return 0;
+}
+
+/// @brief  Factorizes the lower triangle of `l` in place by the tiled algorithm, in parallel if it is large enough.
+/// @return 0 on success, or `i + 1` if the `i`-th leading minor is not positive definite
+template<typename T, MemType MType>
+auto blocked_cholesky_decomposition(size_t n, T* l) -> int32_t {
+	constexpr auto NB = CHOLESKY_TILE;
+	auto nt = (n + NB - 1) / NB;
+	auto tile_size = [=](size_t t) { return std::min(NB, n - t * NB); };
+	auto tile_id = [](size_t ti, size_t tj) { return ti * (ti + 1) / 2 + tj; };
+
+	auto tiles = std::make_unique<T[]>(nt * (nt + 1) / 2 * NB * NB);
+	auto tile = [&](size_t ti, size_t tj) { return tiles.get() + tile_id(ti, tj) * NB * NB; };
+	for (auto i = size_t(0); i < n; ++i) {
+		auto ti = i / NB;
+		for (auto tj = size_t(0); tj <= ti; ++tj) {
+			auto begin = tj * NB, end = std::min(begin + NB, i + 1);
+			std::copy(l + index<MType>(n, i, begin), l + index<MType>(n, i, begin) + (end - begin), tile(ti, tj) + (i - ti * NB) * NB);
+		}
+	}
+
+	// A dummy element per tile carries the dependencies of the tasks
+	auto deps = std::vector<char>(nt * (nt + 1) / 2);
+	auto* dep = deps.data();
+	auto info = std::atomic<size_t>(0);
+	auto parallel = lalib::_use_parallel<T>(lalib::Kernel::MatMul, n * n * n / 3);
+
+	#pragma omp parallel if(parallel)
+	#pragma omp single
+	for (auto k = size_t(0); k < nt; ++k) {
+		auto kb = tile_size(k);
+		auto* lkk = tile(k, k);
+
+		#pragma omp task depend(inout: dep[tile_id(k, k)]) shared(info)
+		if (info.load() == 0) {
+			auto rslt = potrf_tile(kb, lkk, NB);
+			if (rslt != 0) { info.store(k * NB + rslt); }
+		}
+
+		for (auto i = k + 1; i < nt; ++i) {
+			auto* lik = tile(i, k);
+			auto mi = tile_size(i);
+			#pragma omp task depend(in: dep[tile_id(k, k)]) depend(inout: dep[tile_id(i, k)]) shared(info)
+			if (info.load() == 0) {
+				trsm_tile(mi, kb, lkk, lik, NB);
+			}
+		}
+
+		for (auto i = k + 1; i < nt; ++i) {
+			auto* lik = tile(i, k);
+			auto mi = tile_size(i);
+			#pragma omp task depend(in: dep[tile_id(i, k)]) depend(inout: dep[tile_id(i, i)]) shared(info)
+			if (info.load() == 0) {
+				syrk_tile(mi, kb, lik, tile(i, i), NB);
+			}
+
+			for (auto j = k + 1; j < i; ++j) {
+				auto* ljk = tile(j, k);
+				auto* aij = tile(i, j);
+				auto mj = tile_size(j);
+				#pragma omp task depend(in: dep[tile_id(i, k)], dep[tile_id(j, k)]) depend(inout: dep[tile_id(i, j)]) shared(info)
+				if (info.load() == 0) {
+					lalib::_gemm_core<true>(mi, mj, kb, T(-1), lik, NB, ljk, NB, T(1), aij, NB);
+				}
+			}
+		}
+	}
+
+	if (info.load() != 0) {
+		return static_cast<int32_t>(info.load());
+	}
+	for (auto i = size_t(0); i < n; ++i) {
+		auto ti = i / NB;
+		for (auto tj = size_t(0); tj <= ti; ++tj) {
+			auto begin = tj * NB, end = std::min(begin + NB, i + 1);
+			const auto* src = tile(ti, tj) + (i - ti * NB) * NB;
+			std::copy(src, src + (end - begin), l + index<MType>(n, i, begin));
+		}
+	}
+	return 0;
+}
+
+/// @brief  Factorizes the lower triangle of `l` into `L L^T` in place. The upper triangle of the square layout is not referenced.
+/// @details    Matrices larger than a tile are factorized by the blocked algorithm.
+/// @return 0 on success, or `i + 1` if the `i`-th leading minor is not positive definite
+template<typename T, MemType MType>
+auto cholesky_decomposition(size_t n, double* l) -> int32_t {
+	if (n > CHOLESKY_TILE) {
+		return blocked_cholesky_decomposition<double, MType>(n, l);
+	}
+	return unblocked_cholesky_decomposition<double, MType>(n, l);
+}
+
+/// @brief  The number of rows of the right-hand sides solved together by the blocked triangular solves
+constexpr size_t CHOLESKY_SOLVE_BLOCK = 128;
+
+/// @brief  Solves `L L^T X = B` (or `L D^-1 L^T X = B` if `Mod`) in place for `nrhs` right-hand sides stored row-major in `x`.
+/// @details    The rows of `x` are processed by blocks of `CHOLESKY_SOLVE_BLOCK`. The solved rows are subtracted from each block
+///             by a matrix product with a copy of the panel of `l`, and then the block is solved row by row, every step
+///             updating whole rows of the right-hand sides. So the factor is streamed once per sweep instead of once per
+///             right-hand side.
+template<typename T, MemType MType, bool Mod = false>
+void blocked_cholesky_linear(size_t n, size_t nrhs, const T* l, T* x) {
+	constexpr auto NB = CHOLESKY_SOLVE_BLOCK;
+	auto panel = std::vector<T>(std::min(NB, n) * n);
+	auto* p = panel.data();
+
+	// Forward process: L Y = B, or (L D^-1) Y = B with the unit diagonal
+	for (auto ib = size_t(0); ib < n; ib += NB) {
+		auto b = std::min(NB, n - ib);
+		if (ib > 0) {
+			for (auto r = size_t(0); r < b; ++r) {
+				for (auto c = size_t(0); c < ib; ++c) {
+					auto lrc = l[index<MType>(n, ib + r, c)];
+					p[r * ib + c] = Mod ? lrc / l[index<MType>(n, c, c)] : lrc;
+				}
+			}
+			lalib::_gemm_core<false>(b, nrhs, ib, T(-1), p, ib, x, nrhs, T(1), x + ib * nrhs, nrhs);
+		}
+		for (auto i = ib; i < ib + b; ++i) {
+			auto* xi = x + i * nrhs;
+			for (auto j = ib; j < i; ++j) {
+				auto coef = Mod ? l[index<MType>(n, i, j)] / l[index<MType>(n, j, j)] : l[index<MType>(n, i, j)];
+				const auto* xj = x + j * nrhs;
+				#pragma omp simd
+				for (auto k = size_t(0); k < nrhs; ++k) { xi[k] -= coef * xj[k]; }
+			}
+			if constexpr (!Mod) {
+				auto lii = l[index<MType>(n, i, i)];
+				#pragma omp simd
+				for (auto k = size_t(0); k < nrhs; ++k) { xi[k] /= lii; }
+			}
+		}
+	}
+
+	// Backward process: L^T X = Y
+	for (auto end = n; end > 0; ) {
+		auto b = std::min(NB, end);
+		auto ib = end - b;
+		auto rest = n - end;
+		if (rest > 0) {
+			for (auto r = size_t(0); r < b; ++r) {
+				for (auto c = size_t(0); c < rest; ++c) {
+					p[r * rest + c] = l[index<MType>(n, end + c, ib + r)];
+				}
+			}
+			lalib::_gemm_core<false>(b, nrhs, rest, T(-1), p, rest, x + end * nrhs, nrhs, T(1), x + ib * nrhs, nrhs);
+		}
+		for (auto i = end; i-- > ib; ) {
+			auto* xi = x + i * nrhs;
+			for (auto j = i + 1; j < end; ++j) {
+				auto lji = l[index<MType>(n, j, i)];
+				const auto* xj = x + j * nrhs;
+				#pragma omp simd
+				for (auto k = size_t(0); k < nrhs; ++k) { xi[k] -= lji * xj[k]; }
+			}
+			auto lii = l[index<MType>(n, i, i)];
+			#pragma omp simd
+			for (auto k = size_t(0); k < nrhs; ++k) { xi[k] /= lii; }
+		}
+		end = ib;
+	}
+}
+
 template<typename T, MemType MType>
 auto cholesky_linear(size_t n, size_t nrow, const double* l, const double* rhs, double* rslt) -> double* {
+	if (nrow > 1) {
+		if (rslt != rhs) { std::copy(rhs, rhs + n * nrow, rslt); }
+		blocked_cholesky_linear<double, MType>(n, nrow, l, rslt);
+		return rslt;
+	}
+
 	for (auto k = 0u; k < nrow; ++k) {
 		// Forward process
 		for (auto i = 0u; i < n; ++i) {
@@ -88,6 +391,12 @@ auto mod_cholesky_decomposition(size_t n, double* l) -> int32_t {
 
 template<typename T, MemType MType>
 auto mod_cholesky_linear(size_t n, size_t nrhs, const double* l, const double* rhs, double* rslt) {
+	if (nrhs > 1) {
+		if (rslt != rhs) { std::copy(rhs, rhs + n * nrhs, rslt); }
+		blocked_cholesky_linear<double, MType, true>(n, nrhs, l, rslt);
+		return;
+	}
+
 	for (auto k = 0u; k < nrhs; ++k) {
 		// Forward process
 		for (auto i = 0u; i < n; ++i) {
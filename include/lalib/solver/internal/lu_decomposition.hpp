@@ -0,0 +1,163 @@
+#pragma once
+#ifndef LALIB_SOLVER_INTERNAL_LU_HPP
+#define LALIB_SOLVER_INTERNAL_LU_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include "lalib/ops/mat_mat_ops_core.hpp"
+
+namespace lalib::solver::_internal_ {
+
+// ==== LU factorization with partial pivoting ==== //
+// A row-major `n` x `n` matrix is factorized in place into `P A = L U` by the recursive algorithm on the columns:
+//   LU:   [A11; A21] <- [L11; L21] U11        (the left half, recursively)
+//   TRSM: A12 <- L11^-1 A12
+//   GEMM: A22 <- A22 - L21 A12
+//   LU:   A22 <- L22 U22                      (the right half, recursively)
+// so that most of the work is a few large matrix products, which are parallel above the threshold of `Kernel::MatMul`.
+// The pivots follow LAPACK: row `i` was interchanged with row `ipiv[i] - 1`, and the interchanges span whole rows.
+
+/// @brief  The number of columns below which a panel is factorized column by column
+constexpr size_t LU_BASE_WIDTH = 16;
+
+/// @brief  The number of rows solved together between the products in the triangular solves
+constexpr size_t LU_SOLVE_BLOCK = 64;
+
+/// @brief  Performs `b <- l^-1 b` for a unit lower triangular `m` x `m` matrix `l` and an `m` x `w` matrix `b`.
+template<typename T>
+void lu_trsm_unit_lower(size_t m, size_t w, const T* l, size_t ldl, T* b, size_t ldb) {
+	for (auto ib = size_t(0); ib < m; ib += LU_SOLVE_BLOCK) {
+		auto rows = std::min(LU_SOLVE_BLOCK, m - ib);
+		if (ib > 0) {
+			lalib::_gemm_core<false>(rows, w, ib, T(-1), l + ib * ldl, ldl, b, ldb, T(1), b + ib * ldb, ldb);
+		}
+		for (auto i = ib; i < ib + rows; ++i) {
+			auto* bi = b + i * ldb;
+			for (auto j = ib; j < i; ++j) {
+				auto lij = l[i * ldl + j];
+				const auto* bj = b + j * ldb;
+				#pragma omp simd
+				for (auto k = size_t(0); k < w; ++k) { bi[k] -= lij * bj[k]; }
+			}
+		}
+	}
+}
+
+/// @brief  Factorizes the columns `[k0, k0 + w)` of the rows `[k0, n)` of `a`, column by column.
+/// @return 0 on success, or `j + 1` if the pivot of the column `j` is zero
+template<typename T>
+auto lu_panel_unblocked(size_t n, size_t k0, size_t w, T* a, int32_t* ipiv) -> size_t {
+	for (auto j = k0; j < k0 + w; ++j) {
+		auto p = j;
+		auto pmax = std::abs(a[j * n + j]);
+		for (auto i = j + 1; i < n; ++i) {
+			auto v = std::abs(a[i * n + j]);
+			if (v > pmax) { p = i; pmax = v; }
+		}
+		ipiv[j] = static_cast<int32_t>(p + 1);
+		if (a[p * n + j] == T(0)) {
+			return j + 1;
+		}
+		if (p != j) {
+			std::swap_ranges(a + j * n, a + (j + 1) * n, a + p * n);
+		}
+
+		const auto* rj = a + j * n;
+		auto inv = T(1) / rj[j];
+		for (auto i = j + 1; i < n; ++i) {
+			auto* ri = a + i * n;
+			auto lij = ri[j] * inv;
+			ri[j] = lij;
+			for (auto c = j + 1; c < k0 + w; ++c) { ri[c] -= lij * rj[c]; }
+		}
+	}
+	return 0;
+}
+
+/// @brief  Factorizes the columns `[k0, k0 + w)` of the rows `[k0, n)` of `a` recursively, updating the columns up to `k0 + w`.
+/// @return 0 on success, or `j + 1` if the pivot of the column `j` is zero
+template<typename T>
+auto lu_panel(size_t n, size_t k0, size_t w, T* a, int32_t* ipiv) -> size_t {
+	if (w <= LU_BASE_WIDTH) {
+		return lu_panel_unblocked(n, k0, w, a, ipiv);
+	}
+	auto w1 = w / 2;
+	auto w2 = w - w1;
+	auto k1 = k0 + w1;
+	if (auto rslt = lu_panel(n, k0, w1, a, ipiv); rslt != 0) {
+		return rslt;
+	}
+	lu_trsm_unit_lower(w1, w2, a + k0 * n + k0, n, a + k0 * n + k1, n);
+	if (n > k1) {
+		lalib::_gemm_core<false>(n - k1, w2, w1, T(-1), a + k1 * n + k0, n, a + k0 * n + k1, n, T(1), a + k1 * n + k1, n);
+	}
+	return lu_panel(n, k1, w2, a, ipiv);
+}
+
+/// @brief  Factorizes a row-major `n` x `n` matrix `a` into `P A = L U` in place.
+/// @details    `L` (with the unit diagonal) is stored below the diagonal and `U` on and above it.
+/// @param ipiv the pivots of `n` elements (1-based, as LAPACK)
+/// @return 0 on success, or `j + 1` if `U(j, j)` is zero
+template<typename T>
+auto lu_decomposition(size_t n, T* a, int32_t* ipiv) -> int32_t {
+	return static_cast<int32_t>(lu_panel(n, size_t(0), n, a, ipiv));
+}
+
+/// @brief  Solves `A X = B` in place with the factors of `lu_decomposition`, for `nrhs` right-hand sides stored row-major in `x`.
+/// @details    The rows of `x` are processed by blocks of `LU_SOLVE_BLOCK`, subtracting the solved rows from each block by
+///             a matrix product and then solving the block row by row. A single right-hand side is solved by dot products.
+template<typename T>
+void lu_linear(size_t n, size_t nrhs, const T* a, const int32_t* ipiv, T* x) {
+	for (auto i = size_t(0); i < n; ++i) {
+		auto p = static_cast<size_t>(ipiv[i] - 1);
+		if (p != i) {
+			std::swap_ranges(x + i * nrhs, x + (i + 1) * nrhs, x + p * nrhs);
+		}
+	}
+
+	if (nrhs == 1) {
+		for (auto i = size_t(0); i < n; ++i) {
+			const auto* ri = a + i * n;
+			auto sum = x[i];
+			for (auto j = size_t(0); j < i; ++j) { sum -= ri[j] * x[j]; }
+			x[i] = sum;
+		}
+		for (auto i = n; i-- > 0; ) {
+			const auto* ri = a + i * n;
+			auto sum = x[i];
+			for (auto j = i + 1; j < n; ++j) { sum -= ri[j] * x[j]; }
+			x[i] = sum / ri[i];
+		}
+		return;
+	}
+
+	// Forward process: L Y = P B
+	lu_trsm_unit_lower(n, nrhs, a, n, x, nrhs);
+
+	// Backward process: U X = Y
+	for (auto end = n; end > 0; ) {
+		auto b = std::min(LU_SOLVE_BLOCK, end);
+		auto ib = end - b;
+		if (end < n) {
+			lalib::_gemm_core<false>(b, nrhs, n - end, T(-1), a + ib * n + end, n, x + end * nrhs, nrhs, T(1), x + ib * nrhs, nrhs);
+		}
+		for (auto i = end; i-- > ib; ) {
+			auto* xi = x + i * nrhs;
+			for (auto j = i + 1; j < end; ++j) {
+				auto uij = a[i * n + j];
+				const auto* xj = x + j * nrhs;
+				#pragma omp simd
+				for (auto k = size_t(0); k < nrhs; ++k) { xi[k] -= uij * xj[k]; }
+			}
+			auto uii = a[i * n + i];
+			#pragma omp simd
+			for (auto k = size_t(0); k < nrhs; ++k) { xi[k] /= uii; }
+		}
+		end = ib;
+	}
+}
+
+}
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+#ifndef LALIB_SOLVER_LAPACK_GETRF_HPP
+#define LALIB_SOLVER_LAPACK_GETRF_HPP
+
+#include <complex>
+#include <cstdint>
+#include <lapacke.h>
+
+namespace lalib::solver::_lapack_ {
+
+template<typename T>
+auto getrf(int32_t n, T* a, int32_t lda, int32_t* ipiv) -> int32_t = delete;
+
+template<typename T>
+auto getrs(int32_t n, int32_t nrhs, const T* a, int32_t lda, const int32_t* ipiv, T* b, int32_t ldb) -> int32_t = delete;
+
+
+// Spacialization of GETRF
+
+template<>
+inline auto getrf<float>(int32_t n, float* a, int32_t lda, int32_t* ipiv) -> int32_t {
+    auto info = LAPACKE_sgetrf(LAPACK_ROW_MAJOR, n, n, a, lda, ipiv);
+    return info;
+}
+
+template<>
+inline auto getrf<double>(int32_t n, double* a, int32_t lda, int32_t* ipiv) -> int32_t {
+    auto info = LAPACKE_dgetrf(LAPACK_ROW_MAJOR, n, n, a, lda, ipiv);
+    return info;
+}
+
+template<>
+inline auto getrf<std::complex<float>>(int32_t n, std::complex<float>* a, int32_t lda, int32_t* ipiv) -> int32_t {
+    auto info = LAPACKE_cgetrf(LAPACK_ROW_MAJOR, n, n, reinterpret_cast<float __complex__ *>(a), lda, ipiv);
+    return info;
+}
+
+template<>
+inline auto getrf<std::complex<double>>(int32_t n, std::complex<double>* a, int32_t lda, int32_t* ipiv) -> int32_t {
+    auto info = LAPACKE_zgetrf(LAPACK_ROW_MAJOR, n, n, reinterpret_cast<double __complex__ *>(a), lda, ipiv);
+    return info;
+}
+
+
+// Spacialization of GETRS
+
+template<>
+inline auto getrs<float>(int32_t n, int32_t nrhs, const float* a, int32_t lda, const int32_t* ipiv, float* b, int32_t ldb) -> int32_t {
+    auto info = LAPACKE_sgetrs(LAPACK_ROW_MAJOR, 'N', n, nrhs, a, lda, ipiv, b, ldb);
+    return info;
+}
+
+template<>
+inline auto getrs<double>(int32_t n, int32_t nrhs, const double* a, int32_t lda, const int32_t* ipiv, double* b, int32_t ldb) -> int32_t {
+    auto info = LAPACKE_dgetrs(LAPACK_ROW_MAJOR, 'N', n, nrhs, a, lda, ipiv, b, ldb);
+    return info;
+}
+
+template<>
+inline auto getrs<std::complex<float>>(int32_t n, int32_t nrhs, const std::complex<float>* a, int32_t lda, const int32_t* ipiv, std::complex<float>* b, int32_t ldb) -> int32_t {
+    auto info = LAPACKE_cgetrs(LAPACK_ROW_MAJOR, 'N', n, nrhs, reinterpret_cast<const float __complex__ *>(a), lda, ipiv, reinterpret_cast<float __complex__ *>(b), ldb);
+    return info;
+}
+
+template<>
+inline auto getrs<std::complex<double>>(int32_t n, int32_t nrhs, const std::complex<double>* a, int32_t lda, const int32_t* ipiv, std::complex<double>* b, int32_t ldb) -> int32_t {
+    auto info = LAPACKE_zgetrs(LAPACK_ROW_MAJOR, 'N', n, nrhs, reinterpret_cast<const double __complex__ *>(a), lda, ipiv, reinterpret_cast<double __complex__ *>(b), ldb);
+    return info;
+}
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,99 @@
+#ifndef LALIB_SOLVER_LINEAR_OPERATOR_HPP
+#define LALIB_SOLVER_LINEAR_OPERATOR_HPP
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "lalib/vec/dyn_vec.hpp"
+#include "lalib/ops/mat_vec_ops.hpp"
+
+namespace lalib::solver {
+
+/// @brief      A linear operator `A` accepted by the iterative solvers.
+/// @details    Either a matrix for which `mul(alpha, a, x, beta, y)` is provided, or a type with a member 
+///             `a.apply(x, y)` performing `y <- A x`. Both must provide the shape of the operator.
+/// @tparam A   an operator type
+/// @tparam T   a floating-point type
+template<typename A, typename T>
+concept LinearOperator = 
+    requires(const A& a) {
+        { a.shape() } -> std::convertible_to<std::pair<size_t, size_t>>;
+    } && (
+        requires(const A& a, const DynVec<T>& x, DynVec<T>& y) { a.apply(x, y); } ||
+        requires(const A& a, const DynVec<T>& x, DynVec<T>& y) { mul(One<T>::value(), a, x, Zero<T>::value(), y); }
+    );
+
+/// @brief      A square linear operator defined by a function, without storing a matrix.
+/// @tparam T   a floating-point type
+/// @tparam F   a callable type with `f(x, y)` performing `y <- A x` on `DynVec<T>`.
+template<typename T, typename F>
+struct MatrixFreeOperator {
+    using ElemType = T;
+
+    /// @brief      Creates an operator.
+    /// @param n    the size of the operator
+    /// @param f    a function performing `y <- A x`. `y` has the size `n`, and never aliases `x`.
+    MatrixFreeOperator(size_t n, F f): _n(n), _f(std::move(f)) {}
+
+    /// @brief Returns the shape of the operator (row, column).
+    auto shape() const noexcept -> std::pair<size_t, size_t>
+        { return std::make_pair(this->_n, this->_n); }
+
+    /// @brief Performs `y <- A x`.
+    void apply(const DynVec<T>& x, DynVec<T>& y) const {
+        this->_f(x, y);
+    }
+
+private:
+    size_t _n;
+    F _f;
+};
+
+/// @brief      Creates a matrix-free operator.
+/// @tparam T   a floating-point type
+/// @param n    the size of the operator
+/// @param f    a function performing `y <- A x`
+template<typename T, typename F>
+auto matrix_free(size_t n, F&& f) -> MatrixFreeOperator<T, std::decay_t<F>> {
+    return MatrixFreeOperator<T, std::decay_t<F>>(n, std::forward<F>(f));
+}
+
+namespace internal {
+    /// `y <- A x`
+    template<typename T, typename A>
+    inline void _apply_operator(const A& a, const DynVec<T>& x, DynVec<T>& y) {
+        if constexpr (requires { a.apply(x, y); }) {
+            a.apply(x, y);
+        } else {
+            mul(One<T>::value(), a, x, Zero<T>::value(), y);
+        }
+    }
+
+    /// `r <- b - A x`
+    template<typename T, typename A>
+    inline void _residual(const A& a, const DynVec<T>& b, const DynVec<T>& x, DynVec<T>& r) {
+        if constexpr (requires { a.apply(x, r); }) {
+            a.apply(x, r);
+            #pragma omp simd
+            for (auto i = 0u; i < r.size(); ++i) {
+                r[i] = b[i] - r[i];
+            }
+        } else {
+            r = b;
+            mul(-One<T>::value(), a, x, One<T>::value(), r);
+        }
+    }
+
+    /// `r <- b - A x`, and returns its norm. The solvers call it to confirm the convergence of a residual updated by
+    /// a recurrence, which drifts away from `b - A x` in finite precision.
+    template<typename T, typename A>
+    inline auto _true_residual_norm(const A& a, const DynVec<T>& b, const DynVec<T>& x, DynVec<T>& r) -> T {
+        _residual(a, b, x, r);
+        return std::sqrt(dot_core(r.data(), r.data(), r.size()));
+    }
+}
+
+}
+#endif // LALIB_SOLVER_LINEAR_OPERATOR_HPP
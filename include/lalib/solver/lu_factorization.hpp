@@ -0,0 +1,128 @@
+#pragma once
+#ifndef LALIB_SOLVER_LU_HPP
+#define LALIB_SOLVER_LU_HPP
+
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "lalib/mat/dyn_mat.hpp"
+#include "lalib/solver/internal/lu_decomposition.hpp"
+#include "lalib/type_traits.hpp"
+#include "lalib/mat.hpp"
+
+#if defined(LALIB_LAPACK_BACKEND)
+#include "lalib/solver/lapack/getr.hpp"
+#endif
+
+namespace lalib::solver {
+
+/// @brief  LU factorization with partial pivoting `P A = L U` of a general square matrix
+/// @details    The factorization is blocked and parallel in the internal backend, and it is computed by GETRF
+///             under `LALIB_LAPACK_BACKEND`.
+template<typename T>
+struct DynLuFactorization {
+    /// @brief  Factorizes `mat`.
+    /// @exception  std::runtime_error  if `mat` is singular
+    DynLuFactorization(lalib::DynMat<T>&& mat);
+
+    /// @brief  Returns the factors: `L` with the unit diagonal below the diagonal, and `U` on and above it.
+	auto factor_mat() const noexcept -> const lalib::DynMat<T>&;
+
+    /// @brief  Returns the pivots: the row `i` was interchanged with the row `pivots()[i] - 1`, as LAPACK.
+    auto pivots() const noexcept -> const std::vector<int32_t>&;
+
+    template<Vector V>
+    auto solve_linear_mut(V& rslt) const -> V&;
+
+    template<Vector V>
+    auto solve_linear(const V& rhs) const -> V;
+
+    template<Matrix M>
+    auto solve_linear_mut(M& rslt) const -> M&;
+
+    template<Matrix M>
+    auto solve_linear(const M& rhs) const -> M;
+
+private:
+    size_t _n;
+    lalib::DynMat<T> _data;
+    std::vector<int32_t> _ipiv;
+};
+
+
+template<typename T>
+inline DynLuFactorization<T>::DynLuFactorization(lalib::DynMat<T>&& mat):
+    _n(mat.shape().first),
+    _data(std::move(mat)),
+    _ipiv(_n)
+{
+   	assert(this->_data.shape().first == this->_data.shape().second);
+
+	#if defined LALIB_LAPACK_BACKEND
+	auto rslt = _lapack_::getrf(this->_n, this->_data.data(), this->_n, this->_ipiv.data());
+	#else
+    auto rslt = _internal_::lu_decomposition(this->_n, this->_data.data(), this->_ipiv.data());
+	#endif
+
+	if (rslt != 0) {
+		throw std::runtime_error("[error] fail to decompose the given matrix into LU matrices (exit with code: " + std::to_string(rslt) + ")");
+	}
+}
+
+
+template<typename T>
+inline auto DynLuFactorization<T>::factor_mat() const noexcept -> const lalib::DynMat<T>& {
+	return this->_data;
+}
+
+template<typename T>
+inline auto DynLuFactorization<T>::pivots() const noexcept -> const std::vector<int32_t>& {
+	return this->_ipiv;
+}
+
+
+template<typename T>
+template<Vector V>
+inline auto DynLuFactorization<T>::solve_linear_mut(V& rhs) const -> V& {
+   	assert(this->_n == rhs.size());
+
+	#if defined LALIB_LAPACK_BACKEND
+	_lapack_::getrs(this->_n, 1, this->_data.data(), this->_n, this->_ipiv.data(), rhs.data(), 1);
+	#else
+	_internal_::lu_linear(this->_n, 1, this->_data.data(), this->_ipiv.data(), rhs.data());
+	#endif
+	return rhs;
+}
+
+template<typename T>
+template<Vector V>
+inline auto DynLuFactorization<T>::solve_linear(const V& rhs) const -> V {
+	auto rslt = rhs;
+	this->solve_linear_mut(rslt);
+	return rslt;
+}
+
+template<typename T>
+template<Matrix M>
+inline auto DynLuFactorization<T>::solve_linear_mut(M& rhs) const -> M& {
+   	assert(this->_n == rhs.shape().first);
+
+	#if defined LALIB_LAPACK_BACKEND
+	_lapack_::getrs(this->_n, rhs.shape().second, this->_data.data(), this->_n, this->_ipiv.data(), rhs.data(), rhs.shape().second);
+	#else
+	_internal_::lu_linear(this->_n, rhs.shape().second, this->_data.data(), this->_ipiv.data(), rhs.data());
+	#endif
+	return rhs;
+}
+
+template<typename T>
+template<Matrix M>
+inline auto DynLuFactorization<T>::solve_linear(const M& rhs) const -> M {
+	auto rslt = rhs;
+	this->solve_linear_mut(rslt);
+	return rslt;
+}
+
+}
+#endif
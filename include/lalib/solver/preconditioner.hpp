@@ -0,0 +1,104 @@
+#ifndef LALIB_SOLVER_PRECONDITIONER_HPP
+#define LALIB_SOLVER_PRECONDITIONER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <stdexcept>
+#include "lalib/type_traits.hpp"
+#include "lalib/vec/dyn_vec.hpp"
+
+namespace lalib::solver {
+
+/// @brief      A preconditioner `P` accepted by the iterative solvers.
+/// @details    `p.apply(in, out)` performs `out <- P^-1 in`. `out` has the same size as `in`, and may be `in` itself.
+/// @tparam P   a preconditioner type
+/// @tparam T   a floating-point type
+template<typename P, typename T>
+concept Preconditioner = requires(const P& p, const DynVec<T>& in, DynVec<T>& out) {
+    p.apply(in, out);
+};
+
+/// @brief      The side on which a preconditioner is applied.
+/// @details    `Left` solves `P^-1 A x = P^-1 b`, and the residual is measured after preconditioning.
+///             `Right` solves `A P^-1 u = b` with `x = P^-1 u`, and the residual is the true residual `b - A x`.
+enum class PrecondSide { Left, Right };
+
+
+/// @brief      The identity preconditioner, i.e. no preconditioning
+/// @tparam T   a floating-point type
+template<typename T>
+struct IdentityPreconditioner {
+    IdentityPreconditioner() noexcept = default;
+
+    /// @brief Constructs the preconditioner ignoring a matrix, so that it can be built as the other preconditioners.
+    template<Matrix M>
+    explicit IdentityPreconditioner(const M&) noexcept {}
+
+    /// @brief Performs `out <- in`.
+    void apply(const DynVec<T>& in, DynVec<T>& out) const noexcept {
+        if (&in != &out) {
+            std::copy(in.begin(), in.end(), out.begin());
+        }
+    }
+};
+
+
+/// @brief      The Jacobi (diagonal) preconditioner
+/// @tparam T   a floating-point type
+template<typename T>
+struct JacobiPreconditioner {
+    /// @brief      Constructs the preconditioner from the diagonal of a matrix.
+    /// @param mat  a square matrix
+    /// @throw      `std::runtime_error` if a diagonal element is zero
+    template<Matrix M>
+    JacobiPreconditioner(const M& mat);
+
+    /// @brief Performs `out <- D^-1 in`.
+    void apply(const DynVec<T>& in, DynVec<T>& out) const noexcept {
+        #pragma omp simd
+        for (auto i = 0u; i < this->_inv_diag.size(); ++i) {
+            out[i] = this->_inv_diag[i] * in[i];
+        }
+    }
+
+private:
+    DynVec<T> _inv_diag;
+};
+
+
+namespace internal {
+    /// Builds a preconditioner from a matrix, copying the matrix if the preconditioner consumes it (e.g. ILU).
+    template<typename P, typename M>
+    auto _make_preconditioner(const M& mat) -> P {
+        if constexpr (std::constructible_from<P, const M&>) {
+            return P(mat);
+        } else {
+            return P(M(mat));
+        }
+    }
+
+    /// Whether a preconditioner `P` can be built from a matrix `M`.
+    template<typename P, typename M>
+    concept _BuildablePreconditioner = std::constructible_from<P, const M&> || std::constructible_from<P, M&&>;
+}
+
+
+// === Implementations === //
+
+template<typename T>
+template<Matrix M>
+JacobiPreconditioner<T>::JacobiPreconditioner(const M& mat): 
+    _inv_diag(DynVec<T>::uninit(mat.shape().first))
+{
+    for (auto i = 0u; i < this->_inv_diag.size(); ++i) {
+        auto d = static_cast<T>(mat(i, i));
+        if (d == Zero<T>::value()) {
+            throw std::runtime_error("Matrix has a zero on its diagonal.");
+        }
+        this->_inv_diag[i] = One<T>::value() / d;
+    }
+}
+
+}
+#endif // LALIB_SOLVER_PRECONDITIONER_HPP
@@ -0,0 +1,23 @@
+#ifndef LALIB_SOLVER_SOLVER_STATUS_HPP
+#define LALIB_SOLVER_SOLVER_STATUS_HPP
+
+#include <cstddef>
+
+namespace lalib::solver {
+
+/// @brief      Status of an iterative solve
+/// @tparam T   a floating-point type
+template<typename T>
+struct SolverStatus {
+    /// @brief  the number of the iterations performed
+    size_t iterations;
+
+    /// @brief  the norm of the residual at the end of the solve, as measured by the solver
+    T residual;
+
+    /// @brief  whether the residual reached the tolerance
+    bool converged;
+};
+
+}
+#endif // LALIB_SOLVER_SOLVER_STATUS_HPP
@@ -17,4 +17,34 @@ TEST(CommonMatTests, InvertTest) {
     EXPECT_DOUBLE_EQ(1.0, rmat(0, 1));
     EXPECT_DOUBLE_EQ(1.5, rmat(1, 0));
     EXPECT_DOUBLE_EQ(-0.5, rmat(1, 1));
-}
\ No newline at end of file
+}
+
+TEST(CommonMatTests, InvertGeneralTest) {
+    auto mat = lalib::SizedMat<double, 3, 3>({
+        0.0, 2.0, 1.0,
+        1.0, 1.0, 0.0,
+        3.0, 0.0, 4.0
+    });
+    auto inv = lalib::inverted(mat);
+    auto id = mat * inv;
+
+    for (auto i = 0u; i < 3; ++i) {
+        for (auto j = 0u; j < 3; ++j) {
+            EXPECT_NEAR(i == j ? 1.0 : 0.0, id(i, j), 1e-12);
+        }
+    }
+
+    lalib::invert(mat);
+    for (auto i = 0u; i < 3; ++i) {
+        for (auto j = 0u; j < 3; ++j) {
+            EXPECT_DOUBLE_EQ(inv(i, j), mat(i, j));
+        }
+    }
+
+    auto singular = lalib::SizedMat<double, 3, 3>({
+        1.0, 2.0, 3.0,
+        2.0, 4.0, 6.0,
+        0.0, 1.0, 1.0
+    });
+    EXPECT_THROW({ lalib::inverted(singular); }, std::runtime_error);
+}
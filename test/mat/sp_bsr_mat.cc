@@ -0,0 +1,121 @@
+#include "lalib/mat/sp_bsr_mat.hpp"
+#include "lalib/ops/mat_vec_ops.hpp"
+#include <gtest/gtest.h>
+
+/* ------------------------------- */
+/* 1.0  2.0  0.0  0.0  3.0  0.0    */
+/* 0.0  4.0  0.0  0.0  0.0  5.0    */
+/* 0.0  0.0  6.0  7.0  0.0  0.0    */
+/* 0.0  0.0  8.0  9.0  0.0  0.0    */
+/* 0.0 10.0  0.0  0.0 11.0  0.0    */
+/* 0.0  0.0  0.0  0.0  0.0 12.0    */
+/* ------------------------------- */
+auto sample_csr_mat() -> lalib::SpMat<double> {
+    return lalib::SpMat<double>(
+        { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0 },
+        { 0, 3, 5, 7, 9, 11, 12 },
+        { 0, 1, 4, 1, 5, 2, 3, 2, 3, 1, 4, 5 }
+    );
+}
+
+TEST(SpBsrMatTests, SpBsrMatCreationTest) {
+    using SpBsrMatD = lalib::SpBsrMat<double, 2>;
+
+    EXPECT_NO_THROW({
+        SpBsrMatD(
+            { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0 },
+            { 0, 1, 2 },
+            { 0, 1 }
+        );
+    });
+
+    EXPECT_THROW({
+        SpBsrMatD(
+            { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0 },
+            { 0, 1, 2 },
+            { 0, 1 }
+        );
+    }, std::runtime_error);
+
+    // 6 x 6 matrix cannot be split into 4 x 4 blocks
+    using SpBsrMatD4 = lalib::SpBsrMat<double, 4>;
+    EXPECT_THROW({
+        auto mat = SpBsrMatD4(sample_csr_mat());
+    }, std::invalid_argument);
+}
+
+TEST(SpBsrMatTests, SpBsrMatShapeTest) {
+    using SpBsrMatD = lalib::SpBsrMat<double, 2>;
+
+    // The trailing block column is empty, so it cannot be inferred from the indices
+    auto mat = SpBsrMatD(
+        { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0 },
+        { 0, 1, 2 },
+        { 0, 1 },
+        3
+    );
+    auto [n, m] = mat.shape();
+    ASSERT_EQ(4, n);
+    ASSERT_EQ(6, m);
+    auto [nb, mb] = mat.block_shape();
+    ASSERT_EQ(2, nb);
+    ASSERT_EQ(3, mb);
+
+    auto v = lalib::DynVec<double>({ 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 });
+    auto vr = mat * v;
+    ASSERT_EQ(4, vr.size());
+    EXPECT_DOUBLE_EQ(3.0, vr[0]);
+    EXPECT_DOUBLE_EQ(7.0, vr[1]);
+    EXPECT_DOUBLE_EQ(11.0, vr[2]);
+    EXPECT_DOUBLE_EQ(15.0, vr[3]);
+
+    auto inferred = SpBsrMatD({ 1.0, 2.0, 3.0, 4.0 }, { 0, 1 }, { 1 });
+    auto [ni, mi] = inferred.block_shape();
+    ASSERT_EQ(1, ni);
+    ASSERT_EQ(2, mi);
+
+    // A block column index beyond `nbcol`
+    EXPECT_THROW({ SpBsrMatD({ 1.0, 2.0, 3.0, 4.0 }, { 0, 1 }, { 2 }, 2); }, std::invalid_argument);
+    // Empty block row pointers
+    EXPECT_THROW({ SpBsrMatD({}, {}, {}); }, std::invalid_argument);
+    // Block row pointers that do not end at the number of blocks
+    EXPECT_THROW({ SpBsrMatD({ 1.0, 2.0, 3.0, 4.0 }, { 0, 0 }, { 0 }); }, std::invalid_argument);
+
+    // An empty matrix
+    auto empty = SpBsrMatD({}, { 0 }, {});
+    auto [ne, me] = empty.shape();
+    ASSERT_EQ(0, ne);
+    ASSERT_EQ(0, me);
+}
+
+TEST(SpBsrMatTests, CsrBsrConversionTest) {
+    auto csr = sample_csr_mat();
+    auto mat = lalib::SpBsrMat<double, 2>(csr);
+
+    ASSERT_EQ(mat.shape().first, 6);
+    ASSERT_EQ(mat.shape().second, 6);
+    ASSERT_EQ(mat.block_shape().first, 3);
+    ASSERT_EQ(mat.block_shape().second, 3);
+    ASSERT_EQ(mat.nblocks(), 5);
+    ASSERT_EQ(mat.nnz(), 20);
+
+    ASSERT_EQ(mat.row_ptr(), (std::vector<size_t>{ 0, 2, 3, 5 }));
+    ASSERT_EQ(mat.col_indices(), (std::vector<size_t>{ 0, 2, 1, 0, 2 }));
+
+    for (auto i = 0u; i < 6; ++i) {
+        for (auto j = 0u; j < 6; ++j) {
+            ASSERT_EQ(mat(i, j), csr(i, j));
+        }
+    }
+}
+
+TEST(SpBsrMatTests, SpBsrMatMutAtTest) {
+    auto mat = lalib::SpBsrMat<double, 2>(sample_csr_mat());
+
+    // Explicit zeros inside the stored blocks are accessible
+    mat.mut_at(1, 0) = 13.0;
+    ASSERT_EQ(mat(1, 0), 13.0);
+
+    EXPECT_THROW({ mat.mut_at(0, 2); }, std::out_of_range);
+    EXPECT_THROW({ mat.mut_at(6, 0); }, std::out_of_range);
+}
@@ -305,4 +305,116 @@ TEST(SpMatTests, CooMatrixAddAssignTest) {
     ASSERT_EQ(mat3(4, 2), 0.0);
     ASSERT_EQ(mat3(4, 3), 0.0);
     ASSERT_EQ(mat3(4, 4), 1.0);
-}
\ No newline at end of file
+}
+
+TEST(SpMatTests, SpMatRowPartitionTest) {
+    /* ----------------------------- */
+    /* 1.0  2.0  3.0  4.0  0.0  0.0  */
+    /* 0.0  5.0  0.0  0.0  0.0  0.0  */
+    /* 0.0  0.0  6.0  0.0  0.0  0.0  */
+    /* 0.0  0.0  0.0  7.0  0.0  0.0  */
+    /* 0.0  0.0  0.0  0.0  8.0  0.0  */
+    /* 0.0  0.0  0.0  0.0  9.0 10.0  */
+    /* ----------------------------- */
+    auto mat = lalib::SpMat<double>(
+        { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0 },
+        { 0, 4, 5, 6, 7, 8, 10 },
+        { 0, 1, 2, 3, 1, 2, 3, 4, 4, 5 }
+    );
+
+    const auto& part1 = mat.row_partition(1);
+    ASSERT_EQ(part1.size(), 2);
+    ASSERT_EQ(part1[0], 0);
+    ASSERT_EQ(part1[1], 6);
+
+    // The first row holds as many non-zeros as the rest of the matrix does.
+    const auto& part2 = mat.row_partition(2);
+    ASSERT_EQ(part2.size(), 3);
+    ASSERT_EQ(part2[0], 0);
+    ASSERT_EQ(part2[1], 2);
+    ASSERT_EQ(part2[2], 6);
+
+    // More chunks than rows leaves some chunks empty
+    const auto& part8 = mat.row_partition(8);
+    ASSERT_EQ(part8.size(), 9);
+    ASSERT_EQ(part8.front(), 0);
+    ASSERT_EQ(part8.back(), 6);
+    for (auto p = 0u; p < 8; ++p) {
+        ASSERT_LE(part8[p], part8[p + 1]);
+    }
+}
+
+TEST(SpMatTests, SpMatIndexTypeTest) {
+    /* ----------------------------- */
+    /* 1.0  0.0  2.0                 */
+    /* 0.0  3.0  0.0                 */
+    /* 4.0  0.0  5.0                 */
+    /* ----------------------------- */
+    auto coo = lalib::SpCooMat<double, uint32_t>(
+        { 1.0, 2.0, 3.0, 4.0, 5.0 },
+        { 0, 0, 1, 2, 2 },
+        { 0, 2, 1, 0, 2 }
+    );
+    auto mat = lalib::SpMat<double, uint32_t>(coo);
+    static_assert(std::is_same_v<decltype(mat)::IndexType, uint32_t>);
+
+    ASSERT_EQ(mat.shape().first, 3);
+    ASSERT_EQ(mat.shape().second, 3);
+    ASSERT_EQ(mat.row_ptr(), (std::vector<uint32_t>{ 0, 2, 3, 5 }));
+    ASSERT_EQ(mat(2, 2), 5.0);
+
+    // Conversion between the index types
+    auto wide = lalib::SpMat<double>(mat);
+    auto narrow = lalib::SpMat<double, uint32_t>(wide);
+    ASSERT_EQ(wide.row_ptr(), (std::vector<size_t>{ 0, 2, 3, 5 }));
+    ASSERT_EQ(narrow.col_indices(), mat.col_indices());
+
+    // Indices which do not fit in the index type
+    auto large = lalib::SpMat<double>({ 1.0 }, { 0, 1 }, { 300 });
+    using SpMatU8 = lalib::SpMat<double, uint8_t>;
+    EXPECT_THROW({ auto m = SpMatU8(large); }, std::overflow_error);
+    EXPECT_THROW({ auto m = SpMatU8::unit(300); }, std::overflow_error);
+}
+
+TEST(SpMatTests, ExplicitShapeTest) {
+    /* ----------------------------- */
+    /* 1.0  0.0  0.0  0.0            */
+    /* 0.0  2.0  0.0  0.0            */
+    /* 0.0  0.0  0.0  0.0            */
+    /* ----------------------------- */
+    auto coo = lalib::SpCooMat<double>({ 1.0, 2.0 }, { 0, 1 }, { 0, 1 }, 3, 4);
+    ASSERT_EQ(coo.shape().first, 3);
+    ASSERT_EQ(coo.shape().second, 4);
+
+    // Trailing empty rows are kept by the conversion
+    auto mat = lalib::SpMat<double>(coo);
+    ASSERT_EQ(mat.shape().first, 3);
+    ASSERT_EQ(mat.shape().second, 4);
+    ASSERT_EQ(mat.row_ptr(), (std::vector<size_t>{ 0, 1, 2, 2 }));
+
+    auto mat2 = lalib::SpMat<double>({ 1.0, 2.0 }, { 0, 1, 2, 2 }, { 0, 1 }, 4);
+    ASSERT_EQ(mat2.shape().first, 3);
+    ASSERT_EQ(mat2.shape().second, 4);
+
+    // Omitted shape is inferred from the indices
+    auto mat3 = lalib::SpMat<double>({ 1.0, 2.0 }, { 0, 1, 2, 2 }, { 0, 1 });
+    ASSERT_EQ(mat3.shape().second, 2);
+
+    // Empty matrices
+    ASSERT_EQ(lalib::SpMat<double>().shape(), std::make_pair(size_t(0), size_t(0)));
+    ASSERT_EQ(lalib::SpCooMat<double>().shape(), std::make_pair(size_t(0), size_t(0)));
+
+    EXPECT_THROW({
+        auto m = lalib::SpMat<double>({ 1.0, 2.0 }, { 0, 1, 2 }, { 0, 3 }, 3);
+    }, std::invalid_argument);
+    EXPECT_THROW({
+        auto m = lalib::SpCooMat<double>({ 1.0, 2.0 }, { 0, 3 }, { 0, 1 }, 3, 3);
+    }, std::invalid_argument);
+
+    // Addition extends the shape to the larger one
+    auto coo2 = lalib::SpCooMat<double>({ 3.0 }, { 4 }, { 0 }, 5, 2);
+    coo += coo2;
+    ASSERT_EQ(coo.shape().first, 5);
+    ASSERT_EQ(coo.shape().second, 4);
+    ASSERT_EQ(coo(4, 0), 3.0);
+}
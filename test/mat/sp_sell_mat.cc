@@ -0,0 +1,87 @@
+#include "lalib/mat/sp_sell_mat.hpp"
+#include <gtest/gtest.h>
+
+/* ------------------------ */
+/* 1.0  2.0  0.0  0.0  0.0  */
+/* 3.0  0.0  0.0  0.0  0.0  */
+/* 0.0  4.0  5.0  6.0  7.0  */
+/* 0.0  0.0  0.0  8.0  0.0  */
+/* 9.0  0.0 10.0  0.0 11.0  */
+/* ------------------------ */
+auto sample_csr_mat() -> lalib::SpMat<double> {
+    return lalib::SpMat<double>(
+        { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0 },
+        { 0, 2, 3, 7, 8, 11 },
+        { 0, 1, 0, 1, 2, 3, 4, 3, 0, 2, 4 }
+    );
+}
+
+TEST(SpSellMatTests, SpSellMatCreationTest) {
+    auto csr = sample_csr_mat();
+    auto mat = lalib::SpSellMat<double, 2>(csr, 4);
+
+    ASSERT_EQ(mat.shape().first, 5);
+    ASSERT_EQ(mat.shape().second, 5);
+    ASSERT_EQ(mat.nnz(), 11);
+    ASSERT_EQ(mat.nslices(), 3);
+
+    // Rows sorted by length within the first window: 2 (4), 0 (2), 1 (1), 3 (1), followed by 4 (3)
+    ASSERT_EQ(mat.permutation()[0], 2);
+    ASSERT_EQ(mat.permutation()[1], 0);
+    ASSERT_EQ(mat.permutation()[4], 4);
+    ASSERT_EQ(mat.slice_len()[0], 4);
+    ASSERT_EQ(mat.slice_len()[1], 1);
+    ASSERT_EQ(mat.slice_len()[2], 3);
+    ASSERT_EQ(mat.padded_size(), 2 * (4 + 1 + 3));
+
+    for (auto i = 0u; i < 5; ++i) {
+        for (auto j = 0u; j < 5; ++j) {
+            ASSERT_EQ(mat(i, j), csr(i, j));
+        }
+    }
+}
+
+TEST(SpSellMatTests, SpSellMatUnsortedCreationTest) {
+    auto csr = sample_csr_mat();
+    auto mat = lalib::SpSellMat<double, 4>(csr, 1);
+
+    ASSERT_EQ(mat.nslices(), 2);
+    for (auto k = 0u; k < 5; ++k) {
+        ASSERT_EQ(mat.permutation()[k], k);
+    }
+    for (auto i = 0u; i < 5; ++i) {
+        for (auto j = 0u; j < 5; ++j) {
+            ASSERT_EQ(mat(i, j), csr(i, j));
+        }
+    }
+}
+
+TEST(SpSellMatTests, CooSellConversionTest) {
+    auto coo = lalib::SpCooMat<double> {
+        { 1.0, 2.0, 3.0, 4.0, 5.0 },
+        { 0, 0, 1, 2, 2 },
+        { 0, 1, 0, 1, 2 }
+    };
+    auto mat = lalib::SpSellMat<double>(coo);
+
+    ASSERT_EQ(mat.shape().first, 3);
+    ASSERT_EQ(mat.shape().second, 3);
+    ASSERT_EQ(mat(0, 0), 1.0);
+    ASSERT_EQ(mat(0, 1), 2.0);
+    ASSERT_EQ(mat(0, 2), 0.0);
+    ASSERT_EQ(mat(1, 0), 3.0);
+    ASSERT_EQ(mat(1, 1), 0.0);
+    ASSERT_EQ(mat(2, 1), 4.0);
+    ASSERT_EQ(mat(2, 2), 5.0);
+}
+
+TEST(SpSellMatTests, SpSellMatMutAtTest) {
+    auto mat = lalib::SpSellMat<double, 2>(sample_csr_mat());
+
+    mat.mut_at(2, 3) = 60.0;
+    ASSERT_EQ(mat(2, 3), 60.0);
+
+    // Padded and zero elements are not accessible
+    EXPECT_THROW({ mat.mut_at(1, 1); }, std::out_of_range);
+    EXPECT_THROW({ mat.mut_at(3, 0); }, std::out_of_range);
+}
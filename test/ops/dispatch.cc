@@ -0,0 +1,108 @@
+#include "lalib/ops/dispatch.hpp"
+#include "lalib/ops/vec_ops.hpp"
+#include "lalib/vec/sized_vec.hpp"
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <sstream>
+#include <omp.h>
+
+TEST(DispatchTests, DefaultThresholdTest) {
+    lalib::reset_parallel_thresholds();
+    ASSERT_EQ(1u << 15, lalib::parallel_threshold<double>(lalib::Kernel::Add));
+    ASSERT_EQ(1u << 15, lalib::parallel_threshold<std::complex<float>>(lalib::Kernel::Dot));
+
+    // A small vector never starts a parallel region
+    ASSERT_FALSE(lalib::_use_parallel<double>(lalib::Kernel::Add, 16));
+    auto v1 = lalib::SizedVec<double, 16>::filled(1.0);
+    auto v2 = lalib::SizedVec<double, 16>::filled(2.0);
+    auto vr = v1 + v2;
+    for (auto i = 0u; i < 16; ++i) {
+        ASSERT_DOUBLE_EQ(3.0, vr[i]);
+    }
+}
+
+TEST(DispatchTests, SetThresholdTest) {
+    lalib::reset_parallel_thresholds();
+    lalib::set_parallel_threshold<float>(lalib::Kernel::Axpy, 100);
+    ASSERT_EQ(100u, lalib::parallel_threshold<float>(lalib::Kernel::Axpy));
+    ASSERT_EQ(1u << 15, lalib::parallel_threshold<double>(lalib::Kernel::Axpy));
+
+    lalib::set_parallel_threshold(lalib::Kernel::Dot, lalib::NeverParallel);
+    ASSERT_EQ(lalib::NeverParallel, lalib::parallel_threshold<double>(lalib::Kernel::Dot));
+    ASSERT_EQ(lalib::NeverParallel, lalib::parallel_threshold<int>(lalib::Kernel::Dot));
+    ASSERT_FALSE(lalib::_use_parallel<double>(lalib::Kernel::Dot, SIZE_MAX - 1));
+    lalib::reset_parallel_thresholds();
+}
+
+TEST(DispatchTests, LoadSaveTest) {
+    lalib::reset_parallel_thresholds();
+    auto iss = std::istringstream("# tuned\nadd.double = 65536, dot=never\n\nspmv.cfloat=1000 # comment\n");
+    lalib::load_thresholds(iss);
+    ASSERT_EQ(65536u, lalib::parallel_threshold<double>(lalib::Kernel::Add));
+    ASSERT_EQ(1u << 15, lalib::parallel_threshold<float>(lalib::Kernel::Add));
+    ASSERT_EQ(lalib::NeverParallel, lalib::parallel_threshold<float>(lalib::Kernel::Dot));
+    ASSERT_EQ(1000u, lalib::parallel_threshold<std::complex<float>>(lalib::Kernel::SpMatVec));
+
+    // Round trip
+    auto oss = std::ostringstream();
+    lalib::save_thresholds(oss);
+    lalib::reset_parallel_thresholds();
+    auto saved = std::istringstream(oss.str());
+    lalib::load_thresholds(saved);
+    ASSERT_EQ(65536u, lalib::parallel_threshold<double>(lalib::Kernel::Add));
+    ASSERT_EQ(lalib::NeverParallel, lalib::parallel_threshold<std::complex<double>>(lalib::Kernel::Dot));
+    ASSERT_EQ(1000u, lalib::parallel_threshold<std::complex<float>>(lalib::Kernel::SpMatVec));
+
+    // Invalid entries throw after the valid ones are applied
+    auto invalid = std::istringstream("scal=12,foo=1,add.int=3,neg=-1,axpy=abc");
+    ASSERT_THROW(lalib::load_thresholds(invalid), std::runtime_error);
+    ASSERT_EQ(12u, lalib::parallel_threshold<float>(lalib::Kernel::Scal));
+    ASSERT_THROW(lalib::load_thresholds(std::string("/nonexistent/thresholds.txt")), std::runtime_error);
+    lalib::reset_parallel_thresholds();
+}
+
+TEST(DispatchTests, EnvironmentTest) {
+    // `LALIB_THRESHOLDS` is set by the test runner
+    if (std::getenv("LALIB_THRESHOLDS") == nullptr) {
+        GTEST_SKIP() << "LALIB_THRESHOLDS is not set";
+    }
+    ASSERT_EQ(12345u, lalib::parallel_threshold<float>(lalib::Kernel::MatVec));
+    ASSERT_EQ(lalib::NeverParallel, lalib::parallel_threshold<double>(lalib::Kernel::Neg));
+    ASSERT_EQ(1u << 15, lalib::parallel_threshold<double>(lalib::Kernel::MatVec));
+}
+
+TEST(DispatchTests, SerialRegionTest) {
+    lalib::reset_parallel_thresholds();
+    lalib::set_parallel_threshold(lalib::Kernel::Add, 1);
+    if (omp_get_max_threads() > 1) {
+        ASSERT_TRUE(lalib::_use_parallel<double>(lalib::Kernel::Add, 1024));
+    }
+    {
+        auto serial = lalib::SerialRegion();
+        ASSERT_FALSE(lalib::_use_parallel<double>(lalib::Kernel::Add, 1024));
+        {
+            auto nested = lalib::SerialRegion();
+            ASSERT_FALSE(lalib::_use_parallel<double>(lalib::Kernel::Add, 1024));
+        }
+        ASSERT_FALSE(lalib::_use_parallel<double>(lalib::Kernel::Add, 1024));
+    }
+    if (omp_get_max_threads() > 1) {
+        ASSERT_TRUE(lalib::_use_parallel<double>(lalib::Kernel::Add, 1024));
+    }
+
+    // Kernels called inside a parallel region run serially and still compute the full result
+    auto allowed = 0;
+    auto results = std::vector<double>(4);
+    #pragma omp parallel for num_threads(4) reduction(+:allowed)
+    for (auto t = 0; t < 4; ++t) {
+        allowed += lalib::_use_parallel<double>(lalib::Kernel::Add, 1024) ? 1 : 0;
+        auto v1 = lalib::DynVec<double>::filled(1024, 1.0);
+        auto v2 = lalib::DynVec<double>::filled(1024, 2.0);
+        results[t] = lalib::dot(v1 + v2, v1);
+    }
+    ASSERT_EQ(0, allowed);
+    for (auto r: results) {
+        ASSERT_DOUBLE_EQ(3072.0, r);
+    }
+    lalib::reset_parallel_thresholds();
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "lalib/ops/isa.hpp"
+#include "lalib/ops/vec_ops_core.hpp"
+#include "lalib/ops/mat_vec_ops_core.hpp"
+#include "lalib/ops/mat_mat_ops_core.hpp"
+#include <gtest/gtest.h>
+#include <complex>
+#include <random>
+#include <vector>
+#include "test_values.hpp"
+
+/// Runs `f` for each instruction set supported by the CPU, restoring the active one afterwards.
+template<typename F>
+void for_each_isa(F f) {
+    auto active = lalib::active_isa();
+    for (auto isa: { lalib::Isa::Baseline, lalib::Isa::Avx2, lalib::Isa::Avx512 }) {
+        if (isa > lalib::detected_isa()) { break; }
+        ASSERT_EQ(isa, lalib::set_isa(isa));
+        f(isa);
+    }
+    lalib::set_isa(active);
+}
+
+template<typename T>
+void check_gemm(size_t n, size_t m, size_t l, double tol) {
+    auto rand = std::mt19937(7);
+    auto a = random_values<T>(n * l, rand);
+    auto b = random_values<T>(l * m, rand);
+    auto c = random_values<T>(n * m, rand);
+    auto alpha = T(0.75);
+    auto beta = T(2.0);
+    auto expected = reference_mul(n, m, l, alpha, a, b, beta, c);
+
+    for_each_isa([&](lalib::Isa isa) {
+        auto r = c;
+        lalib::mul_core(n, m, l, alpha, a.data(), b.data(), beta, r.data());
+        for (auto i = 0u; i < n * m; ++i) {
+            ASSERT_NEAR(0.0, std::abs(expected[i] - r[i]), tol * l) << "isa " << static_cast<int>(isa) << ", " << i;
+        }
+    });
+}
+
+TEST(IsaTests, DetectionTest) {
+    ASSERT_LE(lalib::active_isa(), lalib::detected_isa());
+    auto active = lalib::active_isa();
+    // A set beyond the CPU is clamped
+    ASSERT_EQ(lalib::detected_isa(), lalib::set_isa(lalib::Isa::Avx512));
+    ASSERT_EQ(lalib::Isa::Baseline, lalib::set_isa(lalib::Isa::Baseline));
+    ASSERT_EQ(lalib::Isa::Baseline, lalib::active_isa());
+    lalib::set_isa(active);
+
+    ASSERT_EQ(lalib::Isa::Avx2, lalib::_parse_isa("avx2", lalib::Isa::Baseline));
+    ASSERT_EQ(lalib::Isa::Baseline, lalib::_parse_isa("sse2", lalib::Isa::Avx512));
+    ASSERT_EQ(lalib::Isa::Avx512, lalib::_parse_isa("neon", lalib::Isa::Avx512));
+    ASSERT_EQ(lalib::Isa::Avx2, lalib::_parse_isa(nullptr, lalib::Isa::Avx2));
+}
+
+TEST(IsaTests, GemmTest) {
+    // Sizes with ragged edges for the micro-tiles of every instruction set
+    check_gemm<double>(67, 45, 300, 1e-14);
+    check_gemm<double>(13, 17, 9, 1e-14);
+    check_gemm<double>(100, 100, 100, 1e-14);
+    check_gemm<float>(131, 70, 260, 1e-5);
+    check_gemm<float>(25, 33, 40, 1e-5);
+    check_gemm<std::complex<float>>(45, 37, 270, 1e-5);
+    check_gemm<std::complex<double>>(70, 33, 259, 1e-14);
+}
+
+TEST(IsaTests, GemvTest) {
+    auto rand = std::mt19937(11);
+    auto n = 37u, m = 53u;
+    auto a = random_values<double>(n * m, rand);
+    auto x = random_values<double>(m, rand);
+    auto y = random_values<double>(n, rand);
+    auto expected = std::vector<double>(n);
+    for (auto i = 0u; i < n; ++i) {
+        auto sum = 0.0;
+        for (auto k = 0u; k < m; ++k) {
+            sum += a[i * m + k] * x[k];
+        }
+        expected[i] = 1.5 * sum - 0.5 * y[i];
+    }
+
+    for_each_isa([&](lalib::Isa) {
+        auto r = y;
+        lalib::mul_core(n, m, 1.5, a.data(), x.data(), -0.5, r.data());
+        for (auto i = 0u; i < n; ++i) {
+            ASSERT_NEAR(expected[i], r[i], 1e-13);
+        }
+    });
+}
+
+TEST(IsaTests, VecOpsTest) {
+    auto rand = std::mt19937(13);
+    auto size = 1003u;
+    auto x = random_values<double>(size, rand);
+    auto y = random_values<double>(size, rand);
+    auto cx = random_values<std::complex<float>>(size, rand);
+    auto cy = random_values<std::complex<float>>(size, rand);
+
+    auto dot = 0.0, sumsq = 0.0;
+    auto cdot = std::complex<double>{};
+    for (auto i = 0u; i < size; ++i) {
+        dot += x[i] * y[i];
+        sumsq += x[i] * x[i];
+        cdot += std::complex<double>(cx[i]) * std::complex<double>(cy[i]);
+    }
+
+    for_each_isa([&](lalib::Isa) {
+        ASSERT_NEAR(dot, dot_core(x.data(), y.data(), size), 1e-12);
+        ASSERT_NEAR(std::sqrt(sumsq), norm2_core(x.data(), size), 1e-12);
+        ASSERT_NEAR(0.0, std::abs(cdot - std::complex<double>(dot_core(cx.data(), cy.data(), size))), 1e-3);
+
+        auto r = std::vector<double>(size);
+        add_core(x.data(), y.data(), r.data(), size);
+        for (auto i = 0u; i < size; ++i) {
+            ASSERT_DOUBLE_EQ(x[i] + y[i], r[i]);
+        }
+        axpy_core(2.0, x.data(), r.data(), size);
+        for (auto i = 0u; i < size; ++i) {
+            ASSERT_NEAR(3.0 * x[i] + y[i], r[i], 1e-15);
+        }
+    });
+}
+
+TEST(IsaTests, EnvironmentTest) {
+    // ctest runs the tests with `LALIB_ISA=sse2`
+    if (std::getenv("LALIB_ISA") == nullptr) {
+        GTEST_SKIP();
+    }
+    ASSERT_EQ(lalib::Isa::Baseline, lalib::active_isa());
+}
\ No newline at end of file
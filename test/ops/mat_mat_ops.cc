@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 #include "lalib/ops/mat_mat_ops.hpp"
+#include "test_values.hpp"
+#include <complex>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
 
 TEST(MatMatOpsTests, SizedMatSizedMatAddTest) {
     auto m1 = lalib::SizedMat<double, 2, 3>({
@@ -107,4 +112,75 @@ TEST(MatMatOpsTests, SizedMatSizedMatMulAssignTest) {
     ASSERT_DOUBLE_EQ(alpha * 11.0 + beta * 3.0, m1(0, 1));
     ASSERT_DOUBLE_EQ(alpha * 10.0 + beta * 2.0, m1(1, 0));
     ASSERT_DOUBLE_EQ(alpha * 16.0 + beta * 4.0, m1(1, 1));
+}
+
+// ### Blocked multiplication ### //
+template<typename T>
+void check_blocked_mul(size_t n, size_t m, size_t l, double tol) {
+    auto rand = std::mt19937(42);
+    auto a = random_values<T>(n * l, rand);
+    auto b = random_values<T>(l * m, rand);
+    auto c = random_values<T>(n * m, rand);
+    auto alpha = T(1.5);
+    auto beta = T(-0.5);
+    auto expected = reference_mul(n, m, l, alpha, a, b, beta, c);
+
+    auto ma = lalib::DynMat<T>(n, l, std::vector<T>(a));
+    auto mb = lalib::DynMat<T>(l, m, std::vector<T>(b));
+    auto mc = lalib::DynMat<T>(n, m, std::vector<T>(c));
+    lalib::mul(alpha, ma, mb, beta, mc);
+    for (auto i = 0u; i < n; ++i) {
+        for (auto j = 0u; j < m; ++j) {
+            ASSERT_NEAR(0.0, std::abs(expected[i * m + j] - mc(i, j)), tol * l) << i << ", " << j;
+        }
+    }
+
+    // `beta = 0` overwrites the result even if it holds NaN
+    auto nan = lalib::DynMat<T>::filled(T(std::numeric_limits<double>::quiet_NaN()), n, m);
+    lalib::mul(T(1), ma, mb, T(0), nan);
+    auto product = reference_mul(n, m, l, T(1), a, b, T(0), c);
+    for (auto i = 0u; i < n; ++i) {
+        for (auto j = 0u; j < m; ++j) {
+            ASSERT_NEAR(0.0, std::abs(product[i * m + j] - nan(i, j)), tol * l);
+        }
+    }
+}
+
+TEST(MatMatOpsTests, BlockedMulTest) {
+    // Sizes across the micro-tiles, the `KC` panels and the `MC` blocks with ragged edges
+    check_blocked_mul<double>(67, 45, 300, 1e-14);
+    check_blocked_mul<double>(257, 131, 19, 1e-14);
+    check_blocked_mul<float>(131, 70, 260, 1e-5);
+    check_blocked_mul<std::complex<float>>(45, 37, 270, 1e-5);
+    check_blocked_mul<std::complex<double>>(70, 33, 259, 1e-14);
+    check_blocked_mul<double>(3, 2, 5, 1e-14);
+}
+
+TEST(MatMatOpsTests, BlockedMulParallelTest) {
+    lalib::set_parallel_threshold(lalib::Kernel::MatMul, 1);
+    check_blocked_mul<double>(300, 4100, 20, 1e-14);
+    check_blocked_mul<std::complex<double>>(129, 67, 513, 1e-14);
+    lalib::reset_parallel_thresholds();
+}
+
+TEST(MatMatOpsTests, BlockedMulAssignTest) {
+    auto rand = std::mt19937(7);
+    auto n = size_t(100);
+    auto a = random_values<double>(n * n, rand);
+    auto b = random_values<double>(n * n, rand);
+    auto expected = reference_mul(n, n, n, 2.0, a, b, 3.0, a);
+
+    auto ma = lalib::DynMat<double>(n, n, std::vector<double>(a));
+    auto mb = lalib::DynMat<double>(n, n, std::vector<double>(b));
+    lalib::mul(2.0, ma, mb, 3.0, ma);
+    for (auto i = 0u; i < n; ++i) {
+        for (auto j = 0u; j < n; ++j) {
+            ASSERT_NEAR(expected[i * n + j], ma(i, j), 1e-12);
+        }
+    }
+
+    auto mf = lalib::DynMat<float>(2, 2, { 1.0f, 2.0f, 3.0f, 4.0f });
+    auto mf2 = mf * mf;
+    ASSERT_FLOAT_EQ(7.0f, mf2(0, 0));
+    ASSERT_FLOAT_EQ(22.0f, mf2(1, 1));
 }
\ No newline at end of file
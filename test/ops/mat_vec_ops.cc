@@ -1,5 +1,9 @@
 #include "lalib/ops/mat_vec_ops.hpp"
 #include <iostream>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <utility>
 #include <gtest/gtest.h>
 
 // ### Matrix-Vector Multiplication ### //
@@ -102,4 +106,410 @@ TEST(MatVecOpsTests, SpMatDynVecMulTest) {
     EXPECT_DOUBLE_EQ(alpha * 8.0 + beta, vr[0]);
     EXPECT_DOUBLE_EQ(alpha * 12.0 + beta, vr[1]);
     EXPECT_DOUBLE_EQ(alpha * 19.0 + beta, vr[2]);
+}
+
+TEST(MatVecOpsTests, SpMatDynVecParallelMulTest) {
+    // Skewed tri-diagonal matrix whose first row is dense
+    auto n = 1000u;
+    auto val = std::vector<double>();
+    auto row_ptr = std::vector<size_t>{ 0 };
+    auto col_ids = std::vector<size_t>();
+    for (auto i = 0u; i < n; ++i) {
+        auto begin = (i == 0) ? 0u : i - 1;
+        auto end = (i == 0) ? n : std::min(i + 2, n);
+        for (auto j = begin; j < end; ++j) {
+            val.emplace_back(1.0 + 0.001 * i + 0.01 * j);
+            col_ids.emplace_back(j);
+        }
+        row_ptr.emplace_back(col_ids.size());
+    }
+    auto m = lalib::SpMat<double>(val, row_ptr, col_ids);
+    auto v = lalib::DynVec<double>::filled(n, 0.5);
+
+    auto expected = lalib::DynVec<double>::filled(n, 1.0);
+    lalib::_sp_mul_core(n, col_ids.data(), row_ptr.data(), 2.0, val.data(), v.data(), 3.0, expected.data());
+
+    for (auto nparts: { 1u, 2u, 3u, 4u, 7u }) {
+        const auto& part = m.row_partition(nparts);
+        auto vr = lalib::DynVec<double>::filled(n, 1.0);
+        lalib::sp_mul_core(part.size() - 1, part.data(), col_ids.data(), row_ptr.data(), 2.0, val.data(), v.data(), 3.0, vr.data());
+
+        for (auto i = 0u; i < n; ++i) {
+            EXPECT_DOUBLE_EQ(expected[i], vr[i]);
+        }
+    }
+
+    auto vr = m * v;
+    for (auto i = 0u; i < n; ++i) {
+        EXPECT_DOUBLE_EQ((expected[i] - 3.0) / 2.0, vr[i]);
+    }
+}
+
+TEST(MatVecOpsTests, SpMatDynVecSharedMulTest) {
+    // Products on one shared matrix from the threads of a parallel region, mixed with parallel products outside of it
+    auto n = 2000u;
+    auto val = std::vector<double>();
+    auto row_ptr = std::vector<size_t>{ 0 };
+    auto col_ids = std::vector<size_t>();
+    for (auto i = 0u; i < n; ++i) {
+        for (auto j = (i == 0 ? 0u : i - 1); j < std::min(i + 2, n); ++j) {
+            val.emplace_back(1.0 + 0.001 * i + 0.01 * j);
+            col_ids.emplace_back(j);
+        }
+        row_ptr.emplace_back(col_ids.size());
+    }
+    const auto m = lalib::SpMat<double>(val, row_ptr, col_ids);
+    auto v = lalib::DynVec<double>::filled(n, 0.5);
+    auto expected = lalib::DynVec<double>::filled(n, 0.0);
+    lalib::_sp_mul_core(n, col_ids.data(), row_ptr.data(), 1.0, val.data(), v.data(), 0.0, expected.data());
+
+    lalib::set_parallel_threshold(lalib::Kernel::SpMatVec, 1);
+    auto errors = 0u;
+    #pragma omp parallel for reduction(+:errors)
+    for (auto k = 0; k < 64; ++k) {
+        auto vr = m * v;
+        for (auto i = 0u; i < n; ++i) {
+            if (vr[i] != expected[i]) { ++errors; }
+        }
+    }
+    auto vr = m * v;
+    lalib::reset_parallel_thresholds();
+
+    EXPECT_EQ(0u, errors);
+    for (auto i = 0u; i < n; ++i) {
+        EXPECT_DOUBLE_EQ(expected[i], vr[i]);
+    }
+}
+
+TEST(MatVecOpsTests, SpSellMatDynVecMulTest) {
+    auto alpha = 2.0;
+    auto beta = 3.0;
+
+    /*
+    1.0, 2.0, 0.0,
+    0.0, 0.0, 3.0, 
+    4.0, 1.0, 2.0
+    */
+    auto m = lalib::SpSellMat<double, 2>(lalib::SpMat<double>(
+        {1.0, 2.0, 3.0, 4.0, 1.0, 2.0},
+        {0, 2, 3, 6},
+        {0, 1, 2, 0, 1, 2}
+    ));
+    auto v = lalib::DynVec<double>({2.0, 3.0, 4.0});
+
+    auto vr = lalib::DynVec<double>::filled(3, 1.0);
+    lalib::mul(alpha, m, v, beta, vr);
+
+    EXPECT_DOUBLE_EQ(alpha * 8.0 + beta, vr[0]);
+    EXPECT_DOUBLE_EQ(alpha * 12.0 + beta, vr[1]);
+    EXPECT_DOUBLE_EQ(alpha * 19.0 + beta, vr[2]);
+
+    auto vr2 = m * v;
+    EXPECT_DOUBLE_EQ(8.0, vr2[0]);
+    EXPECT_DOUBLE_EQ(12.0, vr2[1]);
+    EXPECT_DOUBLE_EQ(19.0, vr2[2]);
+}
+
+TEST(MatVecOpsTests, SpSellMatNonFiniteTest) {
+    // The padding must not contribute `0 * x[j]`, which is NaN for an infinite `x[j]`
+    auto inf = std::numeric_limits<double>::infinity();
+    auto nan = std::numeric_limits<double>::quiet_NaN();
+
+    /*
+    0.0, 0.0, 0.0,
+    1.0, 2.0, 0.0,
+    0.0, 0.0, 3.0,
+    4.0, 1.0, 2.0
+    */
+    auto csr = lalib::SpMat<double>(
+        {1.0, 2.0, 3.0, 4.0, 1.0, 2.0},
+        {0, 0, 2, 3, 6},
+        {0, 1, 2, 0, 1, 2}
+    );
+    for (auto sigma: { size_t(1), size_t(16) }) {
+        auto sell = lalib::SpSellMat<double, 2>(csr, sigma);
+        for (auto x0: { inf, nan }) {
+            auto v = lalib::DynVec<double>({x0, 3.0, 4.0});
+            auto expected = csr * v;
+            auto vr = sell * v;
+
+            // The empty row and the row without the column 0 stay finite
+            EXPECT_DOUBLE_EQ(0.0, vr[0]);
+            EXPECT_DOUBLE_EQ(12.0, vr[2]);
+            for (auto i = 0u; i < 4; ++i) {
+                if (std::isnan(expected[i])) {
+                    EXPECT_TRUE(std::isnan(vr[i]));
+                } else {
+                    EXPECT_EQ(expected[i], vr[i]);
+                }
+            }
+        }
+    }
+}
+
+TEST(MatVecOpsTests, SpBsrMatDynVecMulTest) {
+    auto alpha = 2.0;
+    auto beta = 3.0;
+
+    /*
+    1.0, 2.0, 0.0, 0.0,
+    0.0, 0.0, 3.0, 1.0,
+    4.0, 1.0, 2.0, 0.0,
+    0.0, 0.0, 0.0, 5.0
+    */
+    auto m = lalib::SpBsrMat<double, 2>(lalib::SpMat<double>(
+        {1.0, 2.0, 3.0, 1.0, 4.0, 1.0, 2.0, 5.0},
+        {0, 2, 4, 7, 8},
+        {0, 1, 2, 3, 0, 1, 2, 3}
+    ));
+    auto v = lalib::DynVec<double>({2.0, 3.0, 4.0, 1.0});
+
+    auto vr = lalib::DynVec<double>::filled(4, 1.0);
+    lalib::mul(alpha, m, v, beta, vr);
+
+    EXPECT_DOUBLE_EQ(alpha * 8.0 + beta, vr[0]);
+    EXPECT_DOUBLE_EQ(alpha * 13.0 + beta, vr[1]);
+    EXPECT_DOUBLE_EQ(alpha * 19.0 + beta, vr[2]);
+    EXPECT_DOUBLE_EQ(alpha * 5.0 + beta, vr[3]);
+
+    auto vr2 = m * v;
+    EXPECT_DOUBLE_EQ(8.0, vr2[0]);
+    EXPECT_DOUBLE_EQ(13.0, vr2[1]);
+    EXPECT_DOUBLE_EQ(19.0, vr2[2]);
+    EXPECT_DOUBLE_EQ(5.0, vr2[3]);
+}
+
+TEST(MatVecOpsTests, ComplexBsrMulCoreTest) {
+    // OpenMP reductions do not support complex numbers, so the block kernel must not use them for complex elements
+    using C = std::complex<double>;
+    /*
+    (1+i)  2     | 0      0
+    0      3-i   | 1      0
+    -------------+-------------
+    0      0     | 2i     1
+    0      0     | 0      5
+    */
+    auto val = std::vector<C>({ C(1.0, 1.0), C(2.0, 0.0), C(0.0, 0.0), C(3.0, -1.0),
+                                C(0.0, 0.0), C(0.0, 0.0), C(1.0, 0.0), C(0.0, 0.0),
+                                C(0.0, 2.0), C(1.0, 0.0), C(0.0, 0.0), C(5.0, 0.0) });
+    auto row_ptr = std::vector<size_t>({ 0, 2, 3 });
+    auto col_ids = std::vector<size_t>({ 0, 1, 1 });
+    auto x = std::vector<C>({ C(2.0, 0.0), C(0.0, 3.0), C(4.0, -1.0), C(1.0, 1.0) });
+    auto y = std::vector<C>(4, C(1.0, 0.0));
+
+    lalib::_sp_bsr_mul_core<2>(2, col_ids.data(), row_ptr.data(), C(1.0, 0.0), val.data(), x.data(), C(0.0, 0.0), y.data(), false);
+
+    auto expected = std::vector<C>({
+        C(1.0, 1.0) * x[0] + C(2.0, 0.0) * x[1],
+        C(3.0, -1.0) * x[1] + x[2],
+        C(0.0, 2.0) * x[2] + x[3],
+        C(5.0, 0.0) * x[3]
+    });
+    for (auto i = 0u; i < 4; ++i) {
+        EXPECT_DOUBLE_EQ(expected[i].real(), y[i].real());
+        EXPECT_DOUBLE_EQ(expected[i].imag(), y[i].imag());
+    }
+}
+
+TEST(MatVecOpsTests, ZeroBetaOverwritesTest) {
+    // `y` is overwritten if `beta` is zero, so NaN in `y` must not leak into the result
+    auto nan = std::numeric_limits<double>::quiet_NaN();
+    auto csr = lalib::SpMat<double>(
+        {1.0, 2.0, 3.0, 1.0, 4.0, 1.0, 2.0, 5.0},
+        {0, 2, 4, 7, 8},
+        {0, 1, 2, 3, 0, 1, 2, 3}
+    );
+    auto dense = lalib::DynMat<double>(4, 4, {
+        1.0, 2.0, 0.0, 0.0,
+        0.0, 0.0, 3.0, 1.0,
+        4.0, 1.0, 2.0, 0.0,
+        0.0, 0.0, 0.0, 5.0
+    });
+    auto v = lalib::DynVec<double>({2.0, 3.0, 4.0, 1.0});
+    auto expected = lalib::DynVec<double>({8.0, 13.0, 19.0, 5.0});
+
+    auto check = [&](const lalib::DynVec<double>& vr) {
+        for (auto i = 0u; i < 4; ++i) {
+            EXPECT_DOUBLE_EQ(expected[i], vr[i]);
+        }
+    };
+
+    auto vr = lalib::DynVec<double>::filled(4, nan);
+    check(lalib::mul(1.0, csr, v, 0.0, vr));
+    vr = lalib::DynVec<double>::filled(4, nan);
+    check(lalib::mul(1.0, lalib::SpSellMat<double, 2>(csr), v, 0.0, vr));
+    vr = lalib::DynVec<double>::filled(4, nan);
+    check(lalib::mul(1.0, lalib::SpBsrMat<double, 2>(csr), v, 0.0, vr));
+    for (auto summation: { lalib::Summation::Compensated, lalib::Summation::Pairwise }) {
+        vr = lalib::DynVec<double>::filled(4, nan);
+        check(lalib::mul(1.0, csr, v, 0.0, vr, summation));
+        vr = lalib::DynVec<double>::filled(4, nan);
+        check(lalib::mul(1.0, dense, v, 0.0, vr, summation));
+    }
+}
+
+TEST(MatVecOpsTests, SpMatU32DynVecMulTest) {
+    auto alpha = 2.0;
+    auto beta = 3.0;
+
+    /*
+    1.0, 0.0, 2.0,
+    0.0, 3.0, 0.0,
+    4.0, 0.0, 5.0
+    */
+    auto m = lalib::SpMat<double, uint32_t>({1.0, 2.0, 3.0, 4.0, 5.0}, {0, 2, 3, 5}, {0, 2, 1, 0, 2});
+    auto v = lalib::DynVec<double>({1.0, 2.0, 3.0});
+
+    auto vr = lalib::DynVec<double>::filled(3, 1.0);
+    lalib::mul(alpha, m, v, beta, vr);
+    EXPECT_DOUBLE_EQ(alpha * 7.0 + beta, vr[0]);
+    EXPECT_DOUBLE_EQ(alpha * 6.0 + beta, vr[1]);
+    EXPECT_DOUBLE_EQ(alpha * 19.0 + beta, vr[2]);
+
+    auto vr2 = m * v;
+    EXPECT_DOUBLE_EQ(7.0, vr2[0]);
+    EXPECT_DOUBLE_EQ(6.0, vr2[1]);
+    EXPECT_DOUBLE_EQ(19.0, vr2[2]);
+
+    auto sell = lalib::SpSellMat<double, 4, uint32_t>(m);
+    auto vr3 = sell * v;
+    EXPECT_DOUBLE_EQ(7.0, vr3[0]);
+    EXPECT_DOUBLE_EQ(6.0, vr3[1]);
+    EXPECT_DOUBLE_EQ(19.0, vr3[2]);
+}
+
+
+TEST(MatVecOpsTests, AccurateSummationMulTest) {
+    // Rounding `1e8f + 1` loses the one, so only the accurate summations get the exact rows
+    auto dm = lalib::DynMat<float>(2, 6, {
+        1e8f, 1.0f, -1e8f, 1.0f, 1.0f, 1.0f,
+        1.0f, 1e8f, 1.0f, 1.0f, -1e8f, 1.0f
+    });
+    auto sm = lalib::SpMat<float>(
+        {1e8f, 1.0f, -1e8f, 1.0f, 1.0f, 1.0f, 1.0f, 1e8f, 1.0f, 1.0f, -1e8f, 1.0f},
+        {0, 6, 12},
+        {0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5}
+    );
+    auto v = lalib::DynVec<float>::filled(6, 1.0f);
+
+    for (auto summation: { lalib::Summation::Compensated, lalib::Summation::Pairwise }) {
+        auto vr1 = lalib::DynVec<float>::filled(2, 1.0f);
+        lalib::mul(2.0f, dm, v, 3.0f, vr1, summation);
+        EXPECT_FLOAT_EQ(2.0f * 4.0f + 3.0f, vr1[0]);
+        EXPECT_FLOAT_EQ(2.0f * 4.0f + 3.0f, vr1[1]);
+
+        auto vr2 = lalib::DynVec<float>::filled(2, 1.0f);
+        lalib::mul(2.0f, sm, v, 3.0f, vr2, summation);
+        EXPECT_FLOAT_EQ(2.0f * 4.0f + 3.0f, vr2[0]);
+        EXPECT_FLOAT_EQ(2.0f * 4.0f + 3.0f, vr2[1]);
+    }
+
+    // The multiplier may be the result
+    auto sq = lalib::DynMat<double>(2, 2, { 1.0, 2.0, 3.0, 4.0 });
+    auto x = lalib::DynVec<double>({ 1.0, 1.0 });
+    lalib::mul(1.0, sq, x, 0.0, x, lalib::Summation::Compensated);
+    EXPECT_DOUBLE_EQ(3.0, x[0]);
+    EXPECT_DOUBLE_EQ(7.0, x[1]);
+}
+
+auto dense_test_mat(size_t n, size_t m) -> lalib::DynMat<double> {
+    auto mat = lalib::DynMat<double>::uninit(n, m);
+    for (auto i = 0u; i < n; ++i) {
+        for (auto j = 0u; j < m; ++j) {
+            mat(i, j) = std::sin(0.37 * i + 0.11 * j + 1.0);
+        }
+    }
+    return mat;
+}
+
+auto dense_test_vec(size_t n) -> lalib::DynVec<double> {
+    auto v = lalib::DynVec<double>::uninit(n);
+    for (auto i = 0u; i < n; ++i) {
+        v[i] = std::cos(0.23 * i);
+    }
+    return v;
+}
+
+TEST(MatVecOpsTests, DynMatDynVecBlockedMulTest) {
+    // Sizes across the four-row groups and the column blocks, in serial and in parallel
+    for (auto threshold: { lalib::NeverParallel, size_t(1) }) {
+        lalib::set_parallel_threshold(lalib::Kernel::MatVec, threshold);
+        for (auto [n, m]: { std::pair<size_t, size_t>{ 7, 5 }, { 131, 2050 }, { 3, 5000 }, { 1000, 30 } }) {
+            auto mat = dense_test_mat(n, m);
+            auto v = dense_test_vec(m);
+            auto vr = lalib::DynVec<double>::filled(n, 1.0);
+            lalib::mul(2.0, mat, v, 3.0, vr);
+            for (auto i = 0u; i < n; ++i) {
+                auto sum = 0.0;
+                for (auto k = 0u; k < m; ++k) { sum += mat(i, k) * v[k]; }
+                ASSERT_NEAR(2.0 * sum + 3.0, vr[i], 1e-12 * m);
+            }
+
+            // `beta = 0` overwrites the result even if it holds NaN
+            auto nan = lalib::DynVec<double>::filled(n, std::nan(""));
+            lalib::mul(1.0, mat, v, 0.0, nan);
+            for (auto i = 0u; i < n; ++i) {
+                ASSERT_NEAR((vr[i] - 3.0) / 2.0, nan[i], 1e-12 * m);
+            }
+        }
+    }
+
+    // The multiplier may be the result
+    auto sq = dense_test_mat(300, 300);
+    auto x = dense_test_vec(300);
+    auto expected = sq * x;
+    lalib::mul(1.0, sq, x, 0.0, x);
+    for (auto i = 0u; i < 300; ++i) {
+        EXPECT_DOUBLE_EQ(expected[i], x[i]);
+    }
+    lalib::reset_parallel_thresholds();
+}
+
+TEST(MatVecOpsTests, MulTransTest) {
+    auto m = lalib::SizedMat<double, 2, 3>({
+        1.0, 2.0, 3.0,
+        4.0, 5.0, 6.0
+    });
+    auto v = lalib::SizedVec<double, 2>({ 1.0, 2.0 });
+    auto vr = lalib::SizedVec<double, 3>::filled(1.0);
+    lalib::mul_trans(2.0, m, v, 3.0, vr);
+    EXPECT_DOUBLE_EQ(2.0 * 9.0 + 3.0, vr[0]);
+    EXPECT_DOUBLE_EQ(2.0 * 12.0 + 3.0, vr[1]);
+    EXPECT_DOUBLE_EQ(2.0 * 15.0 + 3.0, vr[2]);
+
+    auto cm = lalib::DynMat<std::complex<double>>(2, 2, { { 1.0, 1.0 }, { 2.0, 0.0 }, { 0.0, 1.0 }, { 1.0, -1.0 } });
+    auto cv = lalib::DynVec<std::complex<double>>({ { 1.0, 0.0 }, { 0.0, 1.0 } });
+    auto cr = lalib::mul_trans(cm, cv);
+    EXPECT_DOUBLE_EQ(0.0, cr[0].real());
+    EXPECT_DOUBLE_EQ(1.0, cr[0].imag());
+    EXPECT_DOUBLE_EQ(3.0, cr[1].real());
+    EXPECT_DOUBLE_EQ(1.0, cr[1].imag());
+}
+
+TEST(MatVecOpsTests, BlockedMulTransTest) {
+    // Tall matrices split the rows over the threads, and wide ones split the columns
+    for (auto threshold: { lalib::NeverParallel, size_t(1) }) {
+        lalib::set_parallel_threshold(lalib::Kernel::MatVec, threshold);
+        for (auto [n, m]: { std::pair<size_t, size_t>{ 7, 5 }, { 5003, 13 }, { 9, 10000 }, { 130, 2049 } }) {
+            auto mat = dense_test_mat(n, m);
+            auto v = dense_test_vec(n);
+            auto vr = lalib::DynVec<double>::filled(m, 1.0);
+            lalib::mul_trans(2.0, mat, v, 3.0, vr);
+            for (auto j = 0u; j < m; ++j) {
+                auto sum = 0.0;
+                for (auto i = 0u; i < n; ++i) { sum += mat(i, j) * v[i]; }
+                ASSERT_NEAR(2.0 * sum + 3.0, vr[j], 1e-12 * n);
+            }
+        }
+    }
+
+    // The multiplier may be the result
+    auto sq = dense_test_mat(300, 300);
+    auto x = dense_test_vec(300);
+    auto expected = lalib::mul_trans(sq, x);
+    lalib::mul_trans(1.0, sq, x, 0.0, x);
+    for (auto i = 0u; i < 300; ++i) {
+        EXPECT_DOUBLE_EQ(expected[i], x[i]);
+    }
+    lalib::reset_parallel_thresholds();
 }
\ No newline at end of file
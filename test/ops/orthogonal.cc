@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <complex>
 #include <random>
 #include "lalib/ops/orthogonal.hpp"
 #include "lalib/vec.hpp"
@@ -31,4 +32,26 @@ TEST(OrthogonalizationTests, CGSRandomTest) {
     ASSERT_NEAR(0.0, vecs[0].dot(vecs[1]), 1e-10);
     ASSERT_NEAR(0.0, vecs[0].dot(vecs[2]), 1e-10);
     ASSERT_NEAR(0.0, vecs[1].dot(vecs[2]), 1e-10);
+}
+
+TEST(OrthogonalizationTests, CGSComplexTest) {
+    // The projections are taken with the bilinear (unconjugated) dot product, as `lalib::dot` is
+    using C = std::complex<double>;
+    auto vecs = std::vector {
+        lalib::DynVec<C>({ C(1.0, 0.2), C(0.1, 0.0), C(0.0, -0.3), C(0.2, 0.1), C(0.0, 0.0) }),
+        lalib::DynVec<C>({ C(0.3, 0.0), C(1.0, -0.1), C(0.2, 0.2), C(0.0, 0.1), C(0.1, 0.0) }),
+        lalib::DynVec<C>({ C(0.0, 0.1), C(0.2, 0.0), C(1.0, 0.3), C(-0.1, 0.0), C(0.0, 0.2) }),
+        lalib::DynVec<C>({ C(0.1, 0.0), C(0.0, 0.3), C(0.2, 0.0), C(1.0, 0.0), C(0.3, -0.1) }),
+        lalib::DynVec<C>({ C(0.0, -0.2), C(0.1, 0.1), C(0.0, 0.0), C(0.2, 0.0), C(1.0, 0.1) })
+    };
+
+    lalib::orth::cgs(vecs);
+
+    for (auto j = 1u; j < vecs.size(); ++j) {
+        for (auto k = 0u; k < j; ++k) {
+            auto d = lalib::dot(vecs[k], vecs[j]);
+            ASSERT_NEAR(0.0, d.real(), 1e-12);
+            ASSERT_NEAR(0.0, d.imag(), 1e-12);
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+#ifndef LALIB_TEST_OPS_TEST_VALUES_HPP
+#define LALIB_TEST_OPS_TEST_VALUES_HPP
+
+#include <random>
+#include <type_traits>
+#include <vector>
+
+/// Uniformly random values in `[-1, 1)`, in both parts for complex numbers
+template<typename T>
+auto random_values(size_t n, std::mt19937& rand) -> std::vector<T> {
+    auto dist = std::uniform_real_distribution<double>(-1.0, 1.0);
+    auto v = std::vector<T>(n);
+    for (auto& x: v) {
+        if constexpr (std::is_floating_point_v<T>) {
+            x = static_cast<T>(dist(rand));
+        } else {
+            x = T(dist(rand), dist(rand));
+        }
+    }
+    return v;
+}
+
+/// `alpha * a * b + beta * c` for row-major `n` x `l`, `l` x `m` and `n` x `m` matrices, by the naive triple loop
+template<typename T>
+auto reference_mul(size_t n, size_t m, size_t l, T alpha, const std::vector<T>& a, const std::vector<T>& b, T beta, const std::vector<T>& c) -> std::vector<T> {
+    auto r = std::vector<T>(n * m);
+    for (auto i = 0u; i < n; ++i) {
+        for (auto j = 0u; j < m; ++j) {
+            auto sum = T{};
+            for (auto k = 0u; k < l; ++k) {
+                sum += a[i * l + k] * b[k * m + j];
+            }
+            r[i * m + j] = alpha * sum + beta * c[i * m + j];
+        }
+    }
+    return r;
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "lalib/ops/vec_ops.hpp"
 #include "lalib/vec/sized_vec.hpp"
 #include <gtest/gtest.h>
+#include <omp.h>
 
 // ### Negation ### //
 TEST(VecOpsTests, SizedVecNegOpsDoubleTest) {
@@ -305,4 +306,215 @@ TEST(VecOpsTests, SizedVecCross3AccTest) {
     ASSERT_DOUBLE_EQ(1.0, v3[0]);
     ASSERT_DOUBLE_EQ(0.0, v3[1]);
     ASSERT_DOUBLE_EQ(2.0, v3[2]);
+}
+
+// ### Multi-vector ### //
+TEST(VecOpsTests, DynVecMdotTest) {
+    auto x = lalib::DynVec<double>({1.0, 2.0, 3.0, 2.0, 4.0});
+    auto ys = std::vector<lalib::DynVec<double>>();
+    for (auto j = 0u; j < 6; ++j) {
+        ys.emplace_back(lalib::DynVec<double>({1.0 * j, 1.0, -1.0, 0.5 * j, 2.0}));
+    }
+
+    auto r = lalib::mdot(x, ys);
+
+    ASSERT_EQ(6, r.size());
+    for (auto j = 0u; j < 6; ++j) {
+        ASSERT_DOUBLE_EQ(lalib::dot(x, ys[j]), r[j]);
+    }
+}
+
+TEST(VecOpsTests, DynVecLargeMdotTest) {
+    auto n = 100003u;
+    auto x = lalib::DynVec<double>::uninit(n);
+    auto ys = std::vector<lalib::DynVec<double>>(7, lalib::DynVec<double>::uninit(n));
+    for (auto i = 0u; i < n; ++i) {
+        x[i] = std::sin(0.1 * i);
+        for (auto j = 0u; j < 7; ++j) {
+            ys[j][i] = std::cos(0.01 * i * (j + 1));
+        }
+    }
+
+    auto r = std::vector<double>(7);
+    lalib::mdot(x, ys, r);
+
+    for (auto j = 0u; j < 7; ++j) {
+        ASSERT_NEAR(lalib::dot(x, ys[j]), r[j], 1e-9);
+    }
+}
+
+TEST(VecOpsTests, DynVecMaxpyTest) {
+    auto xs = std::vector<lalib::DynVec<double>>();
+    for (auto j = 0u; j < 5; ++j) {
+        xs.emplace_back(lalib::DynVec<double>({1.0, 1.0 * j, -1.0, 2.0}));
+    }
+    auto alphas = std::vector<double>({1.0, 2.0, 3.0, 4.0, 5.0});
+    auto y = lalib::DynVec<double>({1.0, 1.0, 1.0, 1.0});
+
+    lalib::maxpy(alphas, xs, y);
+
+    ASSERT_DOUBLE_EQ(16.0, y[0]);
+    ASSERT_DOUBLE_EQ(41.0, y[1]);
+    ASSERT_DOUBLE_EQ(-14.0, y[2]);
+    ASSERT_DOUBLE_EQ(31.0, y[3]);
+}
+
+TEST(VecOpsTests, DynVecLargeMaxpyTest) {
+    auto n = 100003u;
+    auto xs = std::vector<lalib::DynVec<double>>(6, lalib::DynVec<double>::uninit(n));
+    auto alphas = std::vector<double>({0.5, -1.0, 2.0, 0.25, 3.0, -0.5});
+    auto y = lalib::DynVec<double>::filled(n, 1.0);
+    auto expected = lalib::DynVec<double>::filled(n, 1.0);
+    for (auto j = 0u; j < 6; ++j) {
+        for (auto i = 0u; i < n; ++i) {
+            xs[j][i] = std::sin(0.01 * i * (j + 1));
+        }
+        lalib::axpy(alphas[j], xs[j], expected);
+    }
+
+    lalib::maxpy(alphas, xs, y);
+
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(expected[i], y[i], 1e-12);
+    }
+}
+
+TEST(VecOpsTests, DynVecComplexMdotTest) {
+    using C = std::complex<double>;
+    for (auto n: { 5u, 100003u }) {
+        auto x = lalib::DynVec<C>::uninit(n);
+        auto ys = std::vector<lalib::DynVec<C>>(6, lalib::DynVec<C>::uninit(n));
+        for (auto i = 0u; i < n; ++i) {
+            x[i] = C(std::sin(0.1 * i), std::cos(0.3 * i));
+            for (auto j = 0u; j < 6; ++j) {
+                ys[j][i] = C(std::cos(0.01 * i * (j + 1)), 0.5 * j);
+            }
+        }
+
+        auto r = lalib::mdot(x, ys);
+
+        ASSERT_EQ(6, r.size());
+        for (auto j = 0u; j < 6; ++j) {
+            auto expected = lalib::dot(x, ys[j]);
+            ASSERT_NEAR(expected.real(), r[j].real(), 1e-9);
+            ASSERT_NEAR(expected.imag(), r[j].imag(), 1e-9);
+        }
+    }
+}
+
+TEST(VecOpsTests, DynVecComplexMaxpyTest) {
+    using C = std::complex<double>;
+    for (auto n: { 4u, 100003u }) {
+        auto xs = std::vector<lalib::DynVec<C>>(5, lalib::DynVec<C>::uninit(n));
+        auto alphas = std::vector<C>({C(1.0, 0.5), C(2.0, -1.0), C(0.0, 3.0), C(4.0, 0.0), C(-0.5, 0.25)});
+        auto y = lalib::DynVec<C>::filled(n, C(1.0, -1.0));
+        auto expected = lalib::DynVec<C>::filled(n, C(1.0, -1.0));
+        for (auto j = 0u; j < 5; ++j) {
+            for (auto i = 0u; i < n; ++i) {
+                xs[j][i] = C(std::sin(0.01 * i * (j + 1)), 1.0 * j);
+            }
+            lalib::axpy(alphas[j], xs[j], expected);
+        }
+
+        lalib::maxpy(alphas, xs, y);
+
+        for (auto i = 0u; i < n; ++i) {
+            ASSERT_NEAR(expected[i].real(), y[i].real(), 1e-12);
+            ASSERT_NEAR(expected[i].imag(), y[i].imag(), 1e-12);
+        }
+    }
+}
+
+// ### Reproducible reductions ### //
+TEST(VecOpsTests, DynVecReproducibleDotTest) {
+    auto n = 1000003u;
+    auto x = lalib::DynVec<double>::uninit(n);
+    auto y = lalib::DynVec<double>::uninit(n);
+    for (auto i = 0u; i < n; ++i) {
+        x[i] = std::sin(0.1 * i) * std::pow(10.0, i % 13);
+        y[i] = std::cos(0.01 * i);
+    }
+
+    // The results must be bitwise identical for any number of threads
+    auto max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    auto d = lalib::dot(x, y, lalib::Summation::Reproducible);
+    auto norm = lalib::norm2(x, lalib::Summation::Reproducible);
+    for (auto threads: { 2, 3, 7 }) {
+        omp_set_num_threads(threads);
+        ASSERT_EQ(d, lalib::dot(x, y, lalib::Summation::Reproducible));
+        ASSERT_EQ(norm, lalib::norm2(x, lalib::Summation::Reproducible));
+    }
+    omp_set_num_threads(max_threads);
+
+    // The orders differ, so the results agree only up to rounding errors
+    ASSERT_NEAR(lalib::dot(x, y), d, 1e-14 * x.norm2() * y.norm2());
+    ASSERT_NEAR(x.norm2(), norm, 1e-12 * x.norm2());
+}
+
+TEST(VecOpsTests, DynVecReproducibleComplexDotTest) {
+    using C = std::complex<double>;
+    auto n = 100003u;
+    auto x = lalib::DynVec<C>::uninit(n);
+    auto y = lalib::DynVec<C>::uninit(n);
+    for (auto i = 0u; i < n; ++i) {
+        x[i] = C(std::sin(0.1 * i), std::cos(0.3 * i));
+        y[i] = C(std::cos(0.01 * i), -0.5);
+    }
+
+    auto max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    auto d = lalib::dot(x, y, lalib::Summation::Reproducible);
+    auto norm = lalib::norm2(x, lalib::Summation::Reproducible);
+    omp_set_num_threads(4);
+    ASSERT_EQ(d, lalib::dot(x, y, lalib::Summation::Reproducible));
+    ASSERT_EQ(norm, lalib::norm2(x, lalib::Summation::Reproducible));
+    omp_set_num_threads(max_threads);
+
+    auto expected = lalib::dot(x, y);
+    ASSERT_NEAR(expected.real(), d.real(), 1e-9);
+    ASSERT_NEAR(expected.imag(), d.imag(), 1e-9);
+    ASSERT_NEAR(x.norm2().real(), norm.real(), 1e-9);
+}
+
+// ### Accurate reductions ### //
+TEST(VecOpsTests, DynVecAccurateFloatDotTest) {
+    auto n = 1u << 20;
+    auto x = lalib::DynVec<float>::uninit(n);
+    auto y = lalib::DynVec<float>::uninit(n);
+    auto expected = 0.0;
+    auto expected_sq = 0.0;
+    for (auto i = 0u; i < n; ++i) {
+        x[i] = 0.1f * static_cast<float>(1 + i % 17);
+        y[i] = 1.0f + 1e-3f * static_cast<float>(i % 5);
+        // The products of floats are exact in double
+        expected += static_cast<double>(x[i]) * static_cast<double>(y[i]);
+        expected_sq += static_cast<double>(x[i]) * static_cast<double>(x[i]);
+    }
+
+    for (auto summation: { lalib::Summation::Compensated, lalib::Summation::Pairwise }) {
+        EXPECT_FLOAT_EQ(static_cast<float>(expected), lalib::dot(x, y, summation));
+        EXPECT_FLOAT_EQ(static_cast<float>(std::sqrt(expected_sq)), lalib::norm2(x, summation));
+    }
+}
+
+TEST(VecOpsTests, DynVecCompensatedDotTest) {
+    // The ones are lost by the naive summation against the large terms
+    auto n = 30000u;
+    auto x = lalib::DynVec<double>::uninit(n);
+    auto y = lalib::DynVec<double>::filled(n, 1.0);
+    for (auto i = 0u; i < n; ++i) {
+        x[i] = i % 3 == 0 ? 1e16 : i % 3 == 1 ? 1.0 : -1e16;
+    }
+    ASSERT_EQ(n / 3.0, lalib::dot(x, y, lalib::Summation::Compensated));
+
+    using C = std::complex<double>;
+    auto cx = lalib::DynVec<C>::uninit(n);
+    auto cy = lalib::DynVec<C>::filled(n, C(1.0, 1.0));
+    for (auto i = 0u; i < n; ++i) {
+        cx[i] = C(x[i], 0.0);
+    }
+    auto d = lalib::dot(cx, cy, lalib::Summation::Compensated);
+    ASSERT_EQ(n / 3.0, d.real());
+    ASSERT_EQ(n / 3.0, d.imag());
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "lalib/solver/bicgstab.hpp"
+#include "lalib/ops/mat_vec_ops.hpp"
+#include <gtest/gtest.h>
+#include "test_problems.hpp"
+
+TEST(BicgstabTests, BicgstabTest) {
+    auto mat = lalib::DynMat<double>(3, 3, {
+        4.0, 1.0, 2.0,
+        0.5, 5.0, 1.0,
+        3.0, 1.0, 6.0
+    });
+    auto b = mat * lalib::DynVec<double>({ 1.0, -2.0, 3.0 });
+    auto bicgstab = lalib::solver::Bicgstab(mat, 1e-12);
+    auto sol = bicgstab.solve(b);
+
+    ASSERT_NEAR(1.0, sol[0], 1e-10);
+    ASSERT_NEAR(-2.0, sol[1], 1e-10);
+    ASSERT_NEAR(3.0, sol[2], 1e-10);
+}
+
+TEST(BicgstabTests, SpBicgstabTest) {
+    auto mat = convection_diffusion_2d(40, 0.5);
+    auto n = mat.shape().first;
+    auto b = mat * lalib::DynVec<double>::filled(n, 1.0);
+
+    auto bicgstab = lalib::solver::Bicgstab(mat, 1e-10);
+    auto sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto status = bicgstab.solve(b, sol);
+
+    ASSERT_TRUE(status.converged);
+    ASSERT_LT(status.residual, 1e-10);
+    ASSERT_LT((b - mat * sol).norm2(), 1e-9);
+    // The reported residual is the true one, not the recurrence
+    EXPECT_NEAR((b - mat * sol).norm2(), status.residual, 1e-6 * status.residual);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(1.0, sol[i], 1e-8);
+    }
+}
+
+TEST(BicgstabTests, MatrixFreeBicgstabTest) {
+    auto n = size_t(100);
+    auto op = matrix_free_convection_diffusion(n);
+    auto x = lalib::DynVec<double>::filled(n, 1.0);
+    auto b = lalib::DynVec<double>::uninit(n);
+    op.apply(x, b);
+
+    auto bicgstab = lalib::solver::Bicgstab(op, lalib::solver::IdentityPreconditioner<double>(), 1e-10);
+    auto ws = lalib::solver::BicgstabWorkspace<double>();
+    auto sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto status = bicgstab.solve(b, sol, ws);
+
+    ASSERT_TRUE(status.converged);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(1.0, sol[i], 1e-8);
+    }
+}
+
+TEST(BicgstabTests, BicgstabMaxIterTest) {
+    auto mat = convection_diffusion_2d(40, 0.5);
+    auto n = mat.shape().first;
+    auto b = mat * lalib::DynVec<double>::filled(n, 1.0);
+
+    auto bicgstab = lalib::solver::Bicgstab(mat, lalib::solver::IdentityPreconditioner<double>(), 1e-14, 3);
+    auto sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto status = bicgstab.solve(b, sol);
+
+    ASSERT_FALSE(status.converged);
+    ASSERT_EQ(status.iterations, 3);
+    ASSERT_GT(status.residual, 1e-14);
+    EXPECT_NEAR((b - mat * sol).norm2(), status.residual, 1e-6 * status.residual);
+}
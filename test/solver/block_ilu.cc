@@ -0,0 +1,80 @@
+#include "lalib/solver/block_ilu.hpp"
+#include "lalib/solver/ilu.hpp"
+#include "lalib/mat.hpp"
+#include <gtest/gtest.h>
+
+TEST(BlockILUTests, FullBlockDecompositionTest) {
+    // A single block reduces to the exact inverse
+    auto mat = lalib::SpBsrMat<double, 3>(lalib::SpMat<double>(
+        { 2, -1, -2, -4, 6, 3, -4, -2, 8 },
+        { 0, 3, 6, 9 },
+        { 0, 1, 2, 0, 1, 2, 0, 1, 2 }
+    ));
+    auto ilu = lalib::solver::BlockIlu<double, 3>(std::move(mat));
+
+    auto rhs = lalib::DynVec<double>({-1, 5, 2});
+    auto x = ilu.solve(rhs);
+
+    ASSERT_NEAR(x[0], 1.0, 1e-12);
+    ASSERT_NEAR(x[1], 1.0, 1e-12);
+    ASSERT_NEAR(x[2], 1.0, 1e-12);
+}
+
+TEST(BlockILUTests, ScalarBlockDecompositionTest) {
+    // With 1 x 1 blocks, the factorization must coincide with the scalar ILU(0)
+    auto val = std::vector<double>{ 4, -1, -1, -1, 4, -1, -1, 4, -1, -1, 4, -1, -1, -1, 4 };
+    auto row_ptr = std::vector<size_t>{ 0, 3, 6, 9, 12, 15 };
+    auto col_ids = std::vector<size_t>{ 0, 1, 3, 0, 1, 2, 1, 2, 4, 0, 3, 4, 2, 3, 4 };
+
+    auto block_ilu = lalib::solver::BlockIlu<double, 1>(lalib::SpBsrMat<double, 1>(lalib::SpMat<double>(val, row_ptr, col_ids)));
+    auto ilu = lalib::solver::Ilu<double, lalib::DynMat<double>>(lalib::DynMat<double>(5, 5, {
+        4, -1,  0, -1,  0,
+       -1,  4, -1,  0,  0,
+        0, -1,  4,  0, -1,
+       -1,  0,  0,  4, -1,
+        0,  0, -1, -1,  4,
+    }));
+
+    auto rhs = lalib::DynVec<double>({ 1.0, 2.0, 3.0, 4.0, 5.0 });
+    auto x1 = block_ilu.solve(rhs);
+    auto x2 = ilu.solve(rhs);
+    for (auto i = 0u; i < 5; ++i) {
+        ASSERT_NEAR(x1[i], x2[i], 1e-12);
+    }
+}
+
+TEST(BlockILUTests, BlockTriDiagDecompositionTest) {
+    // Block tri-diagonal matrix has no fill-in, so that block ILU(0) is the exact block LU factorization.
+    auto n = 8u;
+    auto b = 2u;
+    auto val = std::vector<double>();
+    auto row_ptr = std::vector<size_t>{ 0 };
+    auto col_ids = std::vector<size_t>();
+    for (auto i = 0u; i < n; ++i) {
+        auto bi = i / b;
+        for (auto j = (bi == 0 ? 0 : (bi - 1) * b); j < std::min(n, (bi + 2) * b); ++j) {
+            val.emplace_back(i == j ? 6.0 : (j / b == bi ? 1.0 : -1.0 + 0.1 * (i % b)));
+            col_ids.emplace_back(j);
+        }
+        row_ptr.emplace_back(col_ids.size());
+    }
+    auto csr = lalib::SpMat<double>(val, row_ptr, col_ids);
+    auto x = lalib::DynVec<double>({ 1.0, -2.0, 3.0, -4.0, 5.0, -6.0, 7.0, -8.0 });
+    auto rhs = csr * x;
+
+    auto ilu = lalib::solver::BlockIlu<double, 2>(lalib::SpBsrMat<double, 2>(csr));
+    auto sol = ilu.solve(rhs);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(x[i], sol[i], 1e-12);
+    }
+}
+
+TEST(BlockILUTests, SingularBlockTest) {
+    auto mat = lalib::SpBsrMat<double, 2>(lalib::SpMat<double>(
+        { 1, 2, 2, 4 },
+        { 0, 2, 4 },
+        { 0, 1, 0, 1 }
+    ));
+    using BlockIluD2 = lalib::solver::BlockIlu<double, 2>;
+    EXPECT_THROW({ auto ilu = BlockIluD2(std::move(mat)); }, std::runtime_error);
+}
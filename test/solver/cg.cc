@@ -0,0 +1,89 @@
+#include "lalib/solver/cg.hpp"
+#include "lalib/solver/ilu.hpp"
+#include "lalib/ops/mat_vec_ops.hpp"
+#include <gtest/gtest.h>
+#include "test_problems.hpp"
+
+TEST(CgTests, CgTest) {
+    auto mat = lalib::DynMat<double>(3, 3, {
+        4.0, 2.0, 6.0,
+        2.0, 5.0, 5.0,
+        6.0, 5.0, 14.0
+    });
+    auto b = lalib::DynVec<double>({2.0, 5.0, 1.0});
+    auto cg = lalib::solver::Cg(mat, 1e-12);
+    auto sol = cg.solve(b);
+
+    ASSERT_NEAR(1.25, sol[0], 1e-10);
+    ASSERT_NEAR(1.5, sol[1], 1e-10);
+    ASSERT_NEAR(-1.0, sol[2], 1e-10);
+}
+
+TEST(CgTests, SpCgTest) {
+    auto mat = laplacian_2d(30);
+    auto n = mat.shape().first;
+    auto b = mat * lalib::DynVec<double>::filled(n, 1.0);
+
+    auto cg = lalib::solver::Cg(mat, 1e-10);
+    auto sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto status = cg.solve(b, sol);
+
+    ASSERT_TRUE(status.converged);
+    ASSERT_LT(status.residual, 1e-10);
+    ASSERT_LT((b - mat * sol).norm2(), 1e-9);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(1.0, sol[i], 1e-8);
+    }
+
+    // The ILU(0) factorization of a symmetric matrix is a symmetric preconditioner as well.
+    using Ilu = lalib::solver::Ilu<double, lalib::SpMat<double>>;
+    auto ilu_cg = lalib::solver::Cg(mat, Ilu(lalib::SpMat<double>(mat)), 1e-10);
+    auto ilu_sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto ilu_status = ilu_cg.solve(b, ilu_sol);
+
+    ASSERT_TRUE(ilu_status.converged);
+    ASSERT_LT(ilu_status.iterations, status.iterations);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(1.0, ilu_sol[i], 1e-8);
+    }
+}
+
+TEST(CgTests, MatrixFreeCgTest) {
+    // 1D Laplacian applied without a matrix
+    auto n = size_t(50);
+    auto op = lalib::solver::matrix_free<double>(n, [](const lalib::DynVec<double>& x, lalib::DynVec<double>& y) {
+        auto n = x.size();
+        for (auto i = 0u; i < n; ++i) {
+            y[i] = 2.0 * x[i] - (i > 0 ? x[i - 1] : 0.0) - (i + 1 < n ? x[i + 1] : 0.0);
+        }
+    });
+    auto b = lalib::DynVec<double>::filled(n, 0.0);
+    b[0] = 1.0;
+    b[n - 1] = 1.0;
+
+    auto cg = lalib::solver::Cg(op, lalib::solver::IdentityPreconditioner<double>(), 1e-10);
+    auto ws = lalib::solver::CgWorkspace<double>();
+    auto sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto status = cg.solve(b, sol, ws);
+
+    // CG converges within n / 2 iterations on this symmetric problem
+    ASSERT_TRUE(status.converged);
+    ASSERT_LE(status.iterations, n / 2);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(1.0, sol[i], 1e-8);
+    }
+}
+
+TEST(CgTests, CgMaxIterTest) {
+    auto mat = laplacian_2d(30);
+    auto n = mat.shape().first;
+    auto b = mat * lalib::DynVec<double>::filled(n, 1.0);
+
+    auto cg = lalib::solver::Cg(mat, 1e-14, 5);
+    auto sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto status = cg.solve(b, sol);
+
+    ASSERT_FALSE(status.converged);
+    ASSERT_EQ(status.iterations, 5);
+    ASSERT_GT(status.residual, 1e-14);
+}
@@ -137,6 +137,106 @@ TEST(CholeskyDecompositionTests, MultiLinearSolverTest) {
 	}
 }
 
+static auto spd_test_elem(size_t i, size_t j, size_t n) -> double {
+	auto d = i > j ? i - j : j - i;
+	return 1.0 / (1.0 + static_cast<double>(d)) + static_cast<double>((i * 7 + j * 7) % 5) * 0.01 + (i == j ? static_cast<double>(n) * 0.1 : 0.0);
+}
+
+static void expect_blocked_cholesky(size_t n) {
+	auto elems = std::vector<double>();
+	for (auto i = 0u; i < n; ++i) {
+		for (auto j = 0u; j <= i; ++j) { elems.emplace_back(spd_test_elem(i, j, n)); }
+	}
+	auto sq = lalib::DynMat<double>::uninit(n, n);
+	for (auto i = 0u; i < n; ++i) {
+		for (auto j = 0u; j < n; ++j) { sq(i, j) = spd_test_elem(i, j, n); }
+	}
+	auto expected = std::vector<double>(elems);
+	auto rslt = lalib::solver::_internal_::unblocked_cholesky_decomposition<double, lalib::solver::_internal_::MemType::Triangle>(n, expected.data());
+	ASSERT_EQ(0, rslt);
+
+	auto tri = lalib::solver::DynTriCholeskyFactorization<double>(lalib::DynHermiteMat<double>(n, std::move(elems)));
+	auto full = lalib::solver::DynCholeskyFactorization<double>(std::move(sq));
+	const auto& l = tri.lower_mat();
+	const auto& f = full.factor_mat();
+	for (auto i = 0u; i < n; ++i) {
+		for (auto j = 0u; j <= i; ++j) {
+			auto e = expected[i * (i + 1) / 2 + j];
+			EXPECT_NEAR(e, l(i, j), 1e-12) << i << ", " << j;
+			EXPECT_NEAR(e, f(i, j), 1e-12) << i << ", " << j;
+		}
+	}
+}
+
+TEST(CholeskyDecompositionTests, BlockedDecompositionTest) {
+	lalib::set_parallel_threshold(lalib::Kernel::MatMul, lalib::NeverParallel);
+	expect_blocked_cholesky(257);
+	expect_blocked_cholesky(700);
+	lalib::reset_parallel_thresholds();
+}
+
+TEST(CholeskyDecompositionTests, ParallelBlockedDecompositionTest) {
+	lalib::set_parallel_threshold(lalib::Kernel::MatMul, 1);
+	expect_blocked_cholesky(600);
+	lalib::reset_parallel_thresholds();
+}
+
+TEST(CholeskyDecompositionTests, BlockedFailureTest) {
+	constexpr auto n = 600u;
+	auto sq = lalib::DynMat<double>::uninit(n, n);
+	for (auto i = 0u; i < n; ++i) {
+		for (auto j = 0u; j < n; ++j) { sq(i, j) = spd_test_elem(i, j, n); }
+	}
+	// The leading minor of the order 521 is not positive definite, which is found in the third tile
+	sq(520, 520) = -1.0;
+	auto l = sq;
+	auto rslt = lalib::solver::_internal_::cholesky_decomposition<double, lalib::solver::_internal_::MemType::Square>(n, l.data());
+	EXPECT_EQ(521, rslt);
+	EXPECT_THROW(lalib::solver::DynCholeskyFactorization<double>(std::move(sq)), std::runtime_error);
+}
+
+TEST(CholeskyDecompositionTests, BlockedMultiLinearSolverTest) {
+	constexpr auto n = 300u, nrhs = 37u;
+	auto elems = std::vector<double>();
+	auto sq = lalib::DynMat<double>::uninit(n, n);
+	for (auto i = 0u; i < n; ++i) {
+		for (auto j = 0u; j < n; ++j) { sq(i, j) = spd_test_elem(i, j, n); }
+		for (auto j = 0u; j <= i; ++j) { elems.emplace_back(spd_test_elem(i, j, n)); }
+	}
+	auto x = lalib::DynMat<double>::uninit(n, nrhs);
+	for (auto i = 0u; i < n; ++i) {
+		for (auto k = 0u; k < nrhs; ++k) { x(i, k) = static_cast<double>((i * 3 + k * 5) % 11) - 5.0; }
+	}
+	auto b = lalib::DynMat<double>::uninit(n, nrhs);
+	for (auto i = 0u; i < n; ++i) {
+		for (auto k = 0u; k < nrhs; ++k) {
+			auto sum = 0.0;
+			for (auto j = 0u; j < n; ++j) { sum += sq(i, j) * x(j, k); }
+			b(i, k) = sum;
+		}
+	}
+
+	auto expect_solution = [&](const lalib::DynMat<double>& rslt) {
+		for (auto i = 0u; i < n; ++i) {
+			for (auto k = 0u; k < nrhs; ++k) { EXPECT_NEAR(x(i, k), rslt(i, k), 1e-9) << i << ", " << k; }
+		}
+	};
+	{
+		auto rslt = b;
+		auto cholesky = lalib::solver::DynTriCholeskyFactorization<double>(lalib::DynHermiteMat<double>(n, std::move(elems)));
+		cholesky.solve_linear_mut(rslt);
+		expect_solution(rslt);
+	}
+	{
+		auto cholesky = lalib::solver::DynCholeskyFactorization<double>(lalib::DynMat<double>(sq));
+		expect_solution(cholesky.solve_linear(b));
+	}
+	{
+		auto cholesky = lalib::solver::DynModCholeskyFactorization<double>(lalib::DynMat<double>(sq));
+		expect_solution(cholesky.solve_linear(b));
+	}
+}
+
 TEST(ModCholeskyDecompositionTests, DecompositionTest) {
     auto mat_sq = lalib::DynMat<double>(3, 3, std::vector{
 		4.0, 2.0, 6.0,
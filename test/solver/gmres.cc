@@ -2,6 +2,7 @@
 #include <cstddef>
 #include <fstream>
 #include <gtest/gtest.h>
+#include "test_problems.hpp"
 #include "assets.hpp"
 
 auto load_mxt(std::string filename) -> std::tuple<size_t, lalib::SpCooMat<double>> {
@@ -50,7 +51,7 @@ TEST(GmresTests, GmresTest) {
         6.0, 5.0, 14.0
     });
     auto b = lalib::DynVec<double>({2.0, 5.0, 1.0});
-    auto gmres = lalib::solver::Gmres<double, lalib::DynMat<double>>(std::move(mat), 1e-6);
+    auto gmres = lalib::solver::Gmres<double, lalib::DynMat<double>>(mat, 1e-6);
     auto sol = gmres.solve(b);
 
     ASSERT_NEAR(1.25, sol[0], 1e-6);
@@ -65,7 +66,7 @@ TEST(GmresTests, SpGmresTest) {
         {0, 1, 2, 0, 1, 2, 0, 1, 2}
     );
     auto b = lalib::DynVec<double>({2.0, 5.0, 1.0});
-    auto gmres = lalib::solver::Gmres(std::move(mat), 1e-6);
+    auto gmres = lalib::solver::Gmres(mat, 1e-6);
     auto sol = gmres.solve(b);
 
     ASSERT_NEAR(1.25, sol[0], 1e-6);
@@ -81,10 +82,209 @@ TEST(GmresTests, SpLargeGmresTest) {
 
     auto x = lalib::DynVec<double>::filled(mat.shape().first, 1.0);
     auto b = mat * x;
-    auto gmres = lalib::solver::Gmres(std::move(mat), 1e-6);
+    auto gmres = lalib::solver::Gmres(mat, 1e-6);
     auto sol = gmres.solve(b);
 
     for (auto i = 0u; i < sol.size(); ++i) {
         ASSERT_NEAR(1.0, sol[i], 1e-6);
     }
-}
\ No newline at end of file
+}
+
+TEST(GmresTests, SpSellLargeGmresTest) {
+    auto [n, mat_tmp] = load_mxt(ASSETS_DIR"/pores_1.mtx");
+    auto mat = lalib::SpSellMat<double, 4>(mat_tmp);
+    ASSERT_EQ(mat.shape().first, n);
+    ASSERT_EQ(mat.shape().second, n);
+
+    auto x = lalib::DynVec<double>::filled(mat.shape().first, 1.0);
+    auto b = mat * x;
+    auto gmres = lalib::solver::Gmres(mat, 1e-6);
+    auto sol = gmres.solve(b);
+
+    for (auto i = 0u; i < sol.size(); ++i) {
+        ASSERT_NEAR(1.0, sol[i], 1e-6);
+    }
+}
+
+TEST(GmresTests, SpU32LargeGmresTest) {
+    auto [n, mat_tmp] = load_mxt(ASSETS_DIR"/pores_1.mtx");
+    auto mat = lalib::SpMat<double, uint32_t>(lalib::SpMat<double>(std::move(mat_tmp)));
+    ASSERT_EQ(mat.shape().first, n);
+    ASSERT_EQ(mat.shape().second, n);
+
+    auto x = lalib::DynVec<double>::filled(mat.shape().first, 1.0);
+    auto b = mat * x;
+    auto gmres = lalib::solver::Gmres(mat, 1e-6);
+    auto sol = gmres.solve(b);
+
+    for (auto i = 0u; i < sol.size(); ++i) {
+        ASSERT_NEAR(1.0, sol[i], 1e-6);
+    }
+}
+
+TEST(GmresTests, RestartedGmresTest) {
+    auto mat = laplacian_2d(30);
+    auto n = mat.shape().first;
+    auto x = lalib::DynVec<double>::filled(n, 1.0);
+    auto b = mat * x;
+
+    auto gmres = lalib::solver::Gmres(mat, 1e-10, 5, 1000);
+    auto sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto status = gmres.solve(b, sol);
+
+    ASSERT_TRUE(status.converged);
+    ASSERT_GT(status.iterations, 5);
+    ASSERT_LT(status.residual, 1e-10);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(1.0, sol[i], 1e-8);
+    }
+}
+
+TEST(GmresTests, GmresInitialGuessTest) {
+    auto mat = laplacian_2d(10);
+    auto n = mat.shape().first;
+    auto x = lalib::DynVec<double>::filled(n, 1.0);
+    auto b = mat * x;
+
+    // The exact solution as the initial guess converges without iterations.
+    auto gmres = lalib::solver::Gmres(mat, 1e-10, 5);
+    auto sol = x;
+    auto status = gmres.solve(b, sol);
+
+    ASSERT_TRUE(status.converged);
+    ASSERT_EQ(status.iterations, 0);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_DOUBLE_EQ(1.0, sol[i]);
+    }
+}
+
+TEST(GmresTests, GmresMaxIterTest) {
+    auto mat = laplacian_2d(30);
+    auto n = mat.shape().first;
+    auto b = mat * lalib::DynVec<double>::filled(n, 1.0);
+
+    auto gmres = lalib::solver::Gmres(mat, 1e-14, 4, 6);
+    auto sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto status = gmres.solve(b, sol);
+
+    ASSERT_FALSE(status.converged);
+    ASSERT_EQ(status.iterations, 6);
+    ASSERT_GT(status.residual, 1e-14);
+}
+
+template<typename P>
+void check_preconditioned_gmres(const lalib::SpMat<double>& mat, P precond, lalib::solver::PrecondSide side) {
+    auto n = mat.shape().first;
+    auto b = mat * lalib::DynVec<double>::filled(n, 1.0);
+
+    auto gmres = lalib::solver::Gmres(mat, std::move(precond), 1e-10, 20, 2000, side);
+    auto sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto status = gmres.solve(b, sol);
+
+    ASSERT_TRUE(status.converged);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(1.0, sol[i], 1e-7);
+    }
+}
+
+TEST(GmresTests, GmresPreconditionerTest) {
+    using lalib::solver::PrecondSide;
+    auto mat = laplacian_2d(20);
+
+    for (auto side: { PrecondSide::Left, PrecondSide::Right }) {
+        check_preconditioned_gmres(mat, lalib::solver::IdentityPreconditioner<double>(), side);
+        check_preconditioned_gmres(mat, lalib::solver::JacobiPreconditioner<double>(mat), side);
+        check_preconditioned_gmres(mat, lalib::solver::Ilu<double, lalib::SpMat<double>>(lalib::SpMat<double>(mat)), side);
+    }
+}
+
+TEST(GmresTests, GmresRightPreconditionedResidualTest) {
+    auto mat = laplacian_2d(20);
+    auto n = mat.shape().first;
+    auto b = mat * lalib::DynVec<double>::filled(n, 1.0);
+
+    // The right preconditioning reports the true residual
+    auto gmres = lalib::solver::Gmres(mat, 1e-10, 20, 2000, lalib::solver::PrecondSide::Right);
+    auto sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto status = gmres.solve(b, sol);
+    auto res = (b - mat * sol).norm2();
+
+    ASSERT_TRUE(status.converged);
+    ASSERT_LT(res, 1e-9);
+    ASSERT_NEAR(res, status.residual, 1e-9);
+}
+
+TEST(GmresTests, JacobiPreconditionerTest) {
+    auto mat = lalib::DynMat<double>(3, 3, {
+        4.0, 1.0, 0.0,
+        1.0, 2.0, 1.0,
+        0.0, 1.0, 0.5
+    });
+    auto jacobi = lalib::solver::JacobiPreconditioner<double>(mat);
+    auto v = lalib::DynVec<double>({ 2.0, 2.0, 2.0 });
+    jacobi.apply(v, v);
+
+    ASSERT_DOUBLE_EQ(0.5, v[0]);
+    ASSERT_DOUBLE_EQ(1.0, v[1]);
+    ASSERT_DOUBLE_EQ(4.0, v[2]);
+
+    auto singular = lalib::DynMat<double>(2, 2, { 1.0, 1.0, 1.0, 0.0 });
+    ASSERT_THROW({ auto p = lalib::solver::JacobiPreconditioner<double>(singular); }, std::runtime_error);
+}
+
+// A user-supplied preconditioner scaling by the inverse of a constant diagonal
+struct ScalingPreconditioner {
+    double d;
+
+    void apply(const lalib::DynVec<double>& in, lalib::DynVec<double>& out) const noexcept {
+        for (auto i = 0u; i < in.size(); ++i) {
+            out[i] = in[i] / this->d;
+        }
+    }
+};
+
+TEST(GmresTests, MatrixFreeGmresTest) {
+    // 1D Laplacian applied without a matrix
+    auto n = size_t(50);
+    auto op = lalib::solver::matrix_free<double>(n, [](const lalib::DynVec<double>& x, lalib::DynVec<double>& y) {
+        auto n = x.size();
+        for (auto i = 0u; i < n; ++i) {
+            y[i] = 2.0 * x[i] - (i > 0 ? x[i - 1] : 0.0) - (i + 1 < n ? x[i + 1] : 0.0);
+        }
+    });
+    auto b = lalib::DynVec<double>::filled(n, 0.0);
+    b[0] = 1.0;
+    b[n - 1] = 1.0;
+
+    for (auto side: { lalib::solver::PrecondSide::Left, lalib::solver::PrecondSide::Right }) {
+        auto gmres = lalib::solver::Gmres(op, ScalingPreconditioner{ 2.0 }, 1e-10, 0, 0, side);
+        auto sol = gmres.solve(b);
+        for (auto i = 0u; i < n; ++i) {
+            ASSERT_NEAR(1.0, sol[i], 1e-8);
+        }
+    }
+}
+
+TEST(GmresTests, GmresOrthogonalizationTest) {
+    using lalib::solver::Orthogonalization;
+    using lalib::solver::PrecondSide;
+    using Identity = lalib::solver::IdentityPreconditioner<double>;
+    auto mat = laplacian_2d(20);
+    auto n = mat.shape().first;
+    auto b = mat * lalib::DynVec<double>::filled(n, 1.0);
+
+    auto iterations = std::vector<size_t>();
+    for (auto orth: { Orthogonalization::Cgs, Orthogonalization::Cgs2 }) {
+        auto gmres = lalib::solver::Gmres(mat, Identity(), 1e-10, 0, 0, PrecondSide::Left, orth);
+        auto sol = lalib::DynVec<double>::filled(n, 0.0);
+        auto status = gmres.solve(b, sol);
+
+        ASSERT_TRUE(status.converged);
+        ASSERT_LT((b - mat * sol).norm2(), 1e-9);
+        for (auto i = 0u; i < n; ++i) {
+            ASSERT_NEAR(1.0, sol[i], 1e-8);
+        }
+        iterations.emplace_back(status.iterations);
+    }
+    ASSERT_NEAR(iterations[0], iterations[1], 2);
+}
@@ -0,0 +1,83 @@
+#include "lalib/solver/gmres.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <gtest/gtest.h>
+#include "test_problems.hpp"
+
+// Counts every heap allocation in this test program
+static std::atomic<size_t> alloc_count = 0;
+
+// GCC pairs the `free` below with the inlined callers of `operator new` and reports a mismatch,
+// although both replacements agree on `malloc` and `free`
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size) {
+    ++alloc_count;
+    if (auto p = std::malloc(size == 0 ? 1 : size)) { return p; }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { ::operator delete(p); }
+void operator delete(void* p, size_t) noexcept { ::operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { ::operator delete(p); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+TEST(GmresWorkspaceTests, SpGmresNoAllocationTest) {
+    auto mat = laplacian_2d(20);
+    auto n = mat.shape().first;
+    auto b = mat * lalib::DynVec<double>::filled(n, 1.0);
+
+    auto gmres = lalib::solver::Gmres(mat, 1e-10, 8, 1000);
+    auto ws = lalib::solver::GmresWorkspace<double>();
+    auto x = lalib::DynVec<double>::filled(n, 0.0);
+
+    // The first solve sizes the workspace
+    gmres.solve(b, x, ws);
+
+    std::fill(x.begin(), x.end(), 0.0);
+    auto count = alloc_count.load();
+    auto status = gmres.solve(b, x, ws);
+    auto nalloc = alloc_count.load() - count;
+
+    ASSERT_EQ(nalloc, 0);
+    ASSERT_TRUE(status.converged);
+    ASSERT_GT(status.iterations, 8);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(1.0, x[i], 1e-8);
+    }
+}
+
+TEST(GmresWorkspaceTests, DenseGmresNoAllocationTest) {
+    auto mat = lalib::DynMat<double>(3, 3, {
+        4.0, 2.0, 6.0,
+        2.0, 5.0, 5.0,
+        6.0, 5.0, 14.0
+    });
+    auto b = lalib::DynVec<double>({2.0, 5.0, 1.0});
+    auto gmres = lalib::solver::Gmres<double, lalib::DynMat<double>>(mat, 1e-10);
+    auto ws = lalib::solver::GmresWorkspace<double>(3, 3);
+    auto x = lalib::DynVec<double>::filled(3, 0.0);
+
+    auto count = alloc_count.load();
+    auto status = gmres.solve(b, x, ws);
+    auto nalloc = alloc_count.load() - count;
+
+    ASSERT_EQ(nalloc, 0);
+    ASSERT_TRUE(status.converged);
+    ASSERT_NEAR(1.25, x[0], 1e-8);
+    ASSERT_NEAR(1.5, x[1], 1e-8);
+    ASSERT_NEAR(-1.0, x[2], 1e-8);
+}
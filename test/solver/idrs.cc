@@ -0,0 +1,131 @@
+#include "lalib/solver/idrs.hpp"
+#include "lalib/ops/mat_vec_ops.hpp"
+#include <gtest/gtest.h>
+#include "test_problems.hpp"
+
+TEST(IdrsTests, IdrsTest) {
+    auto mat = lalib::DynMat<double>(3, 3, {
+        4.0, 1.0, 2.0,
+        0.5, 5.0, 1.0,
+        3.0, 1.0, 6.0
+    });
+    auto b = mat * lalib::DynVec<double>({ 1.0, -2.0, 3.0 });
+    auto idrs = lalib::solver::Idrs(mat, 1e-12, 2);
+    auto sol = idrs.solve(b);
+
+    ASSERT_NEAR(1.0, sol[0], 1e-10);
+    ASSERT_NEAR(-2.0, sol[1], 1e-10);
+    ASSERT_NEAR(3.0, sol[2], 1e-10);
+}
+
+TEST(IdrsTests, SpIdrsTest) {
+    auto mat = convection_diffusion_2d(40, 0.5);
+    auto n = mat.shape().first;
+    auto b = mat * lalib::DynVec<double>::filled(n, 1.0);
+
+    auto idrs = lalib::solver::Idrs(mat, 1e-10);
+    auto sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto status = idrs.solve(b, sol);
+
+    ASSERT_TRUE(status.converged);
+    ASSERT_LT(status.residual, 1e-10);
+    // The reported residual is the true one, not the recurrence
+    EXPECT_NEAR((b - mat * sol).norm2(), status.residual, 1e-6 * status.residual);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(1.0, sol[i], 1e-8);
+    }
+}
+
+TEST(IdrsTests, IdrsShadowSpaceSweepTest) {
+    auto mat = convection_diffusion_2d(40, 0.5);
+    auto n = mat.shape().first;
+    auto b = mat * lalib::DynVec<double>::filled(n, 1.0);
+
+    using Identity = lalib::solver::IdentityPreconditioner<double>;
+    for (auto s: { 1u, 2u, 3u, 4u, 8u, 16u }) {
+        auto idrs = lalib::solver::Idrs(mat, Identity(), 1e-10, s);
+        auto sol = lalib::DynVec<double>::filled(n, 0.0);
+        auto status = idrs.solve(b, sol);
+
+        ASSERT_TRUE(status.converged) << "s = " << s;
+        ASSERT_LT(status.residual, 1e-10) << "s = " << s;
+        EXPECT_NEAR((b - mat * sol).norm2(), status.residual, 1e-6 * status.residual) << "s = " << s;
+        for (auto i = 0u; i < n; ++i) {
+            ASSERT_NEAR(1.0, sol[i], 1e-8) << "s = " << s;
+        }
+    }
+}
+
+TEST(IdrsTests, IdrsShadowSpaceClampTest) {
+    auto mat = lalib::DynMat<double>(3, 3, {
+        4.0, 1.0, 2.0,
+        0.5, 5.0, 1.0,
+        3.0, 1.0, 6.0
+    });
+    auto b = mat * lalib::DynVec<double>({ 1.0, -2.0, 3.0 });
+
+    // A shadow space larger than the system is clamped to its size, and the solve is the same as with `s = n`
+    using Identity = lalib::solver::IdentityPreconditioner<double>;
+    auto clamped = lalib::solver::Idrs(mat, Identity(), 1e-12, 10);
+    auto exact = lalib::solver::Idrs(mat, Identity(), 1e-12, 3);
+    auto sol = lalib::DynVec<double>::filled(3, 0.0);
+    auto sol_exact = lalib::DynVec<double>::filled(3, 0.0);
+    auto status = clamped.solve(b, sol);
+    auto status_exact = exact.solve(b, sol_exact);
+
+    ASSERT_TRUE(status.converged);
+    ASSERT_EQ(status_exact.iterations, status.iterations);
+    ASSERT_EQ(status_exact.residual, status.residual);
+    for (auto i = 0u; i < 3; ++i) {
+        ASSERT_EQ(sol_exact[i], sol[i]);
+    }
+    ASSERT_NEAR(1.0, sol[0], 1e-10);
+    ASSERT_NEAR(-2.0, sol[1], 1e-10);
+    ASSERT_NEAR(3.0, sol[2], 1e-10);
+}
+
+TEST(IdrsTests, IdrsZeroShadowSpaceTest) {
+    auto mat = convection_diffusion_2d(4, 0.5);
+    using Identity = lalib::solver::IdentityPreconditioner<double>;
+    ASSERT_THROW({ auto solver = lalib::solver::Idrs(mat, 1e-10, 0); }, std::invalid_argument);
+    ASSERT_THROW({ auto solver = lalib::solver::Idrs(mat, Identity(), 1e-10, 0); }, std::invalid_argument);
+}
+
+TEST(IdrsTests, MatrixFreeIdrsTest) {
+    auto n = size_t(100);
+    auto op = matrix_free_convection_diffusion(n);
+    auto x = lalib::DynVec<double>::filled(n, 1.0);
+    auto b = lalib::DynVec<double>::uninit(n);
+    op.apply(x, b);
+
+    auto idrs = lalib::solver::Idrs(op, lalib::solver::IdentityPreconditioner<double>(), 1e-10, 4);
+    auto ws = lalib::solver::IdrsWorkspace<double>();
+    auto sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto status = idrs.solve(b, sol, ws);
+
+    ASSERT_TRUE(status.converged);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(1.0, sol[i], 1e-8);
+    }
+
+    // A second solve with the same workspace and an exact initial guess does not iterate.
+    auto status2 = idrs.solve(b, sol, ws);
+    ASSERT_TRUE(status2.converged);
+    ASSERT_EQ(status2.iterations, 0);
+}
+
+TEST(IdrsTests, IdrsMaxIterTest) {
+    auto mat = convection_diffusion_2d(40, 0.5);
+    auto n = mat.shape().first;
+    auto b = mat * lalib::DynVec<double>::filled(n, 1.0);
+
+    using Identity = lalib::solver::IdentityPreconditioner<double>;
+    auto idrs = lalib::solver::Idrs(mat, Identity(), 1e-14, 4, 7);
+    auto sol = lalib::DynVec<double>::filled(n, 0.0);
+    auto status = idrs.solve(b, sol);
+
+    ASSERT_FALSE(status.converged);
+    ASSERT_EQ(status.iterations, 7);
+    ASSERT_GT(status.residual, 1e-14);
+    EXPECT_NEAR((b - mat * sol).norm2(), status.residual, 1e-6 * status.residual);
+}
@@ -40,4 +40,117 @@ TEST(ILUTests, SparseDecompositionTest) {
 
     ASSERT_NEAR(ilu.mat()(1, 2), 0.0, 1e-6);
     ASSERT_NEAR(ilu.mat()(2, 1), 0.0, 1e-6);
+}
+
+TEST(ILUTests, CsrDecompositionTest) {
+    // The CSR factorization must coincide with the generic one on the same pattern
+    auto dense = lalib::DynMat<double>(5, 5, {
+        4, -1,  0, -1,  0,
+       -1,  4, -1,  0,  0,
+        0, -1,  4,  0, -1,
+       -1,  0,  0,  4, -1,
+        0,  0, -1, -1,  4,
+    });
+    auto mat = lalib::SpMat<double>(
+        { 4, -1, -1, -1, 4, -1, -1, 4, -1, -1, 4, -1, -1, -1, 4 },
+        { 0, 3, 6, 9, 12, 15 },
+        { 0, 1, 3, 0, 1, 2, 1, 2, 4, 0, 3, 4, 2, 3, 4 }
+    );
+
+    lalib::solver::Ilu<double, lalib::DynMat<double>> dense_ilu(std::move(dense));
+    lalib::solver::Ilu<double, lalib::SpMat<double>> ilu(std::move(mat));
+
+    for (auto i = 0u; i < 5; ++i) {
+        for (auto j = 0u; j < 5; ++j) {
+            ASSERT_NEAR(ilu.mat()(i, j), dense_ilu.mat()(i, j), 1e-12);
+        }
+    }
+
+    auto rhs = lalib::DynVec<double>({ 1.0, 2.0, 3.0, 4.0, 5.0 });
+    auto x1 = ilu.solve(rhs);
+    auto x2 = dense_ilu.solve(rhs);
+    for (auto i = 0u; i < 5; ++i) {
+        ASSERT_NEAR(x1[i], x2[i], 1e-12);
+    }
+}
+
+TEST(ILUTests, CsrLargeTriDiagDecompositionTest) {
+    // Tri-diagonal matrix has no fill-in, so that ILU(0) is the exact LU factorization.
+    auto n = 100000u;
+    auto val = std::vector<double>();
+    auto row_ptr = std::vector<size_t>{ 0 };
+    auto col_ids = std::vector<size_t>();
+    for (auto i = 0u; i < n; ++i) {
+        for (auto j = (i == 0 ? 0 : i - 1); j < std::min(n, i + 2); ++j) {
+            val.emplace_back(i == j ? 4.0 : -1.0);
+            col_ids.emplace_back(j);
+        }
+        row_ptr.emplace_back(col_ids.size());
+    }
+    auto mat = lalib::SpMat<double>(std::move(val), std::move(row_ptr), std::move(col_ids));
+    auto x = lalib::DynVec<double>::filled(n, 1.0);
+    auto rhs = mat * x;
+
+    lalib::solver::Ilu<double, lalib::SpMat<double>> ilu(std::move(mat));
+    auto sol = ilu.solve(rhs);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(sol[i], 1.0, 1e-12);
+    }
+}
+
+TEST(ILUTests, CsrSingularTest) {
+    // The diagonal element of the second row is missing
+    auto mat = lalib::SpMat<double>({ 1.0, 1.0, 1.0 }, { 0, 2, 3 }, { 0, 1, 0 });
+    using IluD = lalib::solver::Ilu<double, lalib::SpMat<double>>;
+    EXPECT_THROW({ auto ilu = IluD(std::move(mat)); }, std::runtime_error);
+}
+
+TEST(ILUTests, CsrLevelScheduleTest) {
+    // 2D 5-point Laplacian on a `m` x `m` grid, whose levels are the anti-diagonals of the grid.
+    auto m = 200u;
+    auto n = m * m;
+    auto val = std::vector<double>();
+    auto row_ptr = std::vector<size_t>{ 0 };
+    auto col_ids = std::vector<size_t>();
+    for (auto i = 0u; i < n; ++i) {
+        auto [r, c] = std::make_pair(i / m, i % m);
+        if (r > 0) { val.emplace_back(-1.0); col_ids.emplace_back(i - m); }
+        if (c > 0) { val.emplace_back(-1.0); col_ids.emplace_back(i - 1); }
+        val.emplace_back(4.0); col_ids.emplace_back(i);
+        if (c + 1 < m) { val.emplace_back(-1.0); col_ids.emplace_back(i + 1); }
+        if (r + 1 < m) { val.emplace_back(-1.0); col_ids.emplace_back(i + m); }
+        row_ptr.emplace_back(col_ids.size());
+    }
+    auto mat = lalib::SpMat<double>(std::move(val), std::move(row_ptr), std::move(col_ids));
+
+    lalib::solver::Ilu<double, lalib::SpMat<double>> ilu{ lalib::SpMat<double>(mat) };
+    lalib::solver::Ilu<double, lalib::SpMat<double>> reordered{ lalib::SpMat<double>(mat), true };
+    ASSERT_EQ(ilu.nlevels().first, 2 * m - 1);
+    ASSERT_EQ(ilu.nlevels().second, 2 * m - 1);
+    ASSERT_EQ(reordered.nlevels(), ilu.nlevels());
+
+    // Reference: plain row-by-row substitutions
+    auto rhs = mat * lalib::DynVec<double>::filled(n, 1.0);
+    auto y = rhs;
+    const auto& fac = ilu.mat();
+    for (auto i = 0u; i < n; ++i) {
+        for (auto k = fac.row_ptr()[i]; k < fac.row_ptr()[i + 1] && fac.col_indices()[k] < i; ++k) {
+            y[i] -= fac.values()[k] * y[fac.col_indices()[k]];
+        }
+    }
+    for (auto i = n; i-- > 0;) {
+        auto d = 0.0;
+        for (auto k = fac.row_ptr()[i]; k < fac.row_ptr()[i + 1]; ++k) {
+            if (fac.col_indices()[k] > i) { y[i] -= fac.values()[k] * y[fac.col_indices()[k]]; }
+            else if (fac.col_indices()[k] == i) { d = fac.values()[k]; }
+        }
+        y[i] /= d;
+    }
+
+    auto x1 = ilu.solve(rhs);
+    auto x2 = reordered.solve(rhs);
+    for (auto i = 0u; i < n; ++i) {
+        ASSERT_NEAR(x1[i], y[i], 1e-12);
+        ASSERT_NEAR(x2[i], y[i], 1e-12);
+    }
 }
\ No newline at end of file
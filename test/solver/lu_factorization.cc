@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "lalib/solver/lu_factorization.hpp"
+#include "lalib/ops/dispatch.hpp"
+#include "lalib/mat.hpp"
+#include "lalib/vec.hpp"
+
+TEST(LuDecompositionTests, DecompositionTest) {
+    auto mat = lalib::DynMat<double>(3, 3, {
+		1.0, 2.0, 3.0,
+		4.0, 5.0, 6.0,
+		7.0, 8.0, 10.0
+	});
+	auto lu = lalib::solver::DynLuFactorization<double>(std::move(mat));
+	const auto& f = lu.factor_mat();
+	const auto& ipiv = lu.pivots();
+
+	// The rows are pivoted to (7, 8, 10), (1, 2, 3), (4, 5, 6)
+	EXPECT_EQ(3, ipiv[0]);
+	EXPECT_EQ(3, ipiv[1]);
+	EXPECT_EQ(3, ipiv[2]);
+	EXPECT_DOUBLE_EQ(7.0, f(0, 0));
+	EXPECT_DOUBLE_EQ(8.0, f(0, 1));
+	EXPECT_DOUBLE_EQ(10.0, f(0, 2));
+	EXPECT_DOUBLE_EQ(1.0 / 7.0, f(1, 0));
+	EXPECT_NEAR(6.0 / 7.0, f(1, 1), 1e-14);
+	EXPECT_NEAR(11.0 / 7.0, f(1, 2), 1e-14);
+	EXPECT_DOUBLE_EQ(4.0 / 7.0, f(2, 0));
+	EXPECT_NEAR(0.5, f(2, 1), 1e-14);
+	EXPECT_NEAR(-0.5, f(2, 2), 1e-14);
+}
+
+TEST(LuDecompositionTests, LinearSolverTest) {
+    auto mat = lalib::DynMat<double>(3, 3, {
+		1.0, 2.0, 3.0,
+		4.0, 5.0, 6.0,
+		7.0, 8.0, 10.0
+	});
+	auto lu = lalib::solver::DynLuFactorization<double>(std::move(mat));
+
+	{
+		auto rslt = lalib::DynVecD({ 6.0, 15.0, 25.0 });
+		lu.solve_linear_mut(rslt);
+
+		EXPECT_NEAR(1.0, rslt[0], 1e-14);
+		EXPECT_NEAR(1.0, rslt[1], 1e-14);
+		EXPECT_NEAR(1.0, rslt[2], 1e-14);
+	}
+	{
+		const auto b = lalib::DynMatD(3, 2, {
+			6.0, 1.0,
+			15.0, 4.0,
+			25.0, 7.0
+		});
+		auto rslt = lu.solve_linear(b);
+
+		EXPECT_NEAR(1.0, rslt(0, 0), 1e-14);
+		EXPECT_NEAR(1.0, rslt(1, 0), 1e-14);
+		EXPECT_NEAR(1.0, rslt(2, 0), 1e-14);
+		EXPECT_NEAR(1.0, rslt(0, 1), 1e-14);
+		EXPECT_NEAR(0.0, rslt(1, 1), 1e-14);
+		EXPECT_NEAR(0.0, rslt(2, 1), 1e-14);
+	}
+}
+
+static auto lu_test_mat(size_t n) -> lalib::DynMat<double> {
+	auto mat = lalib::DynMat<double>::uninit(n, n);
+	for (auto i = 0u; i < n; ++i) {
+		for (auto j = 0u; j < n; ++j) {
+			mat(i, j) = std::sin(static_cast<double>(i * 13 + j * 7 + 1)) + (j + 1 == i ? 2.0 : 0.0);
+		}
+	}
+	return mat;
+}
+
+static void expect_blocked_lu(size_t n, size_t nrhs) {
+	const auto a = lu_test_mat(n);
+	auto x = lalib::DynMat<double>::uninit(n, nrhs);
+	for (auto i = 0u; i < n; ++i) {
+		for (auto k = 0u; k < nrhs; ++k) { x(i, k) = static_cast<double>((i * 3 + k * 5) % 11) - 5.0; }
+	}
+	auto b = lalib::DynMat<double>::uninit(n, nrhs);
+	auto bv = lalib::DynVecD(std::vector<double>(n));
+	for (auto i = 0u; i < n; ++i) {
+		for (auto k = 0u; k < nrhs; ++k) {
+			auto sum = 0.0;
+			for (auto j = 0u; j < n; ++j) { sum += a(i, j) * x(j, k); }
+			b(i, k) = sum;
+		}
+		bv[i] = b(i, 0);
+	}
+
+	auto lu = lalib::solver::DynLuFactorization<double>(lalib::DynMat<double>(a));
+	for (auto i = 0u; i < n; ++i) {
+		ASSERT_LT(std::abs(lu.pivots()[i]) - 1, static_cast<int32_t>(n));
+		ASSERT_GE(lu.pivots()[i] - 1, static_cast<int32_t>(i));
+	}
+
+	auto rslt = lu.solve_linear(b);
+	auto rslt_v = lu.solve_linear(bv);
+	for (auto i = 0u; i < n; ++i) {
+		for (auto k = 0u; k < nrhs; ++k) { EXPECT_NEAR(x(i, k), rslt(i, k), 1e-8) << i << ", " << k; }
+		EXPECT_NEAR(x(i, 0), rslt_v[i], 1e-8) << i;
+	}
+}
+
+TEST(LuDecompositionTests, BlockedLinearSolverTest) {
+	lalib::set_parallel_threshold(lalib::Kernel::MatMul, lalib::NeverParallel);
+	expect_blocked_lu(37, 3);
+	expect_blocked_lu(300, 70);
+	lalib::reset_parallel_thresholds();
+}
+
+TEST(LuDecompositionTests, ParallelBlockedLinearSolverTest) {
+	lalib::set_parallel_threshold(lalib::Kernel::MatMul, 1);
+	expect_blocked_lu(257, 16);
+	lalib::reset_parallel_thresholds();
+}
+
+TEST(LuDecompositionTests, SingularMatrixTest) {
+    auto mat = lalib::DynMat<double>(3, 3, {
+		1.0, 2.0, 3.0,
+		2.0, 4.0, 6.0,
+		1.0, 0.0, 1.0
+	});
+	EXPECT_THROW(lalib::solver::DynLuFactorization<double>(std::move(mat)), std::runtime_error);
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+// Built with `LALIB_REPRODUCIBLE_REDUCTIONS`, so that every reduction in the solvers is reproducible
+#include "lalib/solver/cg.hpp"
+#include "lalib/solver/gmres.hpp"
+#include "lalib/solver/bicgstab.hpp"
+#include "lalib/solver/preconditioner.hpp"
+#include "lalib/ops/mat_vec_ops.hpp"
+#include <omp.h>
+#include <gtest/gtest.h>
+#include "test_problems.hpp"
+
+/// Solves with 1 thread and with several threads, and checks that the solves are bitwise identical.
+template<typename S>
+void expect_reproducible(const S& solver, const lalib::DynVec<double>& b) {
+    auto n = b.size();
+    auto max_threads = omp_get_max_threads();
+
+    omp_set_num_threads(1);
+    auto x1 = lalib::DynVec<double>::filled(n, 0.0);
+    auto status1 = solver.solve(b, x1);
+    ASSERT_TRUE(status1.converged);
+
+    for (auto threads: { 2, 4 }) {
+        omp_set_num_threads(threads);
+        auto x = lalib::DynVec<double>::filled(n, 0.0);
+        auto status = solver.solve(b, x);
+
+        ASSERT_EQ(status1.iterations, status.iterations);
+        ASSERT_EQ(status1.residual, status.residual);
+        for (auto i = 0u; i < n; ++i) {
+            ASSERT_EQ(x1[i], x[i]);
+        }
+    }
+    omp_set_num_threads(max_threads);
+}
+
+TEST(ReproducibleTests, ReductionsTest) {
+    auto n = 100003u;
+    auto x = lalib::DynVec<double>::uninit(n);
+    for (auto i = 0u; i < n; ++i) { x[i] = std::sin(0.1 * i) * std::pow(10.0, i % 11); }
+
+    omp_set_num_threads(1);
+    auto d = x.dot(x);
+    auto norm = x.norm2();
+    omp_set_num_threads(4);
+    ASSERT_EQ(d, x.dot(x));
+    ASSERT_EQ(norm, x.norm2());
+    ASSERT_EQ(d, lalib::dot(x, x, lalib::Summation::Reproducible));
+}
+
+TEST(ReproducibleTests, SolversTest) {
+    // Large enough for the reductions to run in parallel
+    auto mat = laplacian_2d(200);
+    auto n = mat.shape().first;
+    auto b = lalib::DynVec<double>::uninit(n);
+    for (auto i = 0u; i < n; ++i) { b[i] = std::sin(0.01 * i); }
+
+    using Jacobi = lalib::solver::JacobiPreconditioner<double>;
+    expect_reproducible(lalib::solver::Cg(mat, 1e-8), b);
+    expect_reproducible(lalib::solver::Gmres<double, lalib::SpMat<double>, Jacobi>(mat, 1e-8, 30), b);
+    expect_reproducible(lalib::solver::Bicgstab<double, lalib::SpMat<double>, Jacobi>(mat, 1e-8), b);
+}
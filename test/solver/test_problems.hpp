@@ -0,0 +1,57 @@
+#pragma once
+#ifndef LALIB_TEST_SOLVER_TEST_PROBLEMS_HPP
+#define LALIB_TEST_SOLVER_TEST_PROBLEMS_HPP
+
+#include <utility>
+#include <vector>
+#include "lalib/mat/sp_mat.hpp"
+#include "lalib/vec/dyn_vec.hpp"
+#include "lalib/solver/linear_operator.hpp"
+
+/// 5-point discretization of the 2D Laplacian on an `m` x `m` grid (symmetric positive definite)
+inline auto laplacian_2d(size_t m) -> lalib::SpMat<double> {
+    auto n = m * m;
+    auto val = std::vector<double>();
+    auto row_ptr = std::vector<size_t>{ 0 };
+    auto col_ids = std::vector<size_t>();
+    for (auto i = 0u; i < n; ++i) {
+        auto [r, c] = std::make_pair(i / m, i % m);
+        if (r > 0) { val.emplace_back(-1.0); col_ids.emplace_back(i - m); }
+        if (c > 0) { val.emplace_back(-1.0); col_ids.emplace_back(i - 1); }
+        val.emplace_back(4.0); col_ids.emplace_back(i);
+        if (c + 1 < m) { val.emplace_back(-1.0); col_ids.emplace_back(i + 1); }
+        if (r + 1 < m) { val.emplace_back(-1.0); col_ids.emplace_back(i + m); }
+        row_ptr.emplace_back(col_ids.size());
+    }
+    return lalib::SpMat<double>(std::move(val), std::move(row_ptr), std::move(col_ids));
+}
+
+/// Upwind discretization of a 2D convection-diffusion operator on an `m` x `m` grid (non-symmetric)
+inline auto convection_diffusion_2d(size_t m, double c) -> lalib::SpMat<double> {
+    auto n = m * m;
+    auto val = std::vector<double>();
+    auto row_ptr = std::vector<size_t>{ 0 };
+    auto col_ids = std::vector<size_t>();
+    for (auto i = 0u; i < n; ++i) {
+        auto [r, col] = std::make_pair(i / m, i % m);
+        if (r > 0) { val.emplace_back(-1.0); col_ids.emplace_back(i - m); }
+        if (col > 0) { val.emplace_back(-1.0 - c); col_ids.emplace_back(i - 1); }
+        val.emplace_back(4.0 + c); col_ids.emplace_back(i);
+        if (col + 1 < m) { val.emplace_back(-1.0); col_ids.emplace_back(i + 1); }
+        if (r + 1 < m) { val.emplace_back(-1.0); col_ids.emplace_back(i + m); }
+        row_ptr.emplace_back(col_ids.size());
+    }
+    return lalib::SpMat<double>(std::move(val), std::move(row_ptr), std::move(col_ids));
+}
+
+/// 1D convection-diffusion operator applied without a matrix
+inline auto matrix_free_convection_diffusion(size_t n) {
+    return lalib::solver::matrix_free<double>(n, [](const lalib::DynVec<double>& x, lalib::DynVec<double>& y) {
+        auto n = x.size();
+        for (auto i = 0u; i < n; ++i) {
+            y[i] = 4.0 * x[i] - 2.0 * (i > 0 ? x[i - 1] : 0.0) - (i + 1 < n ? x[i + 1] : 0.0);
+        }
+    });
+}
+
+#endif
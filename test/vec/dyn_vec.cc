@@ -1,4 +1,7 @@
 #include "lalib/vec/dyn_vec.hpp"
+#include "lalib/ops/vec_ops.hpp"
+#include <complex>
+#include <limits>
 #include <iterator>
 #include <ranges>
 #include <algorithm>
@@ -89,4 +92,105 @@ TEST(DynVecTests, Norm2Test) {
     auto v = lalib::DynVec<double> ({ 1.0, 2.0, 3.0, 4.0 });
 
     ASSERT_DOUBLE_EQ(std::sqrt(30.0), v.norm2());
+}
+
+TEST(DynVecTests, DotLargeTest) {
+    // Large enough to take the parallel path
+    auto n = 100003u;
+    auto v1 = lalib::DynVec<double>::filled(n, 0.5);
+    auto v2 = lalib::DynVec<double>::filled(n, 0.0);
+    for (auto i = 0u; i < n; ++i) { v2[i] = static_cast<double>(i % 7); }
+
+    auto expected = 0.0;
+    for (auto i = 0u; i < n; ++i) { expected += 0.5 * v2[i]; }
+
+    ASSERT_DOUBLE_EQ(expected, v1.dot(v2));
+    ASSERT_DOUBLE_EQ(std::sqrt(0.25 * n), v1.norm2());
+}
+
+TEST(DynVecTests, DotEmptyTest) {
+    auto v = lalib::DynVec<double>::filled(0, 1.0);
+    ASSERT_DOUBLE_EQ(0.0, v.dot(v));
+    ASSERT_DOUBLE_EQ(0.0, v.norm2());
+}
+
+TEST(DynVecTests, DotGenericTest) {
+    auto v1 = lalib::DynVec<int>({ 1, 2, 3 });
+    auto v2 = lalib::DynVec<int>({ 4, -5, 6 });
+    ASSERT_EQ(12, v1.dot(v2));
+}
+
+TEST(DynVecTests, DotComplexTest) {
+    using C = std::complex<double>;
+    for (auto n: { 5u, 100003u }) {
+        auto v1 = lalib::DynVec<C>::filled(n, C(1.0, 2.0));
+        auto v2 = lalib::DynVec<C>::filled(n, C(3.0, -1.0));
+
+        // Unconjugated: (1 + 2i)(3 - i) = 5 + 5i
+        auto d = v1.dot(v2);
+        ASSERT_NEAR(5.0 * n, d.real(), 1e-9 * n);
+        ASSERT_NEAR(5.0 * n, d.imag(), 1e-9 * n);
+
+        auto norm = v1.norm2();
+        ASSERT_NEAR(std::sqrt(5.0 * n), norm.real(), 1e-9 * n);
+        ASSERT_DOUBLE_EQ(0.0, norm.imag());
+    }
+}
+
+TEST(DynVecTests, Norm2ScaledTest) {
+    // The squares of the elements overflow or underflow
+    for (auto scale: { 1e200, 1e-200, 1e300, 1e-300 }) {
+        for (auto n: { 4u, 100003u }) {
+            auto v = lalib::DynVec<double>::filled(n, 3.0 * scale);
+            auto expected = 3.0 * scale * std::sqrt(static_cast<double>(n));
+            // The rounding errors of the sum grow with the number of the elements
+            ASSERT_NEAR(expected, v.norm2(), 1e-11 * expected);
+            for (auto summation: { lalib::Summation::Reproducible, lalib::Summation::Compensated, lalib::Summation::Pairwise }) {
+                ASSERT_NEAR(expected, lalib::norm2(v, summation), 1e-11 * expected);
+            }
+        }
+    }
+
+    // Mixed magnitudes: the tiny elements are negligible against the huge ones
+    auto v = lalib::DynVec<double>({ 3e300, 1e-300, 4e300, 0.0 });
+    ASSERT_DOUBLE_EQ(5e300, v.norm2());
+
+    auto w = lalib::DynVec<double>({ 3e-300, 1.0, 4e-300 });
+    ASSERT_DOUBLE_EQ(1.0, w.norm2());
+
+    auto f = lalib::DynVec<float>({ 3e30f, 4e30f });
+    ASSERT_FLOAT_EQ(5e30f, f.norm2());
+
+    using C = std::complex<double>;
+    auto c = lalib::DynVec<C>({ C(3e200, 4e200), C(0.0, 0.0) });
+    ASSERT_DOUBLE_EQ(5e200, c.norm2().real());
+}
+
+TEST(DynVecTests, Norm2ZeroTest) {
+    // A zero vector and a tiny one, whose squares underflow to zero, are told apart by the largest element
+    for (auto n: { 0u, 7u, 100003u }) {
+        auto zero = lalib::DynVec<double>::filled(n, 0.0);
+        auto tiny = lalib::DynVec<double>::filled(n, 1e-200);
+        auto expected = 1e-200 * std::sqrt(static_cast<double>(n));
+        ASSERT_EQ(0.0, zero.norm2());
+        ASSERT_NEAR(expected, tiny.norm2(), 1e-11 * expected);
+        for (auto summation: { lalib::Summation::Reproducible, lalib::Summation::Compensated, lalib::Summation::Pairwise }) {
+            ASSERT_EQ(0.0, lalib::norm2(zero, summation));
+            ASSERT_NEAR(expected, lalib::norm2(tiny, summation), 1e-11 * expected);
+        }
+    }
+
+    auto f = lalib::DynVec<float>::filled(1000, 1e-30f);
+    ASSERT_NEAR(1e-30f * std::sqrt(1000.0f), f.norm2(), 1e-5f * 1e-30f * std::sqrt(1000.0f));
+    ASSERT_EQ(0.0f, lalib::DynVec<float>::filled(1000, 0.0f).norm2());
+}
+
+TEST(DynVecTests, Norm2NonFiniteTest) {
+    auto inf = std::numeric_limits<double>::infinity();
+    auto nan = std::numeric_limits<double>::quiet_NaN();
+
+    ASSERT_EQ(inf, lalib::DynVec<double>({ 1.0, inf, 2.0 }).norm2());
+    ASSERT_TRUE(std::isnan(lalib::DynVec<double>({ 1.0, nan, 2.0 }).norm2()));
+    ASSERT_TRUE(std::isnan(lalib::DynVec<double>({ 1e300, nan, 2.0 }).norm2()));
+    ASSERT_DOUBLE_EQ(0.0, lalib::DynVec<double>::filled(10, 0.0).norm2());
 }
\ No newline at end of file